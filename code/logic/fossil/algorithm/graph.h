@@ -40,13 +40,32 @@ extern "C" {
 /**
  * @brief Opaque graph handle.
  *
- * The concrete representation (adjacency list, matrix, CSR, etc.)
- * is implementation-defined and hidden from the algorithm layer.
+ * Graphs are stored as compressed sparse row (CSR) adjacency: one
+ * offsets array plus contiguous target and weight arrays. The concrete
+ * layout is hidden from callers; use the lifecycle API to create one.
  */
 typedef struct fossil_graph fossil_graph_t;
 
 /**
- * @brief Graph edge descriptor (optional utility).
+ * @brief Opaque contraction hierarchy handle.
+ *
+ * Preprocessed form of a weighted graph for fast point-to-point
+ * queries; see the Contraction Hierarchies API.
+ */
+typedef struct fossil_graph_ch fossil_graph_ch_t;
+
+/**
+ * @brief Sentinel node id: "no node" / "no target".
+ *
+ * Used for pred[] entries of the start node and unreached nodes, and as
+ * a target to request a full single-source computation.
+ */
+#define FOSSIL_GRAPH_NO_NODE UINT64_MAX
+
+/**
+ * @brief Graph edge descriptor used for bulk construction.
+ *
+ * The weight is ignored when the graph is unweighted.
  */
 typedef struct fossil_graph_edge {
     uint64_t from;
@@ -63,6 +82,23 @@ typedef struct fossil_graph_edge {
  */
 typedef bool (*fossil_graph_visit_fn)(uint64_t node_id, void *user);
 
+/**
+ * @brief Heuristic callback for goal-directed search.
+ *
+ * Returns a lower bound on the remaining cost from node to target.
+ */
+typedef double (*fossil_graph_heuristic_fn)(uint64_t node, uint64_t target, void *user);
+
+/**
+ * @brief Progress callback for iterative algorithms.
+ *
+ * @param step Iteration just completed (1-based).
+ * @param value Current metric (e.g., residual).
+ * @param user User context pointer.
+ * @return true to continue, false to stop early.
+ */
+typedef bool (*fossil_graph_metric_fn)(size_t step, double value, void *user);
+
 // ======================================================
 // Fossil Algorithm Graph — Exec Interface
 // ======================================================
@@ -72,15 +108,49 @@ typedef bool (*fossil_graph_visit_fn)(uint64_t node_id, void *user);
  *
  * Supported algorithm identifiers (implementation-defined, typical set):
  *   - Traversal: "bfs", "dfs"
- *   - Shortest path: "dijkstra", "bellman-ford", "floyd-warshall"
- *   - Connectivity: "connected", "components"
- *   - Spanning tree: "mst-prim", "mst-kruskal"
- *   - Ordering: "toposort"
+ *   - Shortest path: "dijkstra", "dijkstra-radix", "bellman-ford",
+ *                    "bellman-ford-parallel", "spfa", "delta-stepping",
+ *                    "floyd-warshall",
+ *                    "astar" (no heuristic through exec),
+ *                    "bidirectional-dijkstra", "bidirectional-bfs"
+ *   - Connectivity: "cc", "scc", "scc-parallel"
+ *   - Spanning tree: "mst-kruskal", "mst-prim", "mst-boruvka"
+ *   - Ordering: "toposort", "toposort-parallel"
+ *   - Ranking: "pagerank", "ppr", "betweenness"
+ *   - Cohesion: "triangles", "kcore", "kcore-parallel"
+ *   - Flow: "dinic", "push-relabel"
+ *   - Matching: "hopcroft-karp"
  *
  * Supported graph properties:
  *   - Directed / undirected
  *   - Weighted / unweighted
  *
+ * Visitor semantics:
+ *   - Traversals report nodes in visit order.
+ *   - Shortest-path algorithms report the nodes of the shortest path
+ *     from start_node to target_node, in order. "floyd-warshall"
+ *     computes all pairs first and needs O(node_count^2) memory.
+ *   - Component algorithms report every node in start_node's component,
+ *     in node order; target_node is ignored.
+ *   - Spanning-tree algorithms report start_node's tree in breadth-first
+ *     order over the tree edges; target_node is ignored.
+ *   - Ordering algorithms report the topological order; start_node and
+ *     target_node are ignored, and a cyclic graph returns -1 without
+ *     visiting.
+ *   - Ranking algorithms report every node by descending rank (damping
+ *     0.85); "ppr" personalizes on start_node, "pagerank" ignores it.
+ *     "betweenness" ranks by exact betweenness centrality.
+ *   - "triangles" reports the nodes on at least one triangle, most
+ *     triangles first (ties by id); start_node and target_node are
+ *     ignored.
+ *   - "kcore" and "kcore-parallel" report every node in degeneracy
+ *     order; start_node and target_node are ignored.
+ *   - Flow algorithms report the source side of the minimum
+ *     start_node / target_node cut, in node order.
+ *   - "hopcroft-karp" reports each matched pair as two visits, lower id
+ *     first, ordered by the lower id; start_node and target_node are
+ *     ignored, and a non-bipartite graph returns -4 without visiting.
+ *
  * Notes:
  * - Not all algorithms require all parameters.
  * - Algorithms that require weights assume non-null edge weights.
@@ -92,6 +162,7 @@ typedef bool (*fossil_graph_visit_fn)(uint64_t node_id, void *user);
  *   -2   : invalid input (null pointers, invalid node ids)
  *   -3   : unknown or unsupported algorithm
  *   -4   : unsupported graph properties for algorithm
+ *   -5   : negative cycle reachable from start_node
  *
  * Example:
  * @code
@@ -123,80 +194,1827 @@ int fossil_algorithm_graph_exec(
 );
 
 // ======================================================
-// Extended Utility API
+// Lifecycle Utilities
 // ======================================================
 
 /**
- * @brief Checks whether a graph algorithm is supported.
+ * @brief Creates an empty graph with a fixed number of nodes.
+ *
+ * Node ids are dense in the range [0, node_count). The graph has no
+ * edges until @ref fossil_algorithm_graph_build is called.
+ *
+ * @param node_count Number of nodes.
+ * @param directed true for a directed graph.
+ * @param weighted true if edge weights are stored.
+ * @return fossil_graph_t* New graph, or NULL on allocation failure.
+ */
+fossil_graph_t *fossil_algorithm_graph_create(
+    size_t node_count,
+    bool directed,
+    bool weighted
+);
+
+/**
+ * @brief Destroys a graph and releases its adjacency storage.
+ */
+void fossil_algorithm_graph_destroy(
+    fossil_graph_t *graph
+);
+
+/**
+ * @brief Builds the graph adjacency from an edge array.
+ *
+ * A counting-sort pass groups the edges by source node into CSR
+ * storage in O(V + E). Edges of the same source keep their input
+ * order. Undirected graphs store each edge in both directions.
+ * Any previously built adjacency is replaced.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure (graph left unchanged)
+ *   -2 : invalid input (null pointers, edge endpoint out of range)
+ *
+ * @param graph Graph handle.
+ * @param edges Edge array.
+ * @param edge_count Number of edges.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_build(
+    fossil_graph_t *graph,
+    const fossil_graph_edge_t *edges,
+    size_t edge_count
+);
+
+/**
+ * @brief Inserts and deletes a batch of edges without a rebuild.
+ *
+ * The first update gives every adjacency list slack capacity; later
+ * batches fill it in place and re-lay the lists out only when some
+ * node runs out of room, so the cost is O(batch log batch) plus an
+ * amortized O(1) per inserted edge. Updates are grouped by source node
+ * and applied in parallel. The graph stays usable by every algorithm
+ * between batches; a directed graph's in-adjacency, once built, is
+ * updated along with it.
+ *
+ * Deletes run before inserts. Each delete removes one edge with the
+ * same endpoints, and on weighted graphs the same weight; deletes that
+ * match nothing are skipped. Undirected edges are updated in both directions. An
+ * updated list no longer keeps its input edge order. Unbuilt graphs
+ * start out empty; a graph loaded from a file is copied out of the
+ * mapping first. Must not run concurrently with other calls on the
+ * same graph.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure (graph left unchanged)
+ *   -2 : invalid input (null pointers, edge endpoint out of range)
+ *   -4 : graph is compressed
+ *
+ * @param graph Graph handle.
+ * @param inserts Edges to insert.
+ * @param insert_count Number of edges to insert.
+ * @param deletes Edges to delete.
+ * @param delete_count Number of edges to delete.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_update(
+    fossil_graph_t *graph,
+    const fossil_graph_edge_t *inserts,
+    size_t insert_count,
+    const fossil_graph_edge_t *deletes,
+    size_t delete_count
+);
+
+/**
+ * @brief Returns the number of nodes in the graph (0 for NULL).
+ */
+size_t fossil_algorithm_graph_node_count(const fossil_graph_t *graph);
+
+/**
+ * @brief Returns the number of stored adjacency entries.
+ *
+ * Undirected edges are stored once per direction, so they count twice
+ * (self-loops count once).
+ */
+size_t fossil_algorithm_graph_edge_count(const fossil_graph_t *graph);
+
+/**
+ * @brief Writes the graph's adjacency to a binary graph file.
+ *
+ * The file holds a 64-byte header followed by the CSR offsets, targets
+ * and weights (weighted graphs only), each 64-byte aligned and in host
+ * byte order. With reverse, directed graphs also store their
+ * in-adjacency, building it first if needed; undirected graphs ignore
+ * it. A graph with update slack is packed back to plain CSR first.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : I/O or allocation failure
+ *   -2 : invalid input (null pointers)
+ *
+ * @param graph Graph handle.
+ * @param file_path Output file path.
+ * @param reverse true to include the in-adjacency.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_save(fossil_graph_t *graph, const char *file_path, bool reverse);
+
+/**
+ * @brief Maps a graph file written by @ref fossil_algorithm_graph_save.
+ *
+ * The file is mapped read-only and the graph points straight into it,
+ * so loading costs O(1) regardless of size; pages are read on first
+ * touch. The graph works with every algorithm and stays valid until
+ * @ref fossil_algorithm_graph_destroy unmaps it. Rebuilding it with
+ * @ref fossil_algorithm_graph_build replaces the mapping with owned
+ * storage. The file must not be modified while mapped.
+ *
+ * The header, byte order and section sizes are checked; the arrays
+ * themselves are trusted.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : file cannot be opened or mapped, or allocation failure
+ *   -2 : invalid input (null pointers, not a compatible graph file)
+ *
+ * @param file_path Graph file path.
+ * @param graph Output graph handle.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_load(const char *file_path, fossil_graph_t **graph);
+
+/**
+ * @brief Compresses the adjacency of an unweighted graph in place.
+ *
+ * Every out-list is sorted and stored as varint-coded gaps (the first
+ * target relative to its source), replacing the 8-byte targets and the
+ * reverse adjacency. Ids that are close together cost one byte per
+ * edge, so reordering first (see @ref fossil_algorithm_graph_reorder)
+ * improves the ratio.
+ *
+ * Compressed graphs decode lists on the fly in
+ * @ref fossil_algorithm_graph_bfs (top-down steps only),
+ * @ref fossil_algorithm_graph_dfs, "cc" components and the exec ids
+ * "bfs", "dfs" and "cc". Sorting changes the order in which neighbors
+ * are visited. Every other algorithm returns -4; rebuilding with
+ * @ref fossil_algorithm_graph_build restores a plain graph.
+ *
+ * Return values:
+ *   0  : success (also for graphs already compressed or without edges)
+ *   -1 : allocation failure (graph left unchanged)
+ *   -2 : invalid input (null graph)
+ *   -4 : weighted graph
+ *
+ * @param graph Graph handle.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_compress(fossil_graph_t *graph);
+
+// ======================================================
+// Traversal API
+// ======================================================
+
+/**
+ * @brief Direction-optimizing parallel breadth-first search.
+ *
+ * Alternates between top-down steps (expand the frontier queue) and
+ * bottom-up steps (each unvisited node scans its in-edges for a parent
+ * in the frontier bitmap), switching on frontier size as in Beamer's
+ * hybrid BFS. Visited and frontier sets are bitmaps, and each step runs
+ * across the threads selected by @ref fossil_algorithm_graph_set_threads.
+ * Directed graphs build their reverse adjacency on first use.
+ *
+ * Any valid BFS tree may be returned: parents of nodes with several
+ * candidates in the previous level depend on thread timing, levels do not.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null graph, empty graph, invalid start node)
+ *
+ * @param graph Graph handle.
+ * @param start_node Source node.
+ * @param level Optional output array of node_count BFS depths
+ *        (FOSSIL_GRAPH_NO_NODE for unreached nodes).
+ * @param parent Optional output array of node_count BFS tree parents
+ *        (FOSSIL_GRAPH_NO_NODE for the source and unreached nodes).
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_bfs(
+    fossil_graph_t *graph,
+    uint64_t start_node,
+    uint64_t *level,
+    uint64_t *parent
+);
+
+/**
+ * @brief Depth-first search with pre/post-order hooks and timestamps.
+ *
+ * The search keeps an explicit stack instead of recursing, so graphs
+ * with very deep paths (10^6+ levels) do not overflow the C stack.
+ * Nodes are entered in adjacency order, matching the "dfs" visit order
+ * of @ref fossil_algorithm_graph_exec.
+ *
+ * A single clock ticks on every discovery and every finish event, so
+ * discovery[v] < discovery[w] < finish[w] < finish[v] holds exactly when
+ * w is a descendant of v. Nodes not reached keep FOSSIL_GRAPH_NO_NODE.
+ *
+ * Return values:
+ *   0  : success (including early stop requested by a callback)
+ *   -1 : allocation failure
+ *   -2 : invalid input (null graph, empty graph, invalid start node)
+ *
+ * @param graph Graph handle.
+ * @param start_node Root node, or FOSSIL_GRAPH_NO_NODE to cover every
+ *        node as a DFS forest rooted in increasing id order.
+ * @param pre Optional callback on discovery (pre-order).
+ * @param post Optional callback on finish (post-order).
+ * @param user User context passed to both callbacks.
+ * @param discovery Optional output array of node_count discovery times.
+ * @param finish Optional output array of node_count finish times.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_dfs(
+    fossil_graph_t *graph,
+    uint64_t start_node,
+    fossil_graph_visit_fn pre,
+    fossil_graph_visit_fn post,
+    void *user,
+    uint64_t *discovery,
+    uint64_t *finish
+);
+
+// ======================================================
+// Shortest Path API
+// ======================================================
+
+/**
+ * @brief Single-source shortest paths with distance and predecessor output.
+ *
+ * Supported algorithm identifiers:
+ *   - "dijkstra"       : indexed 4-ary heap with decrease-key
+ *   - "dijkstra-radix" : monotone radix heap; weights must be whole
+ *                        numbers (faster on integer road weights)
+ *   - "bellman-ford"   : edge relaxation rounds with early exit;
+ *                        accepts negative weights
+ *   - "spfa"           : queue-based Bellman-Ford that only rescans
+ *                        nodes whose distance dropped
+ *   - "bellman-ford-parallel" : synchronous rounds that pull over
+ *                        in-edges on all threads
+ *   - "delta-stepping" : parallel bucketed relaxation with atomic-min
+ *                        distances; see @ref fossil_algorithm_graph_set_delta.
+ *                        pred is rebuilt from tight in-edges, so on ties
+ *                        it may name a different (equally short) parent
+ *                        than Dijkstra, independent of the thread count
+ *
+ * Dijkstra variants stop as soon as the target is settled, and
+ * delta-stepping stops once the target's bucket is drained; the
+ * Bellman-Ford family always computes the full distance array.
+ *
+ * When a Dijkstra search stops early, only nodes settled before the
+ * target are final. Delta-stepping reports nodes beyond the target's
+ * bucket as unreached. Pass FOSSIL_GRAPH_NO_NODE as target_node to
+ * compute distances to every node.
  *
+ * Unreached nodes get dist = DBL_MAX and pred = FOSSIL_GRAPH_NO_NODE;
+ * the start node has pred = FOSSIL_GRAPH_NO_NODE.
+ *
+ * Return values:
+ *   0  : success (target reached, or no target given)
+ *   -1 : target not reachable, or allocation failure
+ *   -2 : invalid input (null pointers, invalid node ids)
+ *   -3 : unknown algorithm
+ *   -4 : unweighted graph, negative weights for Dijkstra or
+ *        delta-stepping, or non-integer weights for "dijkstra-radix"
+ *   -5 : negative cycle reachable from start_node (see
+ *        @ref fossil_algorithm_graph_negative_cycle)
+ *
+ * @param graph Graph handle.
  * @param algorithm_id Algorithm identifier string.
- * @return true if supported, false otherwise.
+ * @param start_node Source node.
+ * @param target_node Target node, or FOSSIL_GRAPH_NO_NODE.
+ * @param dist Optional output array of node_count distances.
+ * @param pred Optional output array of node_count predecessors.
+ * @return int Status code.
  */
-bool fossil_algorithm_graph_supported(const char *algorithm_id);
+int fossil_algorithm_graph_shortest_path(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t start_node,
+    uint64_t target_node,
+    double *dist,
+    uint64_t *pred
+);
 
 /**
- * @brief Returns whether the algorithm requires weighted edges.
+ * @brief Repairs single-source distances after a batch of edge updates.
  *
+ * dist and pred must hold a complete result for start_node (see
+ * @ref fossil_algorithm_graph_shortest_path with FOSSIL_GRAPH_NO_NODE)
+ * on the graph before the batch; the graph must already contain it
+ * (see @ref fossil_algorithm_graph_update). Nodes whose shortest-path
+ * tree branch used a deleted edge restart from their best unaffected
+ * in-neighbor, inserted edges relax their head, and a Dijkstra pass
+ * from only those nodes settles the rest. The work follows the changed
+ * region instead of the graph size; a directed graph builds its
+ * in-adjacency on first use.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure (dist and pred are then incomplete)
+ *   -2 : invalid input (null pointers, invalid node ids,
+ *        dist[start_node] != 0)
+ *   -4 : unweighted, compressed, or negative weights
+ *
+ * @param graph Graph handle, already updated.
+ * @param start_node Source node of the previous result.
+ * @param inserts Edges inserted by the batch.
+ * @param insert_count Number of inserted edges.
+ * @param deletes Edges deleted by the batch.
+ * @param delete_count Number of deleted edges.
+ * @param dist In/out array of node_count distances.
+ * @param pred In/out array of node_count predecessors.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_shortest_path_update(
+    fossil_graph_t *graph,
+    uint64_t start_node,
+    const fossil_graph_edge_t *inserts,
+    size_t insert_count,
+    const fossil_graph_edge_t *deletes,
+    size_t delete_count,
+    double *dist,
+    uint64_t *pred
+);
+
+/**
+ * @brief Finds a negative-weight cycle and returns its nodes.
+ *
+ * Runs Bellman-Ford rounds; if an edge can still be relaxed after
+ * node_count rounds, the predecessor chain is followed back onto the
+ * cycle. Nodes are written in edge order: cycle[0] -> cycle[1] -> ...
+ * -> cycle[len - 1] -> cycle[0].
+ *
+ * Return values:
+ *   0  : success; *cycle_length is 0 when no negative cycle exists
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers, empty graph, invalid start node)
+ *   -4 : unweighted graph
+ *
+ * @param graph Graph handle.
+ * @param start_node Only consider cycles reachable from this node, or
+ *        FOSSIL_GRAPH_NO_NODE to search the whole graph.
+ * @param cycle Output array with room for node_count nodes.
+ * @param cycle_length Output number of nodes on the cycle.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_negative_cycle(
+    fossil_graph_t *graph,
+    uint64_t start_node,
+    uint64_t *cycle,
+    size_t *cycle_length
+);
+
+/**
+ * @brief Point-to-point route with path and cost output.
+ *
+ * Supported algorithm identifiers:
+ *   - "astar" : heap-based open set keyed by g + h and a closed bitset;
+ *               settled nodes are never reopened, so the heuristic must
+ *               be consistent (h(u) <= w(u, v) + h(v), h(target) = 0)
+ *               for the result to be optimal. A NULL heuristic makes it
+ *               Dijkstra with early exit.
+ *   - "bidirectional-dijkstra" : forward search on the out-arcs and
+ *               backward search on the reverse CSR, always advancing the
+ *               side with the smaller heap top; stops once the two tops
+ *               sum to at least the best meeting cost mu. The heuristic
+ *               is ignored.
+ *   - "bidirectional-bfs" : level-synchronous BFS from both ends that
+ *               expands the smaller frontier; cost is the hop count and
+ *               unweighted graphs are accepted. The heuristic is ignored.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : target not reachable, or allocation failure
+ *   -2 : invalid input (null pointers, invalid node ids)
+ *   -3 : unknown algorithm
+ *   -4 : unweighted graph or negative weights
+ *
+ * @param graph Graph handle.
  * @param algorithm_id Algorithm identifier string.
- * @return true if weights are required.
+ * @param start_node Source node.
+ * @param target_node Target node.
+ * @param heuristic Optional lower bound on the remaining cost.
+ * @param user User pointer passed to the heuristic.
+ * @param path Optional output array with room for node_count nodes;
+ *        receives start_node ... target_node.
+ * @param path_length Optional output number of nodes on the path.
+ * @param cost Optional output path cost.
+ * @return int Status code.
  */
-bool fossil_algorithm_graph_requires_weights(const char *algorithm_id);
+int fossil_algorithm_graph_route(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t start_node,
+    uint64_t target_node,
+    fossil_graph_heuristic_fn heuristic,
+    void *user,
+    uint64_t *path,
+    size_t *path_length,
+    double *cost
+);
 
-#ifdef __cplusplus
-}
+// ======================================================
+// Contraction Hierarchies API
+// ======================================================
 
-#include <string>
+/**
+ * @brief Preprocesses a graph into a contraction hierarchy.
+ *
+ * Nodes are contracted in order of increasing edge difference (shortcuts
+ * added minus arcs removed, plus already contracted neighbors), with
+ * lazy priority updates. Contracting v inserts a shortcut u -> x, tagged
+ * with v, whenever a bounded witness search finds no path from u to x
+ * avoiding v that is as short. Self-loops are dropped and parallel edges
+ * keep the lightest weight. Preprocessing is sequential.
+ *
+ * Return values:
+ *   0  : success; *ch must be released with
+ *        @ref fossil_algorithm_graph_ch_destroy
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers)
+ *   -4 : unweighted graph or negative weights
+ *
+ * @param graph Graph handle.
+ * @param ch Output hierarchy.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_ch_build(fossil_graph_t *graph, fossil_graph_ch_t **ch);
 
-namespace fossil {
-    namespace algorithm {
-    
-    /**
-     * @brief RAII-friendly C++ wrapper for Fossil graph algorithms.
-     */
-    class Graph
-    {
-    public:
-        /**
-         * @brief Execute a graph algorithm.
-         *
-         * @param graph Graph handle.
-         * @param algorithm_id Algorithm identifier.
-         * @param start_node Start node id.
-         * @param target_node Target node id (optional).
-         * @param visit Visitor callback (optional).
-         * @param user User context pointer.
-         * @return int Status or algorithm-specific result.
-         */
-        static int exec(
-            fossil_graph_t *graph,
-            const std::string &algorithm_id,
-            uint64_t start_node = 0,
-            uint64_t target_node = 0,
-            fossil_graph_visit_fn visit = nullptr,
-            void *user = nullptr
-        ) {
-            return fossil_algorithm_graph_exec(
-                graph,
-                algorithm_id.c_str(),
-                start_node,
-                target_node,
-                visit,
-                user
-            );
-        }
-    
-        /**
-         * @brief Checks whether an algorithm is supported.
-         */
-        static bool supported(const std::string &algorithm_id) {
-            return fossil_algorithm_graph_supported(algorithm_id.c_str());
-        }
-    
-        /**
-         * @brief Checks whether an algorithm requires weighted edges.
-         */
-        static bool requires_weights(const std::string &algorithm_id) {
-            return fossil_algorithm_graph_requires_weights(algorithm_id.c_str());
+/**
+ * @brief Point-to-point shortest path on a contraction hierarchy.
+ *
+ * Runs a bidirectional Dijkstra that only relaxes arcs towards
+ * higher-ranked nodes, forward from start_node and backward from
+ * target_node; each side stops once its smallest key reaches the best
+ * meeting cost. Shortcuts on the result are unpacked recursively into
+ * input edges. The hierarchy is never modified, so any number of
+ * threads may query it concurrently.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : target not reachable, or allocation failure
+ *   -2 : invalid input (null hierarchy, invalid node ids)
+ *
+ * @param ch Hierarchy handle.
+ * @param start_node Source node.
+ * @param target_node Target node.
+ * @param path Optional output array with room for node_count nodes;
+ *        receives start_node ... target_node over input edges.
+ * @param path_length Optional output number of nodes on the path.
+ * @param cost Optional output path cost.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_ch_route(
+    const fossil_graph_ch_t *ch,
+    uint64_t start_node,
+    uint64_t target_node,
+    uint64_t *path,
+    size_t *path_length,
+    double *cost
+);
+
+/**
+ * @brief Writes a hierarchy to a binary file.
+ *
+ * The file is a 64-byte header followed by the up and down arc arrays,
+ * each 64-byte aligned, in host byte order.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : file could not be written
+ *   -2 : invalid input (null pointers)
+ *
+ * @param ch Hierarchy handle.
+ * @param file_path Output file path.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_ch_save(const fossil_graph_ch_t *ch, const char *file_path);
+
+/**
+ * @brief Maps a hierarchy file written by @ref fossil_algorithm_graph_ch_save.
+ *
+ * The file is mapped read-only and queried in place without parsing or
+ * copying; it stays mapped until the handle is destroyed. Files from a
+ * host with a different byte order are rejected.
+ *
+ * Return values:
+ *   0  : success; *ch must be released with
+ *        @ref fossil_algorithm_graph_ch_destroy
+ *   -1 : file could not be opened or mapped, or allocation failure
+ *   -2 : invalid input (null pointers, malformed file)
+ *
+ * @param file_path Input file path.
+ * @param ch Output hierarchy.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_ch_load(const char *file_path, fossil_graph_ch_t **ch);
+
+/**
+ * @brief Releases a hierarchy, unmapping it if it was loaded from a file.
+ *
+ * @param ch Hierarchy handle (may be NULL).
+ */
+void fossil_algorithm_graph_ch_destroy(fossil_graph_ch_t *ch);
+
+// ======================================================
+// All-Pairs Shortest Path API
+// ======================================================
+
+/**
+ * @brief All-pairs shortest paths with cache-blocked Floyd-Warshall.
+ *
+ * The n x n row-major dist matrix is filled from the graph's edges
+ * (parallel edges keep the lightest) and closed in 64 x 64 tiles; tiles
+ * of the same phase run on all threads and the inner min-plus loop uses
+ * SIMD when available and next is NULL.
+ *
+ * Supported element types ("f32" or "f64"): dist points to float or
+ * double. Unreachable pairs hold FLT_MAX / DBL_MAX.
+ *
+ * When next is non-NULL it receives n x n next hops: next[i * n + j] is
+ * the node after i on a shortest i -> j path (j for a direct edge, i on
+ * the diagonal) or FOSSIL_GRAPH_NO_NODE if j is unreachable. The path
+ * is i, next[i * n + j], next[next[i * n + j] * n + j], ..., j.
+ *
+ * Return values:
+ *   0  : success
+ *   -2 : invalid input (null pointers, empty or oversized graph)
+ *   -3 : unknown type_id
+ *   -4 : unweighted graph
+ *   -5 : negative cycle (some dist[i * n + i] < 0)
+ *
+ * @param graph Graph handle.
+ * @param type_id Element type of dist: "f32" or "f64".
+ * @param dist Output matrix of node_count * node_count distances.
+ * @param next Optional output matrix of node_count * node_count hops.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_floyd_warshall(
+    fossil_graph_t *graph,
+    const char *type_id,
+    void *dist,
+    uint64_t *next
+);
+
+/**
+ * @brief Floyd-Warshall over a caller-filled weight matrix.
+ *
+ * dist must already hold the direct weights: 0 on the diagonal and
+ * FLT_MAX / DBL_MAX where no edge exists. It is closed in place with
+ * the same kernels and return values as
+ * @ref fossil_algorithm_graph_floyd_warshall; next is initialized from
+ * the finite entries of dist.
+ *
+ * @param dist Matrix of node_count * node_count weights ("f32"/"f64").
+ * @param node_count Matrix dimension.
+ * @param type_id Element type of dist: "f32" or "f64".
+ * @param next Optional output matrix of node_count * node_count hops.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_floyd_warshall_matrix(
+    void *dist,
+    size_t node_count,
+    const char *type_id,
+    uint64_t *next
+);
+
+// ======================================================
+// Connectivity API
+// ======================================================
+
+/**
+ * @brief Labels the connected components of a graph.
+ *
+ * Supported algorithm identifiers:
+ *   - "cc"           : weakly connected components with lock-free
+ *                      parallel union-find (Afforest neighbor
+ *                      sampling); edge direction is ignored
+ *   - "scc"          : strongly connected components with an
+ *                      iterative (non-recursive) Tarjan
+ *   - "scc-parallel" : trimming plus a parallel forward/backward
+ *                      search that peels the giant SCC; the remainder
+ *                      is finished with Tarjan
+ *
+ * On undirected graphs the SCCs are the connected components.
+ *
+ * Component ids are dense, 0 .. component_count - 1, and numbered in
+ * the order of each component's smallest node, so the result does not
+ * depend on the thread count. The sizes entries from component_count
+ * up to node_count are set to 0.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers)
+ *   -3 : unknown algorithm
+ *
+ * @param graph Graph handle.
+ * @param algorithm_id Algorithm identifier string.
+ * @param component Output array of node_count component ids.
+ * @param sizes Optional output array with room for node_count entries;
+ *        sizes[c] receives the number of nodes in component c.
+ * @param component_count Optional output number of components.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_components(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t *component,
+    uint64_t *sizes,
+    size_t *component_count
+);
+
+/**
+ * @brief Repairs "cc" labels after a batch of edge updates.
+ *
+ * component, sizes and component_count must hold a "cc" result (from
+ * @ref fossil_algorithm_graph_components or an earlier call of this
+ * function) for the graph before the batch; the graph must already
+ * contain it (see @ref fossil_algorithm_graph_update). Each deleted
+ * edge inside a component runs two alternating searches from its
+ * endpoints that stop when they meet or when one side is exhausted,
+ * so a split costs about the size of the smaller piece. Inserted edges
+ * unite ids with union-find by size, relabelling only the smaller
+ * components. A directed graph builds its in-adjacency on first use.
+ *
+ * Ids stay below node_count with sizes[c] == 0 for unused ids, but are
+ * no longer dense or ordered; split-off pieces take the lowest unused
+ * id. Run @ref fossil_algorithm_graph_components to renumber.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure (labels left unchanged)
+ *   -2 : invalid input (null pointers, edge endpoint out of range)
+ *   -4 : graph is compressed
+ *
+ * @param graph Graph handle, already updated.
+ * @param inserts Edges inserted by the batch.
+ * @param insert_count Number of inserted edges.
+ * @param deletes Edges deleted by the batch.
+ * @param delete_count Number of deleted edges.
+ * @param component In/out array of node_count component ids.
+ * @param sizes In/out array of node_count component sizes.
+ * @param component_count In/out number of components.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_components_update(
+    fossil_graph_t *graph,
+    const fossil_graph_edge_t *inserts,
+    size_t insert_count,
+    const fossil_graph_edge_t *deletes,
+    size_t delete_count,
+    uint64_t *component,
+    uint64_t *sizes,
+    size_t *component_count
+);
+
+/**
+ * @brief Builds the graph obtained by contracting each component.
+ *
+ * Node c of the result stands for component c; an edge c -> d exists
+ * when some edge of the original graph joins the two components.
+ * Parallel edges are merged keeping the lightest weight. With "scc"
+ * labels on a directed graph the result is the condensation DAG.
+ *
+ * Return values:
+ *   0  : success; *dag must be released with
+ *        @ref fossil_algorithm_graph_destroy
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers, component id out of range)
+ *
+ * @param graph Graph handle.
+ * @param component Array of node_count component ids.
+ * @param component_count Number of components.
+ * @param dag Output graph with component_count nodes.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_condensation(
+    fossil_graph_t *graph,
+    const uint64_t *component,
+    size_t component_count,
+    fossil_graph_t **dag
+);
+
+// ======================================================
+// Cohesion API
+// ======================================================
+
+/**
+ * @brief Counts triangles and local clustering coefficients.
+ *
+ * Works on the undirected view of the graph: edge direction, weights,
+ * self-loops and parallel edges are ignored. Every edge is oriented
+ * towards its endpoint of higher (degree, id), so each triangle is
+ * found once, by intersecting two sorted oriented lists. The lists
+ * are intersected in parallel, four entries at a time with SSE2/NEON
+ * where available and by galloping when one list is much longer.
+ * Also available as "triangles" in @ref fossil_algorithm_graph_exec,
+ * which visits the nodes on at least one triangle, most first.
+ *
+ * clustering[v] = 2 * per_node[v] / (d * (d - 1)) for the d distinct
+ * neighbors of v, and 0 when d < 2.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null graph)
+ *   -4 : graph is compressed
+ *
+ * @param graph Graph handle.
+ * @param triangle_count Optional output number of triangles.
+ * @param per_node Optional output array of node_count triangle counts.
+ * @param clustering Optional output array of node_count coefficients.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_triangles(
+    fossil_graph_t *graph,
+    uint64_t *triangle_count,
+    uint64_t *per_node,
+    double *clustering
+);
+
+/**
+ * @brief Computes k-core numbers and the degeneracy order.
+ *
+ * The core number of v is the largest k such that v lies in a subgraph
+ * where every node has at least k neighbors. Works on the undirected
+ * view: direction and weights are ignored, self-loops do not count and
+ * parallel edges count once per copy.
+ *
+ * Supported algorithm identifiers:
+ *   - "kcore"          : Batagelj-Zaversnik bucket peeling, O(V + E)
+ *   - "kcore-parallel" : level-synchronous peeling; all nodes at the
+ *                        current level leave in one parallel round
+ *
+ * order receives the peeling order: core numbers never decrease along
+ * it and every node has at most degeneracy neighbors later in it. Both
+ * variants are deterministic but may order nodes differently. The same
+ * order is available as "kcore" in @ref fossil_algorithm_graph_reorder.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers)
+ *   -3 : unknown algorithm
+ *   -4 : graph is compressed
+ *
+ * @param graph Graph handle.
+ * @param algorithm_id Algorithm identifier string.
+ * @param core Optional output array of node_count core numbers.
+ * @param order Optional output array of node_count nodes.
+ * @param degeneracy Optional output largest core number.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_kcore(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t *core,
+    uint64_t *order,
+    uint64_t *degeneracy
+);
+
+// ======================================================
+// Flow API
+// ======================================================
+
+/**
+ * @brief Maximum flow and minimum cut between two nodes.
+ *
+ * Edge weights are capacities and must be finite and non-negative;
+ * unweighted graphs use capacity 1 per edge. Undirected edges carry
+ * flow in either direction up to their capacity. Self-loops are
+ * ignored.
+ *
+ * Supported algorithm identifiers:
+ *   - "dinic"        : blocking flows on BFS level graphs
+ *   - "push-relabel" : highest-label push-relabel with global
+ *                      relabeling and the gap heuristic
+ *
+ * Both run on a residual copy of the graph, which is left unchanged.
+ * Dinic does well when augmenting paths are short; push-relabel is
+ * usually faster on long-path networks such as grids.
+ * flows receives one entry per edge carrying positive flow, in node
+ * order, with weight set to the flow and from/to in the direction of
+ * flow. It needs room for @ref fossil_algorithm_graph_edge_count
+ * entries. source_side[v] is true for the nodes still reachable from
+ * source in the residual graph; the edges leaving that set form a
+ * minimum cut.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers, bad or equal endpoints)
+ *   -3 : unknown algorithm
+ *   -4 : negative capacities or compressed graph
+ *
+ * @param graph Graph handle.
+ * @param algorithm_id Algorithm identifier string.
+ * @param source Source node id.
+ * @param sink Sink node id.
+ * @param flow_value Optional output maximum flow value.
+ * @param flows Optional output array of edges carrying flow.
+ * @param flow_count Optional output number of entries in flows.
+ * @param source_side Optional output array of node_count cut sides.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_max_flow(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t source,
+    uint64_t sink,
+    double *flow_value,
+    fossil_graph_edge_t *flows,
+    size_t *flow_count,
+    bool *source_side
+);
+
+// ======================================================
+// Matching API
+// ======================================================
+
+/**
+ * @brief Maximum cardinality matching of a bipartite graph.
+ *
+ * Hopcroft-Karp, O(E * sqrt(V)), on the undirected view of the graph;
+ * weights are ignored. left[v] marks the left side; edges within one
+ * side are ignored. Without left, each component is two-colored with
+ * its lowest id on the left. Also available as "hopcroft-karp" in
+ * @ref fossil_algorithm_graph_exec.
+ *
+ * mate[v] receives v's partner, or FOSSIL_GRAPH_NO_NODE when v is
+ * unmatched, for nodes on both sides.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null graph)
+ *   -4 : no left given and the graph is not bipartite, or compressed
+ *
+ * @param graph Graph handle.
+ * @param left Optional array of node_count side flags.
+ * @param mate Optional output array of node_count partners.
+ * @param matching_size Optional output number of matched pairs.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_matching(
+    fossil_graph_t *graph,
+    const bool *left,
+    uint64_t *mate,
+    size_t *matching_size
+);
+
+/**
+ * @brief Minimum-cost assignment on a dense cost matrix.
+ *
+ * cost is row-major, rows x cols. Every row is assigned a distinct
+ * column when rows <= cols; otherwise every column gets a distinct
+ * row and the remaining rows stay unassigned. Solved by the Hungarian
+ * method in O(min^2 * max) time with linear scans over cost rows; the
+ * matrix is transposed into a copy when rows > cols. For maximum
+ * profit, negate the costs.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null cost, NaN or infinite entries)
+ *
+ * @param cost Cost matrix of rows * cols entries.
+ * @param rows Number of rows (e.g. workers).
+ * @param cols Number of columns (e.g. jobs).
+ * @param assignment Optional output array of rows column indices,
+ *        FOSSIL_GRAPH_NO_NODE for unassigned rows.
+ * @param total_cost Optional output sum of the assigned costs.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_assignment(
+    const double *cost,
+    size_t rows,
+    size_t cols,
+    uint64_t *assignment,
+    double *total_cost
+);
+
+// ======================================================
+// Ordering API
+// ======================================================
+
+/**
+ * @brief Topological order of a directed graph (Kahn's algorithm).
+ *
+ * Supported algorithm identifiers:
+ *   - "toposort"          : serial Kahn with a FIFO queue
+ *   - "toposort-parallel" : level-synchronous Kahn; each wavefront is
+ *                           released on all threads and emitted in
+ *                           node order
+ *
+ * level[v] receives the wavefront of v (the longest hop count from a
+ * source); all nodes of one level can run concurrently.
+ *
+ * If the graph has a cycle, order starts with the *count nodes that
+ * could be ordered, followed by the offending nodes (those on a cycle
+ * or reachable only through one), whose level is 0. See
+ * @ref fossil_algorithm_graph_find_cycle to extract one cycle.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : the graph has a cycle, or allocation failure
+ *   -2 : invalid input (null pointers)
+ *   -3 : unknown algorithm
+ *   -4 : undirected graph
+ *
+ * @param graph Graph handle.
+ * @param algorithm_id Algorithm identifier string.
+ * @param order Output array of node_count nodes.
+ * @param level Optional output array of node_count wavefront indices.
+ * @param count Optional output number of ordered nodes.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_toposort(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t *order,
+    uint64_t *level,
+    size_t *count
+);
+
+/**
+ * @brief Finds a directed cycle and returns its nodes.
+ *
+ * Nodes are written in edge order: cycle[0] -> cycle[1] -> ... ->
+ * cycle[len - 1] -> cycle[0]; a self-loop gives a cycle of length 1.
+ *
+ * Return values:
+ *   0  : success; *cycle_length is 0 when the graph is acyclic
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers)
+ *   -4 : undirected graph
+ *
+ * @param graph Graph handle.
+ * @param cycle Output array with room for node_count nodes.
+ * @param cycle_length Output number of nodes on the cycle.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_find_cycle(
+    fossil_graph_t *graph,
+    uint64_t *cycle,
+    size_t *cycle_length
+);
+
+/**
+ * @brief Shortest or longest paths on a DAG in O(V + E).
+ *
+ * Edges are relaxed once, in topological order. Negative weights are
+ * allowed; an unweighted graph counts every edge as 1. The "longest"
+ * mode computes critical paths: with start_node = FOSSIL_GRAPH_NO_NODE
+ * every node may start a path (dist 0), so dist[v] is the length of
+ * the longest chain ending at v and pred traces it back.
+ *
+ * Supported modes: "shortest", "longest".
+ *
+ * Unreached nodes get pred = FOSSIL_GRAPH_NO_NODE and dist = DBL_MAX
+ * ("shortest") or -DBL_MAX ("longest").
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers, empty graph, invalid start node)
+ *   -3 : unknown mode
+ *   -4 : undirected graph or the graph has a cycle
+ *
+ * @param graph Graph handle.
+ * @param mode "shortest" or "longest".
+ * @param start_node Source node, or FOSSIL_GRAPH_NO_NODE for all nodes.
+ * @param dist Output array of node_count path lengths.
+ * @param pred Output array of node_count predecessors.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_dag_path(
+    fossil_graph_t *graph,
+    const char *mode,
+    uint64_t start_node,
+    double *dist,
+    uint64_t *pred
+);
+
+// ======================================================
+// Spanning Tree API
+// ======================================================
+
+/**
+ * @brief Minimum spanning forest of an undirected weighted graph.
+ *
+ * Supported algorithm identifiers:
+ *   - "mst-kruskal" : edges radix-sorted by weight, then union-find
+ *   - "mst-prim"    : indexed 4-ary heap, one tree per component
+ *   - "mst-boruvka" : parallel Boruvka rounds with lock-free
+ *                     union-find; edges come out in no fixed order
+ *
+ * Each tree edge is written with from < to. A disconnected graph gives
+ * one tree per component, i.e. node_count - components edges. When
+ * weights tie, the algorithms may choose different trees of the same
+ * total weight.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers)
+ *   -3 : unknown algorithm
+ *   -4 : directed or unweighted graph
+ *
+ * @param graph Graph handle.
+ * @param algorithm_id Algorithm identifier string.
+ * @param edges Optional output array with room for node_count - 1 edges.
+ * @param edge_count Optional output number of tree edges.
+ * @param total_weight Optional output sum of the tree edge weights.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_mst(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    fossil_graph_edge_t *edges,
+    size_t *edge_count,
+    double *total_weight
+);
+
+// ======================================================
+// Ranking API
+// ======================================================
+
+/**
+ * @brief PageRank or personalized PageRank by power iteration.
+ *
+ * Supported algorithm identifiers:
+ *   - "pagerank" : teleport spread uniformly over all nodes
+ *   - "ppr"      : teleport spread uniformly over the distinct seeds
+ *
+ * Each iteration pulls rank along in-edges in parallel. Edge weights
+ * are ignored, and an undirected edge counts in both directions. Rank
+ * of nodes without out-edges is redistributed over the teleport set, so
+ * the ranks always sum to 1. Large graphs are processed in cache-sized
+ * source segments. Results do not depend on the thread count.
+ *
+ * Iteration stops when the L1 change of an iteration drops below
+ * tolerance, when metric returns false, or after max_iterations. With
+ * tolerance <= 0 exactly max_iterations iterations run.
+ *
+ * Supported element types ("f32" or "f64"): rank points to float or
+ * double.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure, or no convergence within max_iterations
+ *        (rank holds the last iterate)
+ *   -2 : invalid input (null pointers, empty graph, damping outside
+ *        [0, 1), zero max_iterations, missing or invalid seeds)
+ *   -3 : unknown algorithm or type_id
+ *
+ * @param graph Graph handle.
+ * @param algorithm_id "pagerank" or "ppr".
+ * @param type_id Element type of rank: "f32" or "f64".
+ * @param seeds Seed nodes for "ppr" (ignored for "pagerank").
+ * @param seed_count Number of seeds.
+ * @param damping Probability of following an edge, e.g. 0.85.
+ * @param tolerance L1 convergence threshold.
+ * @param max_iterations Upper bound on iterations.
+ * @param rank Output array of node_count ranks.
+ * @param iterations Optional output number of iterations run.
+ * @param metric Optional callback receiving the L1 change per iteration.
+ * @param user User context passed to metric.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_pagerank(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    const char *type_id,
+    const uint64_t *seeds,
+    size_t seed_count,
+    double damping,
+    double tolerance,
+    size_t max_iterations,
+    void *rank,
+    size_t *iterations,
+    fossil_graph_metric_fn metric,
+    void *user
+);
+
+/**
+ * @brief Betweenness centrality by Brandes' algorithm.
+ *
+ * centrality[v] sums, over all source / target pairs, the fraction of
+ * shortest paths that pass through v. Unweighted graphs use BFS and
+ * weighted graphs Dijkstra; parallel edges count as distinct paths.
+ * On undirected graphs each pair counts once. Sources are processed in
+ * parallel with one accumulator per thread, so sums may differ in the
+ * last bits between thread counts. Also available as "betweenness" in
+ * @ref fossil_algorithm_graph_exec, which ranks by exact centrality.
+ *
+ * With pivots in (0, node_count), only pivots distinct sources drawn
+ * from seed are searched and the result is scaled by
+ * node_count / pivots: an unbiased estimate at pivots / node_count of
+ * the exact cost. The same seed draws the same sources.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers)
+ *   -4 : negative weights or compressed graph
+ *
+ * @param graph Graph handle.
+ * @param pivots Number of sampled sources; 0 for the exact result.
+ * @param seed Seed for drawing the sampled sources.
+ * @param centrality Output array of node_count values.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_betweenness(
+    fossil_graph_t *graph,
+    size_t pivots,
+    uint64_t seed,
+    double *centrality
+);
+
+// ======================================================
+// Reordering API
+// ======================================================
+
+/**
+ * @brief Computes a locality-improving node order.
+ *
+ * Supported algorithm identifiers:
+ *   - "rcm"    : reverse Cuthill-McKee from pseudo-peripheral nodes;
+ *                keeps neighbors close and shrinks the bandwidth
+ *   - "degree" : descending degree, ties by id; packs hubs together
+ *   - "bfs"    : breadth-first order from the highest-degree node of
+ *                each component
+ *   - "kcore"  : degeneracy order, periphery first and densest core
+ *                last; orienting edges along it bounds the out-degree
+ *                by the degeneracy, which helps triangle and clique
+ *                enumeration
+ *
+ * Orders are computed on the undirected view of the graph (out- plus
+ * in-edges) and are deterministic. perm[old_id] receives new_id; pass
+ * it to @ref fossil_algorithm_graph_relabel.
+ *
+ * Return values:
+ *   0  : success
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers)
+ *   -3 : unknown algorithm
+ *
+ * @param graph Graph handle.
+ * @param algorithm_id Algorithm identifier string.
+ * @param perm Output array of node_count new ids.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_reorder(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t *perm
+);
+
+/**
+ * @brief Builds a copy of the graph with renumbered nodes.
+ *
+ * Node v of graph becomes node perm[v] of the new graph, which has the
+ * same direction, weights and edges. Each adjacency list of the new
+ * graph is sorted by target id. Results computed on the new graph map
+ * back through perm: the value for old node v sits at index perm[v],
+ * and node ids in results (pred, parent, ...) are new ids.
+ *
+ * Return values:
+ *   0  : success (*relabeled must be destroyed by the caller)
+ *   -1 : allocation failure
+ *   -2 : invalid input (null pointers, perm not a permutation)
+ *
+ * @param graph Graph handle.
+ * @param perm New id of every node (a permutation of 0..node_count-1).
+ * @param relabeled Output new graph.
+ * @return int Status code.
+ */
+int fossil_algorithm_graph_relabel(
+    fossil_graph_t *graph,
+    const uint64_t *perm,
+    fossil_graph_t **relabeled
+);
+
+// ======================================================
+// Extended Utility API
+// ======================================================
+
+/**
+ * @brief Checks whether a graph algorithm is supported.
+ *
+ * @param algorithm_id Algorithm identifier string.
+ * @return true if supported, false otherwise.
+ */
+bool fossil_algorithm_graph_supported(const char *algorithm_id);
+
+/**
+ * @brief Returns whether the algorithm requires weighted edges.
+ *
+ * @param algorithm_id Algorithm identifier string.
+ * @return true if weights are required.
+ */
+bool fossil_algorithm_graph_requires_weights(const char *algorithm_id);
+
+/**
+ * @brief Sets the number of threads used by parallel graph algorithms.
+ *
+ * The setting is process-wide; configure it before running algorithms.
+ *
+ * @param threads Thread count, or 0 to use every hardware thread.
+ */
+void fossil_algorithm_graph_set_threads(size_t threads);
+
+/**
+ * @brief Returns the effective number of threads for parallel algorithms.
+ */
+size_t fossil_algorithm_graph_get_threads(void);
+
+/**
+ * @brief Sets the bucket width used by "delta-stepping".
+ *
+ * Arcs no heavier than delta are relaxed repeatedly while a bucket is
+ * drained; heavier arcs are relaxed once per settled node. Small values
+ * approach Dijkstra's work with little parallelism, large values approach
+ * Bellman-Ford. The automatic choice is max_weight / average degree. A
+ * delta too small to keep max_weight within 65536 buckets is raised.
+ * The setting is process-wide.
+ *
+ * @param delta Bucket width, or <= 0 to choose it per graph.
+ */
+void fossil_algorithm_graph_set_delta(double delta);
+
+/**
+ * @brief Returns the configured delta-stepping bucket width (<= 0 = auto).
+ */
+double fossil_algorithm_graph_get_delta(void);
+
+#ifdef __cplusplus
+}
+
+#include <string>
+
+namespace fossil {
+    namespace algorithm {
+    
+    /**
+     * @brief RAII-friendly C++ wrapper for Fossil graph algorithms.
+     */
+    class Graph
+    {
+    public:
+        /**
+         * @brief Create an empty graph with node_count nodes.
+         */
+        static fossil_graph_t *create(
+            size_t node_count,
+            bool directed = false,
+            bool weighted = false
+        ) {
+            return fossil_algorithm_graph_create(node_count, directed, weighted);
+        }
+
+        /**
+         * @brief Destroy a graph created with create().
+         */
+        static void destroy(fossil_graph_t *graph) {
+            fossil_algorithm_graph_destroy(graph);
+        }
+
+        /**
+         * @brief Build CSR adjacency from an edge array.
+         */
+        static int build(
+            fossil_graph_t *graph,
+            const fossil_graph_edge_t *edges,
+            size_t edge_count
+        ) {
+            return fossil_algorithm_graph_build(graph, edges, edge_count);
+        }
+
+        /**
+         * @brief Inserts and deletes a batch of edges in place.
+         */
+        static int update(
+            fossil_graph_t *graph,
+            const fossil_graph_edge_t *inserts,
+            size_t insert_count,
+            const fossil_graph_edge_t *deletes = nullptr,
+            size_t delete_count = 0
+        ) {
+            return fossil_algorithm_graph_update(graph, inserts, insert_count, deletes, delete_count);
+        }
+
+        /**
+         * @brief Number of nodes in the graph.
+         */
+        static size_t node_count(const fossil_graph_t *graph) {
+            return fossil_algorithm_graph_node_count(graph);
+        }
+
+        /**
+         * @brief Number of stored adjacency entries.
+         */
+        static size_t edge_count(const fossil_graph_t *graph) {
+            return fossil_algorithm_graph_edge_count(graph);
+        }
+
+        /**
+         * @brief Writes the graph to a binary graph file.
+         */
+        static int save(fossil_graph_t *graph, const std::string &file_path, bool reverse = true) {
+            return fossil_algorithm_graph_save(graph, file_path.c_str(), reverse);
+        }
+
+        /**
+         * @brief Maps a binary graph file into a read-only graph.
+         */
+        static int load(const std::string &file_path, fossil_graph_t **graph) {
+            return fossil_algorithm_graph_load(file_path.c_str(), graph);
+        }
+
+        /**
+         * @brief Replaces the adjacency with varint-coded sorted lists.
+         */
+        static int compress(fossil_graph_t *graph) {
+            return fossil_algorithm_graph_compress(graph);
+        }
+
+        /**
+         * @brief Execute a graph algorithm.
+         *
+         * @param graph Graph handle.
+         * @param algorithm_id Algorithm identifier.
+         * @param start_node Start node id.
+         * @param target_node Target node id (optional).
+         * @param visit Visitor callback (optional).
+         * @param user User context pointer.
+         * @return int Status or algorithm-specific result.
+         */
+        static int exec(
+            fossil_graph_t *graph,
+            const std::string &algorithm_id,
+            uint64_t start_node = 0,
+            uint64_t target_node = 0,
+            fossil_graph_visit_fn visit = nullptr,
+            void *user = nullptr
+        ) {
+            return fossil_algorithm_graph_exec(
+                graph,
+                algorithm_id.c_str(),
+                start_node,
+                target_node,
+                visit,
+                user
+            );
+        }
+    
+        /**
+         * @brief Direction-optimizing parallel BFS with level/parent output.
+         */
+        static int bfs(
+            fossil_graph_t *graph,
+            uint64_t start_node,
+            uint64_t *level,
+            uint64_t *parent = nullptr
+        ) {
+            return fossil_algorithm_graph_bfs(graph, start_node, level, parent);
+        }
+
+        /**
+         * @brief Iterative DFS with pre/post hooks and timestamps.
+         */
+        static int dfs(
+            fossil_graph_t *graph,
+            uint64_t start_node,
+            fossil_graph_visit_fn pre,
+            fossil_graph_visit_fn post = nullptr,
+            void *user = nullptr,
+            uint64_t *discovery = nullptr,
+            uint64_t *finish = nullptr
+        ) {
+            return fossil_algorithm_graph_dfs(
+                graph, start_node, pre, post, user, discovery, finish);
+        }
+
+        /**
+         * @brief Single-source shortest paths with dist/pred output.
+         */
+        static int shortest_path(
+            fossil_graph_t *graph,
+            const std::string &algorithm_id,
+            uint64_t start_node,
+            uint64_t target_node = FOSSIL_GRAPH_NO_NODE,
+            double *dist = nullptr,
+            uint64_t *pred = nullptr
+        ) {
+            return fossil_algorithm_graph_shortest_path(
+                graph,
+                algorithm_id.c_str(),
+                start_node,
+                target_node,
+                dist,
+                pred
+            );
+        }
+
+        /**
+         * @brief Repairs distances from start_node after update().
+         */
+        static int shortest_path_update(
+            fossil_graph_t *graph,
+            uint64_t start_node,
+            const fossil_graph_edge_t *inserts,
+            size_t insert_count,
+            const fossil_graph_edge_t *deletes,
+            size_t delete_count,
+            double *dist,
+            uint64_t *pred
+        ) {
+            return fossil_algorithm_graph_shortest_path_update(
+                graph, start_node, inserts, insert_count, deletes, delete_count, dist, pred);
+        }
+
+        /**
+         * @brief Finds a negative cycle (cycle_length is 0 if none).
+         */
+        static int negative_cycle(
+            fossil_graph_t *graph,
+            uint64_t *cycle,
+            size_t *cycle_length,
+            uint64_t start_node = FOSSIL_GRAPH_NO_NODE
+        ) {
+            return fossil_algorithm_graph_negative_cycle(
+                graph, start_node, cycle, cycle_length);
+        }
+
+        /**
+         * @brief Point-to-point route (e.g. "astar", "bidirectional-dijkstra") with path and cost.
+         */
+        static int route(
+            fossil_graph_t *graph,
+            const std::string &algorithm_id,
+            uint64_t start_node,
+            uint64_t target_node,
+            uint64_t *path,
+            size_t *path_length,
+            double *cost = nullptr,
+            fossil_graph_heuristic_fn heuristic = nullptr,
+            void *user = nullptr
+        ) {
+            return fossil_algorithm_graph_route(
+                graph,
+                algorithm_id.c_str(),
+                start_node,
+                target_node,
+                heuristic,
+                user,
+                path,
+                path_length,
+                cost
+            );
+        }
+
+        /**
+         * @brief Preprocesses a graph into a contraction hierarchy.
+         */
+        static int ch_build(fossil_graph_t *graph, fossil_graph_ch_t **ch) {
+            return fossil_algorithm_graph_ch_build(graph, ch);
+        }
+
+        /**
+         * @brief Point-to-point query on a contraction hierarchy.
+         */
+        static int ch_route(
+            const fossil_graph_ch_t *ch,
+            uint64_t start_node,
+            uint64_t target_node,
+            uint64_t *path = nullptr,
+            size_t *path_length = nullptr,
+            double *cost = nullptr
+        ) {
+            return fossil_algorithm_graph_ch_route(
+                ch, start_node, target_node, path, path_length, cost);
+        }
+
+        /**
+         * @brief Writes a hierarchy to a binary file.
+         */
+        static int ch_save(const fossil_graph_ch_t *ch, const std::string &file_path) {
+            return fossil_algorithm_graph_ch_save(ch, file_path.c_str());
+        }
+
+        /**
+         * @brief Maps a hierarchy file read-only.
+         */
+        static int ch_load(const std::string &file_path, fossil_graph_ch_t **ch) {
+            return fossil_algorithm_graph_ch_load(file_path.c_str(), ch);
+        }
+
+        /**
+         * @brief Releases a hierarchy.
+         */
+        static void ch_destroy(fossil_graph_ch_t *ch) {
+            fossil_algorithm_graph_ch_destroy(ch);
+        }
+
+        /**
+         * @brief All-pairs shortest paths into a caller-provided matrix.
+         */
+        static int floyd_warshall(
+            fossil_graph_t *graph,
+            const std::string &type_id,
+            void *dist,
+            uint64_t *next = nullptr
+        ) {
+            return fossil_algorithm_graph_floyd_warshall(
+                graph, type_id.c_str(), dist, next);
+        }
+
+        /**
+         * @brief Closes a caller-filled weight matrix in place.
+         */
+        static int floyd_warshall_matrix(
+            void *dist,
+            size_t node_count,
+            const std::string &type_id,
+            uint64_t *next = nullptr
+        ) {
+            return fossil_algorithm_graph_floyd_warshall_matrix(
+                dist, node_count, type_id.c_str(), next);
+        }
+
+        /**
+         * @brief Labels connected components (ids in smallest-node order).
+         */
+        static int components(
+            fossil_graph_t *graph,
+            const std::string &algorithm_id,
+            uint64_t *component,
+            uint64_t *sizes = nullptr,
+            size_t *component_count = nullptr
+        ) {
+            return fossil_algorithm_graph_components(
+                graph, algorithm_id.c_str(), component, sizes, component_count);
+        }
+
+        /**
+         * @brief Repairs "cc" labels after update().
+         */
+        static int components_update(
+            fossil_graph_t *graph,
+            const fossil_graph_edge_t *inserts,
+            size_t insert_count,
+            const fossil_graph_edge_t *deletes,
+            size_t delete_count,
+            uint64_t *component,
+            uint64_t *sizes,
+            size_t *component_count
+        ) {
+            return fossil_algorithm_graph_components_update(
+                graph, inserts, insert_count, deletes, delete_count, component, sizes, component_count);
+        }
+
+        /**
+         * @brief Counts triangles, per node and clustering optional.
+         */
+        static int triangles(
+            fossil_graph_t *graph,
+            uint64_t *triangle_count,
+            uint64_t *per_node = nullptr,
+            double *clustering = nullptr
+        ) {
+            return fossil_algorithm_graph_triangles(graph, triangle_count, per_node, clustering);
+        }
+
+        /**
+         * @brief Computes core numbers and the degeneracy order.
+         */
+        static int kcore(
+            fossil_graph_t *graph,
+            const std::string &algorithm_id,
+            uint64_t *core,
+            uint64_t *order = nullptr,
+            uint64_t *degeneracy = nullptr
+        ) {
+            return fossil_algorithm_graph_kcore(graph, algorithm_id.c_str(), core, order, degeneracy);
+        }
+
+        /**
+         * @brief Maximum flow; edge flows and the cut side optional.
+         */
+        static int max_flow(
+            fossil_graph_t *graph,
+            const std::string &algorithm_id,
+            uint64_t source,
+            uint64_t sink,
+            double *flow_value,
+            fossil_graph_edge_t *flows = nullptr,
+            size_t *flow_count = nullptr,
+            bool *source_side = nullptr
+        ) {
+            return fossil_algorithm_graph_max_flow(
+                graph, algorithm_id.c_str(), source, sink, flow_value, flows, flow_count, source_side);
+        }
+
+        /**
+         * @brief Maximum bipartite matching; side flags optional.
+         */
+        static int matching(
+            fossil_graph_t *graph,
+            const bool *left,
+            uint64_t *mate,
+            size_t *matching_size = nullptr
+        ) {
+            return fossil_algorithm_graph_matching(graph, left, mate, matching_size);
+        }
+
+        /**
+         * @brief Minimum-cost assignment on a row-major cost matrix.
+         */
+        static int assignment(
+            const double *cost,
+            size_t rows,
+            size_t cols,
+            uint64_t *assignment,
+            double *total_cost = nullptr
+        ) {
+            return fossil_algorithm_graph_assignment(cost, rows, cols, assignment, total_cost);
+        }
+
+        /**
+         * @brief Contracts components into a new graph (the SCC DAG).
+         */
+        static int condensation(
+            fossil_graph_t *graph,
+            const uint64_t *component,
+            size_t component_count,
+            fossil_graph_t **dag
+        ) {
+            return fossil_algorithm_graph_condensation(
+                graph, component, component_count, dag);
+        }
+
+        /**
+         * @brief Topological order; returns -1 and the offending nodes on a cycle.
+         */
+        static int toposort(
+            fossil_graph_t *graph,
+            const std::string &algorithm_id,
+            uint64_t *order,
+            uint64_t *level = nullptr,
+            size_t *count = nullptr
+        ) {
+            return fossil_algorithm_graph_toposort(
+                graph, algorithm_id.c_str(), order, level, count);
+        }
+
+        /**
+         * @brief Finds a directed cycle (cycle_length is 0 if none).
+         */
+        static int find_cycle(
+            fossil_graph_t *graph,
+            uint64_t *cycle,
+            size_t *cycle_length
+        ) {
+            return fossil_algorithm_graph_find_cycle(graph, cycle, cycle_length);
+        }
+
+        /**
+         * @brief DAG shortest or longest (critical) paths in linear time.
+         */
+        static int dag_path(
+            fossil_graph_t *graph,
+            const std::string &mode,
+            double *dist,
+            uint64_t *pred,
+            uint64_t start_node = FOSSIL_GRAPH_NO_NODE
+        ) {
+            return fossil_algorithm_graph_dag_path(
+                graph, mode.c_str(), start_node, dist, pred);
+        }
+
+        /**
+         * @brief Minimum spanning forest as an edge list plus total weight.
+         */
+        static int mst(
+            fossil_graph_t *graph,
+            const std::string &algorithm_id,
+            fossil_graph_edge_t *edges,
+            size_t *edge_count = nullptr,
+            double *total_weight = nullptr
+        ) {
+            return fossil_algorithm_graph_mst(
+                graph, algorithm_id.c_str(), edges, edge_count, total_weight);
+        }
+
+        /**
+         * @brief PageRank or personalized PageRank into a rank array.
+         */
+        static int pagerank(
+            fossil_graph_t *graph,
+            const std::string &algorithm_id,
+            const std::string &type_id,
+            void *rank,
+            const uint64_t *seeds = nullptr,
+            size_t seed_count = 0,
+            double damping = 0.85,
+            double tolerance = 1e-6,
+            size_t max_iterations = 100,
+            size_t *iterations = nullptr,
+            fossil_graph_metric_fn metric = nullptr,
+            void *user = nullptr
+        ) {
+            return fossil_algorithm_graph_pagerank(
+                graph, algorithm_id.c_str(), type_id.c_str(), seeds, seed_count,
+                damping, tolerance, max_iterations, rank, iterations, metric, user);
+        }
+
+        /**
+         * @brief Betweenness centrality, exact or from sampled pivots.
+         */
+        static int betweenness(
+            fossil_graph_t *graph,
+            double *centrality,
+            size_t pivots = 0,
+            uint64_t seed = 0
+        ) {
+            return fossil_algorithm_graph_betweenness(graph, pivots, seed, centrality);
+        }
+
+        /**
+         * @brief Locality order as perm[old_id] = new_id.
+         */
+        static int reorder(
+            fossil_graph_t *graph,
+            const std::string &algorithm_id,
+            uint64_t *perm
+        ) {
+            return fossil_algorithm_graph_reorder(graph, algorithm_id.c_str(), perm);
+        }
+
+        /**
+         * @brief Copy of the graph with node v renamed to perm[v].
+         */
+        static int relabel(
+            fossil_graph_t *graph,
+            const uint64_t *perm,
+            fossil_graph_t **relabeled
+        ) {
+            return fossil_algorithm_graph_relabel(graph, perm, relabeled);
+        }
+
+        /**
+         * @brief Checks whether an algorithm is supported.
+         */
+        static bool supported(const std::string &algorithm_id) {
+            return fossil_algorithm_graph_supported(algorithm_id.c_str());
+        }
+    
+        /**
+         * @brief Checks whether an algorithm requires weighted edges.
+         */
+        static bool requires_weights(const std::string &algorithm_id) {
+            return fossil_algorithm_graph_requires_weights(algorithm_id.c_str());
+        }
+
+        /**
+         * @brief Sets the thread count for parallel algorithms (0 = auto).
+         */
+        static void set_threads(size_t threads) {
+            fossil_algorithm_graph_set_threads(threads);
+        }
+
+        /**
+         * @brief Effective thread count for parallel algorithms.
+         */
+        static size_t get_threads() {
+            return fossil_algorithm_graph_get_threads();
+        }
+
+        /**
+         * @brief Sets the delta-stepping bucket width (<= 0 = auto).
+         */
+        static void set_delta(double delta) {
+            fossil_algorithm_graph_set_delta(delta);
+        }
+
+        /**
+         * @brief Configured delta-stepping bucket width.
+         */
+        static double get_delta() {
+            return fossil_algorithm_graph_get_delta();
         }
     };
     
@@ -22,255 +22,9577 @@
  * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
  * -----------------------------------------------------------------------------
  */
+#if defined(__APPLE__) && !defined(_DARWIN_C_SOURCE)
+#define _DARWIN_C_SOURCE
+#endif
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "fossil/algorithm/graph.h"
 #include <stdlib.h>
 #include <string.h>
+#include <stdio.h>
 #include <float.h>
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GRAPH_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GRAPH_SIMD_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GRAPH_SIMD_NEON 1
+#endif
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 // ======================================================
 // Internal Graph Representation
 // ======================================================
 
-typedef struct fossil_graph_edge_node {
-    uint64_t to;
-    double   weight;
-    struct fossil_graph_edge_node *next;
-} fossil_graph_edge_node_t;
+/*
+ * Compressed sparse row adjacency. The edges of node v occupy the
+ * half-open range [offsets[v], offsets[v + 1]) of targets/weights, so a
+ * traversal walks contiguous memory instead of chasing list pointers.
+ * After a batched update the lists carry slack: node v owns
+ * [offsets[v], offsets[v + 1]) but its live edges end at ends[v].
+ */
+typedef struct fossil_graph_adj {
+    uint64_t *offsets;   // node_count + 1 entries
+    uint64_t *targets;   // edge_count entries (capacity when slack)
+    double   *weights;   // edge_count entries, NULL when unweighted
+    uint64_t *ends;      // node_count live list ends, NULL when compact
+} fossil_graph_adj_t;
+
+// Varint-coded adjacency of a compressed graph (see graph_compress).
+typedef struct fossil_graph_packed {
+    uint64_t      *offsets;   // node_count + 1 byte offsets into bytes
+    unsigned char *bytes;     // NULL unless the graph is compressed
+} fossil_graph_packed_t;
+
+/*
+ * Out-adjacency plus a reverse (in-)adjacency that is built on first
+ * use by algorithms pulling along incoming edges. Undirected graphs
+ * store every edge once per direction, so they reuse the forward side.
+ */
+typedef struct fossil_graph_csr {
+    size_t             edge_count;
+    fossil_graph_adj_t out;
+    fossil_graph_adj_t in;        // offsets == NULL until built
+    bool               negative;  // some weight is < 0
+    bool               integral;  // all weights are whole numbers in [0, 2^53]
+    void              *mapping;   // file view holding out, NULL when owned
+    size_t             mapping_size;
+    bool               in_mapped; // in also points into the mapping
+    fossil_graph_packed_t packed; // replaces out and in when compressed
+    uint64_t           negative_arcs;   // maintained once out has slack
+    uint64_t           fractional_arcs;
+} fossil_graph_csr_t;
+
+struct fossil_graph {
+    size_t node_count;
+    bool directed;
+    bool weighted;
+    fossil_graph_csr_t *csr;
+};
+
+// ======================================================
+// Internal Utilities
+// ======================================================
+
+static bool algorithm_equals(const char *a, const char *b)
+{
+    return a && b && strcmp(a, b) == 0;
+}
+
+static void adj_free(fossil_graph_adj_t *adj)
+{
+    free(adj->offsets);
+    free(adj->targets);
+    free(adj->weights);
+    free(adj->ends);
+}
+
+static void graph_file_unmap(void *base, size_t size);
+
+// Drops the plain adjacency, unmapping it when it lives in a file view.
+static void csr_release(fossil_graph_csr_t *csr)
+{
+    if (csr->mapping) {
+        graph_file_unmap(csr->mapping, csr->mapping_size);
+        if (!csr->in_mapped)
+            adj_free(&csr->in);
+    } else {
+        adj_free(&csr->out);
+        adj_free(&csr->in);
+    }
+    memset(&csr->out, 0, sizeof(csr->out));
+    memset(&csr->in, 0, sizeof(csr->in));
+    csr->mapping = NULL;
+    csr->mapping_size = 0;
+    csr->in_mapped = false;
+}
+
+static void csr_free(fossil_graph_csr_t *csr)
+{
+    if (!csr) return;
+    csr_release(csr);
+    free(csr->packed.offsets);
+    free(csr->packed.bytes);
+    free(csr);
+}
+
+// Defensive: adj may be NULL in stub/test graphs and in graphs that
+// were created but never built; such nodes simply have no edges.
+static inline void
+graph_adj_range(
+    const fossil_graph_adj_t *adj,
+    uint64_t v,
+    uint64_t *begin,
+    uint64_t *end
+) {
+    if (adj) {
+        *begin = adj->offsets[v];
+        *end   = adj->ends ? adj->ends[v] : adj->offsets[v + 1];
+    } else {
+        *begin = 0;
+        *end   = 0;
+    }
+}
+
+// NULL when unbuilt or compressed.
+static inline const fossil_graph_adj_t *graph_out(const fossil_graph_t *graph)
+{
+    return graph->csr && graph->csr->out.offsets ? &graph->csr->out : NULL;
+}
+
+static inline void
+graph_edge_range(
+    const fossil_graph_t *graph,
+    uint64_t v,
+    uint64_t *begin,
+    uint64_t *end
+) {
+    graph_adj_range(graph_out(graph), v, begin, end);
+}
+
+static inline uint64_t graph_adj_degree(const fossil_graph_adj_t *adj, uint64_t v)
+{
+    uint64_t begin, end;
+    graph_adj_range(adj, v, &begin, &end);
+    return end - begin;
+}
+
+// Counting-sort transpose of src; dst lists are sorted by source id.
+static bool
+adj_transpose(
+    size_t node_count,
+    const fossil_graph_adj_t *src,
+    fossil_graph_adj_t *dst
+) {
+    size_t arcs = 0;
+    for (uint64_t u = 0; u < node_count; u++) {
+        uint64_t begin, end;
+        graph_adj_range(src, u, &begin, &end);
+        arcs += end - begin;
+    }
+    dst->offsets = calloc(node_count + 1, sizeof(uint64_t));
+    dst->targets = malloc((arcs ? arcs : 1) * sizeof(uint64_t));
+    dst->weights = src->weights ? malloc((arcs ? arcs : 1) * sizeof(double)) : NULL;
+    uint64_t *cursor = malloc((node_count ? node_count : 1) * sizeof(uint64_t));
+    if (!dst->offsets || !dst->targets || (src->weights && !dst->weights) || !cursor) {
+        free(cursor);
+        adj_free(dst);
+        memset(dst, 0, sizeof(*dst));
+        return false;
+    }
+
+    for (uint64_t u = 0; u < node_count; u++) {
+        uint64_t begin, end;
+        graph_adj_range(src, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++)
+            dst->offsets[src->targets[e] + 1]++;
+    }
+    for (size_t v = 0; v < node_count; v++)
+        dst->offsets[v + 1] += dst->offsets[v];
+    if (node_count)
+        memcpy(cursor, dst->offsets, node_count * sizeof(uint64_t));
+
+    for (uint64_t u = 0; u < node_count; u++) {
+        uint64_t begin, end;
+        graph_adj_range(src, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t slot = cursor[src->targets[e]]++;
+            dst->targets[slot] = u;
+            if (dst->weights)
+                dst->weights[slot] = src->weights[e];
+        }
+    }
+    free(cursor);
+    return true;
+}
+
+/*
+ * Returns the in-adjacency, building it on first use. Not safe to call
+ * for the first time concurrently on the same graph. Returns NULL for
+ * graphs without edges and on allocation failure (*ok set to false).
+ */
+static const fossil_graph_adj_t *graph_reverse(fossil_graph_t *graph, bool *ok)
+{
+    *ok = true;
+    if (!graph->csr)
+        return NULL;
+    if (!graph->directed)
+        return &graph->csr->out;
+    if (!graph->csr->in.offsets &&
+        !adj_transpose(graph->node_count, &graph->csr->out, &graph->csr->in)) {
+        *ok = false;
+        return NULL;
+    }
+    return &graph->csr->in;
+}
+
+static inline unsigned graph_bit_width(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return x ? 64u - (unsigned)__builtin_clzll(x) : 0u;
+#else
+    unsigned width = 0;
+    while (x) {
+        width++;
+        x >>= 1;
+    }
+    return width;
+#endif
+}
+
+// Read hint for data needed a few iterations later.
+static inline void graph_prefetch(const void *p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+// Index of the lowest set bit; x must be non-zero.
+static inline unsigned graph_ctz(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(x);
+#else
+    unsigned n = 0;
+    while (!(x & 1u)) {
+        n++;
+        x >>= 1;
+    }
+    return n;
+#endif
+}
+
+static inline bool graph_bit_test(const uint64_t *bits, uint64_t i)
+{
+    return (bits[i >> 6] >> (i & 63)) & 1u;
+}
+
+static inline void graph_bit_set(uint64_t *bits, uint64_t i)
+{
+    bits[i >> 6] |= (uint64_t)1 << (i & 63);
+}
+
+static inline size_t graph_bit_words(size_t n)
+{
+    return (n + 63) / 64;
+}
+
+// Walks pred[] back from target and reports the path start -> target.
+static int
+graph_visit_path(
+    const uint64_t *pred,
+    uint64_t start,
+    uint64_t target,
+    fossil_graph_visit_fn visit,
+    void *user
+) {
+    size_t length = 1;
+    for (uint64_t v = target; v != start; v = pred[v])
+        length++;
+
+    uint64_t *path = malloc(length * sizeof(uint64_t));
+    if (!path)
+        return -1;
+
+    size_t i = length;
+    for (uint64_t v = target; v != start; v = pred[v])
+        path[--i] = v;
+    path[0] = start;
+
+    for (i = 0; i < length; i++)
+        if (!visit(path[i], user))
+            break;
+
+    free(path);
+    return 0;
+}
+
+// Copies the pred[] chain start -> target into path (if given).
+static void
+graph_write_path(
+    const uint64_t *pred,
+    uint64_t start,
+    uint64_t target,
+    uint64_t *path,
+    size_t *path_length
+) {
+    size_t length = 1;
+    for (uint64_t v = target; v != start; v = pred[v])
+        length++;
+
+    if (path) {
+        size_t i = length;
+        for (uint64_t v = target; v != start; v = pred[v])
+            path[--i] = v;
+        path[0] = start;
+    }
+    if (path_length)
+        *path_length = length;
+}
+
+static int graph_u64_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Whole numbers in [0, 2^53] are exact as uint64_t distances.
+static inline bool graph_weight_integral(double w)
+{
+    return w >= 0.0 && w <= 9007199254740992.0 && w == (double)(uint64_t)w;
+}
+
+// Order-preserving map from doubles to unsigned keys and back.
+static inline uint64_t graph_weight_key(double w)
+{
+    uint64_t bits;
+    memcpy(&bits, &w, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | ((uint64_t)1 << 63);
+}
+
+static inline double graph_key_weight(uint64_t key)
+{
+    uint64_t bits = (key >> 63) ? key & ~((uint64_t)1 << 63) : ~key;
+    double w;
+    memcpy(&w, &bits, sizeof(w));
+    return w;
+}
+
+// ======================================================
+// Parallel Runtime
+// ======================================================
+
+/*
+ * Minimal portable layer for the parallel algorithms: relaxed 64-bit
+ * atomics and a fork-join thread pool. Compilers without a known atomic
+ * intrinsic fall back to plain operations and a single thread.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define GRAPH_HAVE_ATOMICS 1
+
+static inline uint64_t graph_atomic_load(const volatile uint64_t *p)
+{
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+
+static inline void graph_atomic_store(volatile uint64_t *p, uint64_t v)
+{
+    __atomic_store_n(p, v, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t graph_atomic_add(volatile uint64_t *p, uint64_t v)
+{
+    return __atomic_fetch_add(p, v, __ATOMIC_RELAXED);
+}
+
+static inline void graph_atomic_or(volatile uint64_t *p, uint64_t v)
+{
+    __atomic_fetch_or(p, v, __ATOMIC_RELAXED);
+}
+
+static inline bool graph_atomic_cas(volatile uint64_t *p, uint64_t expected, uint64_t desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+#elif defined(_MSC_VER)
+#define GRAPH_HAVE_ATOMICS 1
+
+static inline uint64_t graph_atomic_load(const volatile uint64_t *p)
+{
+    return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)p, 0, 0);
+}
+
+static inline void graph_atomic_store(volatile uint64_t *p, uint64_t v)
+{
+    InterlockedExchange64((volatile LONG64 *)p, (LONG64)v);
+}
+
+static inline uint64_t graph_atomic_add(volatile uint64_t *p, uint64_t v)
+{
+    return (uint64_t)InterlockedExchangeAdd64((volatile LONG64 *)p, (LONG64)v);
+}
+
+static inline void graph_atomic_or(volatile uint64_t *p, uint64_t v)
+{
+    InterlockedOr64((volatile LONG64 *)p, (LONG64)v);
+}
+
+static inline bool graph_atomic_cas(volatile uint64_t *p, uint64_t expected, uint64_t desired)
+{
+    return InterlockedCompareExchange64((volatile LONG64 *)p, (LONG64)desired,
+                                        (LONG64)expected) == (LONG64)expected;
+}
+#else
+#define GRAPH_HAVE_ATOMICS 0
+
+static inline uint64_t graph_atomic_load(const volatile uint64_t *p)
+{
+    return *p;
+}
+
+static inline void graph_atomic_store(volatile uint64_t *p, uint64_t v)
+{
+    *p = v;
+}
+
+static inline uint64_t graph_atomic_add(volatile uint64_t *p, uint64_t v)
+{
+    uint64_t old = *p;
+    *p = old + v;
+    return old;
+}
+
+static inline void graph_atomic_or(volatile uint64_t *p, uint64_t v)
+{
+    *p |= v;
+}
+
+static inline bool graph_atomic_cas(volatile uint64_t *p, uint64_t expected, uint64_t desired)
+{
+    if (*p != expected)
+        return false;
+    *p = desired;
+    return true;
+}
+#endif
+
+// Requested worker count; 0 selects the hardware concurrency.
+static size_t graph_thread_setting = 0;
+
+static size_t graph_hardware_threads(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (size_t)info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+#else
+    return 1;
+#endif
+}
+
+static size_t graph_thread_count(void)
+{
+    if (!GRAPH_HAVE_ATOMICS)
+        return 1;
+    return graph_thread_setting ? graph_thread_setting : graph_hardware_threads();
+}
+
+/*
+ * Task signature: every thread of the pool (the caller is tid 0) runs
+ * the same task and typically claims work with graph_claim().
+ */
+typedef void (*graph_task_fn)(void *ctx, size_t tid, size_t threads);
+
+typedef struct graph_pool graph_pool_t;
+
+typedef struct graph_worker {
+    graph_pool_t *pool;
+    size_t tid;
+} graph_worker_t;
+
+struct graph_pool {
+    size_t threads;            // including the calling thread
+    graph_task_fn task;
+    void *ctx;
+    uint64_t generation;
+    size_t running;
+    bool stop;
+    graph_worker_t *workers;
+#if defined(_WIN32)
+    HANDLE *handles;
+    CRITICAL_SECTION lock;
+    CONDITION_VARIABLE wake;
+    CONDITION_VARIABLE done;
+#else
+    pthread_t *handles;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+#endif
+};
+
+#if defined(_WIN32)
+#define GRAPH_LOCK(p)        EnterCriticalSection(&(p)->lock)
+#define GRAPH_UNLOCK(p)      LeaveCriticalSection(&(p)->lock)
+#define GRAPH_WAIT(p, cv)    SleepConditionVariableCS(&(p)->cv, &(p)->lock, INFINITE)
+#define GRAPH_SIGNAL(p, cv)  WakeConditionVariable(&(p)->cv)
+#define GRAPH_BROADCAST(p, cv) WakeAllConditionVariable(&(p)->cv)
+#else
+#define GRAPH_LOCK(p)        pthread_mutex_lock(&(p)->lock)
+#define GRAPH_UNLOCK(p)      pthread_mutex_unlock(&(p)->lock)
+#define GRAPH_WAIT(p, cv)    pthread_cond_wait(&(p)->cv, &(p)->lock)
+#define GRAPH_SIGNAL(p, cv)  pthread_cond_signal(&(p)->cv)
+#define GRAPH_BROADCAST(p, cv) pthread_cond_broadcast(&(p)->cv)
+#endif
+
+static void graph_worker_loop(graph_worker_t *worker)
+{
+    graph_pool_t *pool = worker->pool;
+    uint64_t seen = 0;
+
+    GRAPH_LOCK(pool);
+    for (;;) {
+        while (!pool->stop && pool->generation == seen)
+            GRAPH_WAIT(pool, wake);
+        if (pool->stop)
+            break;
+        seen = pool->generation;
+
+        graph_task_fn task = pool->task;
+        void *ctx = pool->ctx;
+        GRAPH_UNLOCK(pool);
+
+        task(ctx, worker->tid, pool->threads);
+
+        GRAPH_LOCK(pool);
+        if (--pool->running == 0)
+            GRAPH_SIGNAL(pool, done);
+    }
+    GRAPH_UNLOCK(pool);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI graph_worker_main(LPVOID arg)
+{
+    graph_worker_loop((graph_worker_t *)arg);
+    return 0;
+}
+#else
+static void *graph_worker_main(void *arg)
+{
+    graph_worker_loop((graph_worker_t *)arg);
+    return NULL;
+}
+#endif
+
+static void graph_pool_destroy(graph_pool_t *pool)
+{
+    if (!pool) return;
+
+    GRAPH_LOCK(pool);
+    pool->stop = true;
+    GRAPH_BROADCAST(pool, wake);
+    GRAPH_UNLOCK(pool);
+
+    for (size_t i = 1; i < pool->threads; i++) {
+#if defined(_WIN32)
+        WaitForSingleObject(pool->handles[i], INFINITE);
+        CloseHandle(pool->handles[i]);
+#else
+        pthread_join(pool->handles[i], NULL);
+#endif
+    }
+
+#if defined(_WIN32)
+    DeleteCriticalSection(&pool->lock);
+#else
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->done);
+#endif
+    free(pool->handles);
+    free(pool->workers);
+    free(pool);
+}
+
+/*
+ * Starts threads - 1 workers. Returns NULL when one thread is enough or
+ * nothing could be started; graph_pool_run then executes inline. If only
+ * some workers start, the pool simply runs with fewer threads.
+ */
+static graph_pool_t *graph_pool_create(size_t threads)
+{
+    if (threads <= 1)
+        return NULL;
+
+    graph_pool_t *pool = calloc(1, sizeof(*pool));
+    if (!pool)
+        return NULL;
+    pool->handles = calloc(threads, sizeof(*pool->handles));
+    pool->workers = calloc(threads, sizeof(*pool->workers));
+    if (!pool->handles || !pool->workers) {
+        free(pool->handles);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+
+#if defined(_WIN32)
+    InitializeCriticalSection(&pool->lock);
+    InitializeConditionVariable(&pool->wake);
+    InitializeConditionVariable(&pool->done);
+#else
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+#endif
+
+    pool->threads = 1;
+    for (size_t i = 1; i < threads; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].tid = i;
+#if defined(_WIN32)
+        pool->handles[i] = CreateThread(NULL, 0, graph_worker_main, &pool->workers[i], 0, NULL);
+        if (!pool->handles[i])
+            break;
+#else
+        if (pthread_create(&pool->handles[i], NULL, graph_worker_main, &pool->workers[i]) != 0)
+            break;
+#endif
+        pool->threads++;
+    }
+
+    if (pool->threads == 1) {
+        graph_pool_destroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+// Runs task on every pool thread and waits for all of them.
+static void graph_pool_run(graph_pool_t *pool, graph_task_fn task, void *ctx)
+{
+    if (!pool) {
+        task(ctx, 0, 1);
+        return;
+    }
+
+    GRAPH_LOCK(pool);
+    pool->task = task;
+    pool->ctx = ctx;
+    pool->running = pool->threads - 1;
+    pool->generation++;
+    GRAPH_BROADCAST(pool, wake);
+    GRAPH_UNLOCK(pool);
+
+    task(ctx, 0, pool->threads);
+
+    GRAPH_LOCK(pool);
+    while (pool->running > 0)
+        GRAPH_WAIT(pool, done);
+    GRAPH_UNLOCK(pool);
+}
+
+static inline size_t graph_pool_threads(const graph_pool_t *pool)
+{
+    return pool ? pool->threads : 1;
+}
+
+// Claims the next chunk of [0, total) from a shared cursor.
+static inline bool
+graph_claim(
+    volatile uint64_t *cursor,
+    uint64_t total,
+    uint64_t chunk,
+    uint64_t *begin,
+    uint64_t *end
+) {
+    uint64_t first = graph_atomic_add(cursor, chunk);
+    if (first >= total)
+        return false;
+    *begin = first;
+    *end = total - first > chunk ? first + chunk : total;
+    return true;
+}
+
+// Lowers *p to v; true when this call changed it.
+static inline bool graph_atomic_min(volatile uint64_t *p, uint64_t v)
+{
+    uint64_t current = graph_atomic_load(p);
+    while (v < current) {
+        if (graph_atomic_cas(p, current, v))
+            return true;
+        current = graph_atomic_load(p);
+    }
+    return false;
+}
+
+// ======================================================
+// File Mapping
+// ======================================================
+
+/*
+ * Binary graph files are a 64-byte header followed by raw arrays in
+ * host byte order, each padded to a 64-byte boundary. Loaders map the
+ * file read-only and point straight into it, so nothing is parsed or
+ * copied at startup.
+ */
+#define GRAPH_FILE_ALIGN 64
+#define GRAPH_FILE_ORDER UINT64_C(0x0102030405060708)
+
+static inline size_t graph_file_align(size_t bytes)
+{
+    return (bytes + GRAPH_FILE_ALIGN - 1) & ~(size_t)(GRAPH_FILE_ALIGN - 1);
+}
+
+// Writes bytes of data followed by zero padding up to the alignment.
+static bool graph_file_section(FILE *file, const void *data, size_t bytes)
+{
+    static const unsigned char zero[GRAPH_FILE_ALIGN];
+    size_t pad = graph_file_align(bytes) - bytes;
+    return (bytes == 0 || fwrite(data, 1, bytes, file) == bytes) &&
+           (pad == 0 || fwrite(zero, 1, pad, file) == pad);
+}
+
+static bool graph_file_map(const char *path, void **base, size_t *size)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length) || length.QuadPart <= 0 ||
+        (uint64_t)length.QuadPart > SIZE_MAX) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The view keeps the mapping alive after both handles are closed
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void *view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (mapping)
+        CloseHandle(mapping);
+    CloseHandle(file);
+    if (!view)
+        return false;
+
+    *base = view;
+    *size = (size_t)length.QuadPart;
+    return true;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0 ||
+        (uint64_t)info.st_size > SIZE_MAX) {
+        close(fd);
+        return false;
+    }
+
+    void *view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+        return false;
+
+    *base = view;
+    *size = (size_t)info.st_size;
+    return true;
+#endif
+}
+
+static void graph_file_unmap(void *base, size_t size)
+{
+#if defined(_WIN32)
+    (void)size;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, size);
+#endif
+}
+
+// ======================================================
+// Compressed Adjacency
+// ======================================================
+
+/*
+ * Compressed graphs store every out-list sorted, as LEB128 varints: the
+ * first target as a zig-zag offset from its source, the rest as gaps to
+ * the previous target. Gaps between nearby ids take one byte, so graphs
+ * reordered for locality shrink the most. Lists are decoded
+ * sequentially while they are walked; only traversals and weak
+ * components accept compressed graphs.
+ */
+static inline bool graph_packed(const fossil_graph_t *graph)
+{
+    return graph->csr && graph->csr->packed.bytes;
+}
+
+static inline size_t graph_varint_size(uint64_t x)
+{
+    size_t size = 1;
+    while (x >= 0x80) {
+        x >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static inline unsigned char *graph_varint_put(unsigned char *p, uint64_t x)
+{
+    while (x >= 0x80) {
+        *p++ = (unsigned char)(x | 0x80);
+        x >>= 7;
+    }
+    *p++ = (unsigned char)x;
+    return p;
+}
+
+static inline const unsigned char *graph_varint_get(const unsigned char *p, uint64_t *x)
+{
+    if (*p < 0x80) {
+        *x = *p;
+        return p + 1;
+    }
+
+    uint64_t value = 0;
+    unsigned shift = 0;
+    unsigned char byte;
+    do {
+        byte = *p++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    *x = value;
+    return p;
+}
+
+// First target as a zig-zag offset from the source node.
+static inline uint64_t graph_packed_first(uint64_t source, uint64_t target)
+{
+    return target >= source ? (target - source) << 1 : ((source - target) << 1) - 1;
+}
+
+typedef struct graph_packed_cursor {
+    const unsigned char *at;
+    const unsigned char *end;
+    uint64_t             last;    // previous target, the source before the first
+    bool                 first;
+} graph_packed_cursor_t;
+
+static inline void
+graph_packed_open(
+    const fossil_graph_packed_t *packed,
+    uint64_t v,
+    graph_packed_cursor_t *cursor
+) {
+    cursor->at = packed->bytes + packed->offsets[v];
+    cursor->end = packed->bytes + packed->offsets[v + 1];
+    cursor->last = v;
+    cursor->first = true;
+}
+
+static inline bool graph_packed_next(graph_packed_cursor_t *cursor, uint64_t *target)
+{
+    if (cursor->at == cursor->end)
+        return false;
+
+    uint64_t x;
+    cursor->at = graph_varint_get(cursor->at, &x);
+    if (cursor->first) {
+        cursor->last = (x & 1) ? cursor->last - (x >> 1) - 1 : cursor->last + (x >> 1);
+        cursor->first = false;
+    } else {
+        cursor->last += x;
+    }
+    *target = cursor->last;
+    return true;
+}
+
+typedef struct graph_pack_ctx {
+    const fossil_graph_adj_t *out;
+    size_t         node_count;
+    size_t         max_degree;
+    uint64_t      *scratch;    // max_degree entries per thread
+    uint64_t      *offsets;
+    unsigned char *bytes;      // NULL while sizing
+    uint64_t       cursor;
+} graph_pack_ctx_t;
+
+/*
+ * Sorts each list in thread-local scratch, then either records its
+ * encoded size in offsets[v + 1] or encodes it at offsets[v].
+ */
+static void graph_pack_lists(void *arg, size_t tid, size_t threads)
+{
+    graph_pack_ctx_t *ctx = arg;
+    uint64_t *list = ctx->scratch + tid * ctx->max_degree;
+    uint64_t first, last;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 256, &first, &last)) {
+        for (uint64_t v = first; v < last; v++) {
+            uint64_t begin, end;
+            graph_adj_range(ctx->out, v, &begin, &end);
+            size_t degree = (size_t)(end - begin);
+            if (degree == 0) {
+                if (!ctx->bytes)
+                    ctx->offsets[v + 1] = 0;
+                continue;
+            }
+
+            memcpy(list, ctx->out->targets + begin, degree * sizeof(uint64_t));
+            bool sorted = true;
+            for (size_t i = 1; sorted && i < degree; i++)
+                sorted = list[i - 1] <= list[i];
+            if (!sorted)
+                qsort(list, degree, sizeof(uint64_t), graph_u64_compare);
+
+            if (ctx->bytes) {
+                unsigned char *p = ctx->bytes + ctx->offsets[v];
+                p = graph_varint_put(p, graph_packed_first(v, list[0]));
+                for (size_t i = 1; i < degree; i++)
+                    p = graph_varint_put(p, list[i] - list[i - 1]);
+            } else {
+                uint64_t size = graph_varint_size(graph_packed_first(v, list[0]));
+                for (size_t i = 1; i < degree; i++)
+                    size += graph_varint_size(list[i] - list[i - 1]);
+                ctx->offsets[v + 1] = size;
+            }
+        }
+    }
+}
+
+static int graph_compress(fossil_graph_t *graph)
+{
+    fossil_graph_csr_t *csr = graph->csr;
+    size_t n = graph->node_count;
+
+    graph_pack_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = &csr->out;
+    ctx.node_count = n;
+    for (uint64_t v = 0; v < n; v++) {
+        uint64_t begin, end;
+        graph_adj_range(&csr->out, v, &begin, &end);
+        uint64_t degree = end - begin;
+        if (degree > ctx.max_degree)
+            ctx.max_degree = (size_t)degree;
+    }
+
+    graph_pool_t *pool = graph_pool_create(graph_thread_count());
+    size_t scratch = graph_pool_threads(pool) * ctx.max_degree;
+    ctx.scratch = malloc((scratch ? scratch : 1) * sizeof(uint64_t));
+    ctx.offsets = malloc((n + 1) * sizeof(uint64_t));
+    int result = ctx.scratch && ctx.offsets ? 0 : -1;
+
+    if (result == 0) {
+        ctx.offsets[0] = 0;
+        graph_pool_run(pool, graph_pack_lists, &ctx);
+        for (size_t v = 0; v < n; v++)
+            ctx.offsets[v + 1] += ctx.offsets[v];
+
+        ctx.bytes = malloc(ctx.offsets[n] ? (size_t)ctx.offsets[n] : 1);
+        if (ctx.bytes) {
+            ctx.cursor = 0;
+            graph_pool_run(pool, graph_pack_lists, &ctx);
+        } else {
+            result = -1;
+        }
+    }
+    graph_pool_destroy(pool);
+    free(ctx.scratch);
+
+    if (result != 0) {
+        free(ctx.offsets);
+        free(ctx.bytes);
+        return result;
+    }
+
+    csr_release(csr);
+    csr->packed.offsets = ctx.offsets;
+    csr->packed.bytes = ctx.bytes;
+    return 0;
+}
+
+// ======================================================
+// Dynamic Updates
+// ======================================================
+
+/*
+ * Batched edge updates on a slack CSR. A batch is split into arc
+ * updates and sorted by source, so each list is touched by exactly one
+ * thread: deletes swap the last live arc into the hole, inserts append
+ * into the slack. Lists move only when a batch overflows some node's
+ * capacity; the relayout then leaves half the new size as slack, so
+ * moves stay amortized O(1) per inserted arc.
+ */
+#define GRAPH_SLACK_MIN   4
+#define GRAPH_SLACK_CHUNK 1024
+
+typedef struct graph_update {
+    uint64_t from;
+    uint64_t to;
+    double   weight;
+    uint64_t order;     // batch position; deletes come before inserts
+} graph_update_t;
+
+static int graph_update_compare(const void *a, const void *b)
+{
+    const graph_update_t *x = a, *y = b;
+    if (x->from != y->from)
+        return (x->from > y->from) - (x->from < y->from);
+    return (x->order > y->order) - (x->order < y->order);
+}
+
+typedef struct graph_slack_ctx {
+    const fossil_graph_adj_t *from;
+    fossil_graph_adj_t *to;
+    const graph_update_t *updates;
+    const uint64_t *groups;       // group_count + 1 starts into updates
+    size_t   group_count;
+    size_t   node_count;
+    uint64_t delete_count;        // orders below this are deletes
+    uint64_t cursor;
+    uint64_t added;
+    uint64_t removed;
+    uint64_t negative;            // signed deltas, two's complement
+    uint64_t fractional;
+} graph_slack_ctx_t;
+
+static inline void graph_slack_count(double w, uint64_t *negative, uint64_t *fractional, uint64_t sign)
+{
+    if (w < 0.0)
+        *negative += sign;
+    if (!graph_weight_integral(w))
+        *fractional += sign;
+}
+
+// Copies each list of from to the start of its new range in to.
+static void graph_slack_copy(void *arg, size_t tid, size_t threads)
+{
+    graph_slack_ctx_t *ctx = arg;
+    uint64_t negative = 0, fractional = 0, first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, GRAPH_SLACK_CHUNK, &first, &last)) {
+        for (uint64_t v = first; v < last; v++) {
+            uint64_t begin, end, slot = ctx->to->offsets[v];
+            graph_adj_range(ctx->from, v, &begin, &end);
+            if (end > begin) {
+                memcpy(ctx->to->targets + slot, ctx->from->targets + begin, (end - begin) * sizeof(uint64_t));
+                if (ctx->to->weights)
+                    memcpy(ctx->to->weights + slot, ctx->from->weights + begin, (end - begin) * sizeof(double));
+            }
+            for (uint64_t e = begin; ctx->to->weights && e < end; e++)
+                graph_slack_count(ctx->from->weights[e], &negative, &fractional, 1);
+            if (ctx->to->ends)
+                ctx->to->ends[v] = slot + (end - begin);
+        }
+    }
+    graph_atomic_add(&ctx->negative, negative);
+    graph_atomic_add(&ctx->fractional, fractional);
+}
+
+// Fills to with the lists of from, leaving room for pending[v] more arcs.
+static bool
+graph_slack_move(
+    const fossil_graph_adj_t *from,
+    fossil_graph_adj_t *to,
+    size_t n,
+    const uint64_t *pending,
+    bool slack,
+    bool weighted,
+    graph_pool_t *pool,
+    graph_slack_ctx_t *ctx
+) {
+    memset(to, 0, sizeof(*to));
+    to->offsets = malloc((n + 1) * sizeof(uint64_t));
+    to->ends = slack ? malloc((n ? n : 1) * sizeof(uint64_t)) : NULL;
+    if (!to->offsets || (slack && !to->ends)) {
+        adj_free(to);
+        return false;
+    }
+
+    to->offsets[0] = 0;
+    for (uint64_t v = 0; v < n; v++) {
+        uint64_t need = graph_adj_degree(from, v) + (pending ? pending[v] : 0);
+        to->offsets[v + 1] = to->offsets[v] + (slack ? need + need / 2 + GRAPH_SLACK_MIN : need);
+    }
+    size_t total = (size_t)to->offsets[n];
+    to->targets = malloc((total ? total : 1) * sizeof(uint64_t));
+    to->weights = weighted ? malloc((total ? total : 1) * sizeof(double)) : NULL;
+    if (!to->targets || (weighted && !to->weights)) {
+        adj_free(to);
+        return false;
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->from = from;
+    ctx->to = to;
+    ctx->node_count = n;
+    graph_pool_run(pool, graph_slack_copy, ctx);
+    return true;
+}
+
+/*
+ * Moves every list into a fresh layout with room for pending[v] more
+ * arcs plus slack, or packs them back to plain CSR when slack is false.
+ * A built in-adjacency moves along (pending_in); any file view is
+ * dropped. The graph is left untouched on failure.
+ */
+static bool
+graph_slack_layout(
+    fossil_graph_t *graph,
+    graph_pool_t *pool,
+    const uint64_t *pending,
+    const uint64_t *pending_in,
+    bool slack
+) {
+    fossil_graph_csr_t *csr = graph->csr;
+    size_t n = graph->node_count;
+    bool reverse = graph->directed && csr->in.offsets;
+
+    graph_slack_ctx_t ctx, ignored;
+    fossil_graph_adj_t out, in;
+    memset(&in, 0, sizeof(in));
+    if (!graph_slack_move(&csr->out, &out, n, pending, slack, graph->weighted, pool, &ctx))
+        return false;
+    if (reverse && !graph_slack_move(&csr->in, &in, n, pending_in, slack, graph->weighted, pool, &ignored)) {
+        adj_free(&out);
+        return false;
+    }
+
+    csr_release(csr);
+    csr->out = out;
+    csr->in = in;
+    csr->negative_arcs = ctx.negative;
+    csr->fractional_arcs = ctx.fractional;
+    return true;
+}
+
+// Applies the claimed source groups; every group owns one list.
+static void graph_update_apply(void *arg, size_t tid, size_t threads)
+{
+    graph_slack_ctx_t *ctx = arg;
+    fossil_graph_adj_t *out = ctx->to;
+    uint64_t added = 0, removed = 0, negative = 0, fractional = 0, first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->group_count, 64, &first, &last)) {
+        for (uint64_t g = first; g < last; g++) {
+            uint64_t v = ctx->updates[ctx->groups[g]].from;
+            uint64_t begin = out->offsets[v], end = out->ends[v];
+            for (uint64_t i = ctx->groups[g]; i < ctx->groups[g + 1]; i++) {
+                const graph_update_t *u = &ctx->updates[i];
+                if (u->order >= ctx->delete_count) {
+                    out->targets[end] = u->to;
+                    if (out->weights) {
+                        out->weights[end] = u->weight;
+                        graph_slack_count(u->weight, &negative, &fractional, 1);
+                    }
+                    end++;
+                    added++;
+                    continue;
+                }
+
+                uint64_t e = begin;
+                while (e < end && (out->targets[e] != u->to || (out->weights && out->weights[e] != u->weight)))
+                    e++;
+                if (e == end)
+                    continue;
+                end--;
+                if (out->weights) {
+                    graph_slack_count(out->weights[e], &negative, &fractional, UINT64_MAX);
+                    out->weights[e] = out->weights[end];
+                }
+                out->targets[e] = out->targets[end];
+                removed++;
+            }
+            out->ends[v] = end;
+        }
+    }
+    graph_atomic_add(&ctx->added, added);
+    graph_atomic_add(&ctx->removed, removed);
+    graph_atomic_add(&ctx->negative, negative);
+    graph_atomic_add(&ctx->fractional, fractional);
+}
+
+// Arc updates of one adjacency side, grouped by list.
+typedef struct graph_update_batch {
+    graph_update_t *updates;
+    uint64_t *groups;             // group_count + 1 starts into updates
+    uint64_t *pending;            // inserts per node
+    size_t    count;
+    size_t    group_count;
+} graph_update_batch_t;
+
+static void graph_update_batch_free(graph_update_batch_t *batch)
+{
+    free(batch->updates);
+    free(batch->groups);
+    free(batch->pending);
+}
+
+/*
+ * Expands the batch into arcs (undirected edges both ways, self-loops
+ * once; reversed arcs for the in side), sorts them by list and groups
+ * them.
+ */
+static bool
+graph_update_batch_init(
+    graph_update_batch_t *batch,
+    const fossil_graph_t *graph,
+    const fossil_graph_edge_t *inserts,
+    size_t insert_count,
+    const fossil_graph_edge_t *deletes,
+    size_t delete_count,
+    bool reverse
+) {
+    size_t n = graph->node_count;
+    size_t total = (insert_count + delete_count) * (graph->directed ? 1 : 2);
+    memset(batch, 0, sizeof(*batch));
+    batch->updates = malloc((total ? total : 1) * sizeof(*batch->updates));
+    batch->groups = malloc((total + 1) * sizeof(uint64_t));
+    batch->pending = calloc(n ? n : 1, sizeof(uint64_t));
+    if (!batch->updates || !batch->groups || !batch->pending) {
+        graph_update_batch_free(batch);
+        return false;
+    }
+
+    for (size_t i = 0; i < delete_count + insert_count; i++) {
+        const fossil_graph_edge_t *edge = i < delete_count ? &deletes[i] : &inserts[i - delete_count];
+        graph_update_t u = { edge->from, edge->to, edge->weight, i };
+        if (reverse) {
+            u.from = edge->to;
+            u.to = edge->from;
+        }
+        batch->updates[batch->count++] = u;
+        if (!graph->directed && u.from != u.to) {
+            u.from = edge->to;
+            u.to = edge->from;
+            batch->updates[batch->count++] = u;
+        }
+    }
+    qsort(batch->updates, batch->count, sizeof(*batch->updates), graph_update_compare);
+
+    for (size_t i = 0; i < batch->count; i++) {
+        uint64_t v = batch->updates[i].from;
+        if (i == 0 || batch->updates[i - 1].from != v)
+            batch->groups[batch->group_count++] = i;
+        if (batch->updates[i].order >= delete_count)
+            batch->pending[v]++;
+    }
+    batch->groups[batch->group_count] = batch->count;
+    return true;
+}
+
+// True when every list of adj has room for its pending inserts.
+static bool graph_update_fits(const fossil_graph_adj_t *adj, const graph_update_batch_t *batch)
+{
+    if (!adj->ends)
+        return false;
+    for (size_t g = 0; g < batch->group_count; g++) {
+        uint64_t v = batch->updates[batch->groups[g]].from;
+        if (graph_adj_degree(adj, v) + batch->pending[v] > adj->offsets[v + 1] - adj->offsets[v])
+            return false;
+    }
+    return true;
+}
+
+static void
+graph_update_run(
+    graph_pool_t *pool,
+    fossil_graph_adj_t *adj,
+    const graph_update_batch_t *batch,
+    size_t delete_count,
+    graph_slack_ctx_t *ctx
+) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->to = adj;
+    ctx->updates = batch->updates;
+    ctx->groups = batch->groups;
+    ctx->group_count = batch->group_count;
+    ctx->delete_count = delete_count;
+    graph_pool_run(pool, graph_update_apply, ctx);
+}
+
+static int
+graph_update(
+    fossil_graph_t *graph,
+    const fossil_graph_edge_t *inserts,
+    size_t insert_count,
+    const fossil_graph_edge_t *deletes,
+    size_t delete_count
+) {
+    fossil_graph_csr_t *csr = graph->csr;
+    bool reverse = graph->directed && csr->in.offsets;
+
+    graph_update_batch_t out, in;
+    memset(&in, 0, sizeof(in));
+    if (!graph_update_batch_init(&out, graph, inserts, insert_count, deletes, delete_count, false))
+        return -1;
+    if (reverse && !graph_update_batch_init(&in, graph, inserts, insert_count, deletes, delete_count, true)) {
+        graph_update_batch_free(&out);
+        return -1;
+    }
+
+    graph_pool_t *pool = graph_pool_create(graph_thread_count());
+    bool fits = graph_update_fits(&csr->out, &out) && (!reverse || graph_update_fits(&csr->in, &in));
+    int result = 0;
+    if (!fits && !graph_slack_layout(graph, pool, out.pending, in.pending, true))
+        result = -1;
+
+    if (result == 0) {
+        graph_slack_ctx_t ctx, ignored;
+        graph_update_run(pool, &csr->out, &out, delete_count, &ctx);
+        if (reverse)
+            graph_update_run(pool, &csr->in, &in, delete_count, &ignored);
+
+        csr->edge_count = csr->edge_count + (size_t)ctx.added - (size_t)ctx.removed;
+        csr->negative_arcs += ctx.negative;
+        csr->fractional_arcs += ctx.fractional;
+        csr->negative = csr->negative_arcs != 0;
+        csr->integral = csr->fractional_arcs == 0;
+    }
+    graph_pool_destroy(pool);
+    graph_update_batch_free(&out);
+    graph_update_batch_free(&in);
+    return result;
+}
+
+// ======================================================
+// Priority Queues
+// ======================================================
+
+#define GRAPH_HEAP_NONE UINT64_MAX
+
+typedef struct graph_heap_entry {
+    double   key;
+    uint64_t node;
+} graph_heap_entry_t;
+
+/*
+ * Indexed 4-ary min-heap with decrease-key. The wider fan-out halves
+ * the height of a binary heap and keeps the children of a slot within
+ * one or two cache lines.
+ */
+typedef struct graph_heap {
+    graph_heap_entry_t *data;
+    uint64_t *pos;       // node -> heap slot, GRAPH_HEAP_NONE when absent
+    size_t size;
+} graph_heap_t;
+
+static bool graph_heap_init(graph_heap_t *heap, size_t node_count)
+{
+    heap->data = malloc(node_count * sizeof(*heap->data));
+    heap->pos = malloc(node_count * sizeof(*heap->pos));
+    heap->size = 0;
+    if (!heap->data || !heap->pos) {
+        free(heap->data);
+        free(heap->pos);
+        return false;
+    }
+    memset(heap->pos, 0xFF, node_count * sizeof(*heap->pos));
+    return true;
+}
+
+static void graph_heap_free(graph_heap_t *heap)
+{
+    free(heap->data);
+    free(heap->pos);
+}
+
+static void graph_heap_sift_up(graph_heap_t *heap, size_t i)
+{
+    graph_heap_entry_t item = heap->data[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / 4;
+        if (heap->data[parent].key <= item.key)
+            break;
+        heap->data[i] = heap->data[parent];
+        heap->pos[heap->data[i].node] = i;
+        i = parent;
+    }
+    heap->data[i] = item;
+    heap->pos[item.node] = i;
+}
+
+static void graph_heap_sift_down(graph_heap_t *heap, size_t i)
+{
+    graph_heap_entry_t item = heap->data[i];
+    for (;;) {
+        size_t first = 4 * i + 1;
+        if (first >= heap->size)
+            break;
+        size_t last = first + 4 < heap->size ? first + 4 : heap->size;
+        size_t best = first;
+        for (size_t c = first + 1; c < last; c++)
+            if (heap->data[c].key < heap->data[best].key)
+                best = c;
+        if (heap->data[best].key >= item.key)
+            break;
+        heap->data[i] = heap->data[best];
+        heap->pos[heap->data[i].node] = i;
+        i = best;
+    }
+    heap->data[i] = item;
+    heap->pos[item.node] = i;
+}
+
+// Inserts node with key, or lowers its key if already queued.
+static void graph_heap_push(graph_heap_t *heap, uint64_t node, double key)
+{
+    uint64_t slot = heap->pos[node];
+    if (slot == GRAPH_HEAP_NONE) {
+        slot = heap->size++;
+        heap->data[slot].node = node;
+        heap->data[slot].key = key;
+        graph_heap_sift_up(heap, slot);
+    } else if (key < heap->data[slot].key) {
+        heap->data[slot].key = key;
+        graph_heap_sift_up(heap, slot);
+    }
+}
+
+// Empties the heap in O(size) instead of resetting every position.
+static void graph_heap_clear(graph_heap_t *heap)
+{
+    for (size_t i = 0; i < heap->size; i++)
+        heap->pos[heap->data[i].node] = GRAPH_HEAP_NONE;
+    heap->size = 0;
+}
+
+static uint64_t graph_heap_pop(graph_heap_t *heap, double *key)
+{
+    graph_heap_entry_t top = heap->data[0];
+    heap->pos[top.node] = GRAPH_HEAP_NONE;
+    if (--heap->size > 0) {
+        heap->data[0] = heap->data[heap->size];
+        graph_heap_sift_down(heap, 0);
+    }
+    *key = top.key;
+    return top.node;
+}
+
+typedef struct graph_radix_item {
+    uint64_t key;
+    uint64_t node;
+} graph_radix_item_t;
+
+/*
+ * Monotone radix heap for integer keys. Bucket i holds keys whose
+ * highest bit differing from the last extracted minimum is bit i - 1,
+ * so every key moves down at most 64 times over its lifetime.
+ * Decrease-key is lazy: stale entries are skipped by the consumer.
+ */
+typedef struct graph_radix_heap {
+    graph_radix_item_t *bucket[65];
+    size_t size[65];
+    size_t capacity[65];
+    uint64_t last;
+    size_t count;
+} graph_radix_heap_t;
+
+static void graph_radix_free(graph_radix_heap_t *heap)
+{
+    for (size_t i = 0; i < 65; i++)
+        free(heap->bucket[i]);
+}
+
+static bool graph_radix_push(graph_radix_heap_t *heap, uint64_t node, uint64_t key)
+{
+    unsigned b = key == heap->last ? 0 : graph_bit_width(key ^ heap->last);
+    if (heap->size[b] == heap->capacity[b]) {
+        size_t capacity = heap->capacity[b] ? heap->capacity[b] * 2 : 16;
+        graph_radix_item_t *grown = realloc(heap->bucket[b], capacity * sizeof(*grown));
+        if (!grown)
+            return false;
+        heap->bucket[b] = grown;
+        heap->capacity[b] = capacity;
+    }
+    heap->bucket[b][heap->size[b]].key = key;
+    heap->bucket[b][heap->size[b]].node = node;
+    heap->size[b]++;
+    heap->count++;
+    return true;
+}
+
+static bool graph_radix_pop(graph_radix_heap_t *heap, graph_radix_item_t *out)
+{
+    if (heap->size[0] == 0) {
+        size_t i = 1;
+        while (heap->size[i] == 0)
+            i++;
+
+        uint64_t min = heap->bucket[i][0].key;
+        for (size_t j = 1; j < heap->size[i]; j++)
+            if (heap->bucket[i][j].key < min)
+                min = heap->bucket[i][j].key;
+        heap->last = min;
+
+        // Every item of bucket i moves to a strictly lower bucket
+        size_t moved = heap->size[i];
+        heap->size[i] = 0;
+        heap->count -= moved;
+        for (size_t j = 0; j < moved; j++) {
+            graph_radix_item_t item = heap->bucket[i][j];
+            if (!graph_radix_push(heap, item.node, item.key))
+                return false;
+        }
+    }
+    heap->count--;
+    *out = heap->bucket[0][--heap->size[0]];
+    return true;
+}
+
+// ======================================================
+// BFS
+// ======================================================
+
+static int
+graph_bfs(
+    fossil_graph_t *graph,
+    uint64_t start,
+    fossil_graph_visit_fn visit,
+    void *user
+) {
+    if (!graph || start >= graph->node_count)
+        return -2;
+
+    if (graph->node_count == 0)
+        return -2;
+
+    uint64_t *visited = calloc(graph_bit_words(graph->node_count), sizeof(uint64_t));
+    if (!visited)
+        return -1;
+
+    uint64_t *queue = malloc(graph->node_count * sizeof(uint64_t));
+    if (!queue) {
+        free(visited);
+        return -1;
+    }
+
+    size_t head = 0, tail = 0;
+    graph_bit_set(visited, start);
+    queue[tail++] = start;
+
+    while (head < tail) {
+        uint64_t v = queue[head++];
+
+        if (visit && !visit(v, user))
+            break;
+
+        if (graph_packed(graph)) {
+            graph_packed_cursor_t cursor;
+            uint64_t to;
+            graph_packed_open(&graph->csr->packed, v, &cursor);
+            while (graph_packed_next(&cursor, &to)) {
+                if (!graph_bit_test(visited, to)) {
+                    graph_bit_set(visited, to);
+                    queue[tail++] = to;
+                }
+            }
+            continue;
+        }
+
+        uint64_t begin, end;
+        graph_edge_range(graph, v, &begin, &end);
+
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t to = graph->csr->out.targets[e];
+            if (!graph_bit_test(visited, to)) {
+                graph_bit_set(visited, to);
+                queue[tail++] = to;
+            }
+        }
+    }
+
+    free(queue);
+    free(visited);
+    return 0;
+}
+
+/*
+ * Direction-optimizing BFS (Beamer et al.). Top-down steps expand the
+ * frontier queue and claim children with a CAS on parent[]; bottom-up
+ * steps let every unvisited node scan its in-edges for a parent in the
+ * frontier bitmap and stop at the first hit. Bottom-up work is split by
+ * 64-node bitmap words, so each thread owns the words it writes.
+ */
+#define GRAPH_BFS_ALPHA 15
+#define GRAPH_BFS_BETA  18
+#define GRAPH_BFS_BATCH 256
+
+typedef struct graph_bfs_ctx {
+    const fossil_graph_adj_t *out;
+    const fossil_graph_adj_t *in;
+    const fossil_graph_packed_t *packed;   // compressed graphs: top-down only
+    size_t   node_count;
+    uint64_t *parent;
+    uint64_t *level;        // optional
+    uint64_t *visited;      // bitmap
+    uint64_t *front_bits;   // bottom-up frontier
+    uint64_t *next_bits;
+    uint64_t *queue;        // top-down frontier
+    uint64_t *next_queue;
+    uint64_t queue_size;
+    uint64_t next_size;
+    uint64_t depth;
+    uint64_t cursor;
+    uint64_t awake;         // nodes discovered by the current step
+    uint64_t scout;         // out-degree sum of those nodes
+} graph_bfs_ctx_t;
+
+// Claims w for parent v; found nodes are flushed to next_queue in batches.
+static inline void
+graph_bfs_discover(
+    graph_bfs_ctx_t *ctx,
+    uint64_t v,
+    uint64_t w,
+    uint64_t *local,
+    size_t *local_count,
+    uint64_t *awake,
+    uint64_t *scout
+) {
+    uint64_t mask = (uint64_t)1 << (w & 63);
+    if (graph_atomic_load(&ctx->visited[w >> 6]) & mask)
+        return;
+    if (!graph_atomic_cas(&ctx->parent[w], FOSSIL_GRAPH_NO_NODE, v))
+        return;
+
+    graph_atomic_or(&ctx->visited[w >> 6], mask);
+    if (ctx->level)
+        ctx->level[w] = ctx->depth + 1;
+    (*awake)++;
+    *scout += graph_adj_degree(ctx->out, w);
+
+    local[(*local_count)++] = w;
+    if (*local_count == GRAPH_BFS_BATCH) {
+        uint64_t slot = graph_atomic_add(&ctx->next_size, *local_count);
+        memcpy(ctx->next_queue + slot, local, *local_count * sizeof(uint64_t));
+        *local_count = 0;
+    }
+}
+
+static void graph_bfs_top_down(void *arg, size_t tid, size_t threads)
+{
+    graph_bfs_ctx_t *ctx = arg;
+    uint64_t local[GRAPH_BFS_BATCH];
+    size_t local_count = 0;
+    uint64_t awake = 0, scout = 0;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->queue_size, 64, &first, &last)) {
+        for (uint64_t i = first; i < last; i++) {
+            uint64_t v = ctx->queue[i];
+            if (ctx->packed) {
+                graph_packed_cursor_t cursor;
+                uint64_t w;
+                graph_packed_open(ctx->packed, v, &cursor);
+                while (graph_packed_next(&cursor, &w))
+                    graph_bfs_discover(ctx, v, w, local, &local_count, &awake, &scout);
+                continue;
+            }
+
+            uint64_t begin, end;
+            graph_adj_range(ctx->out, v, &begin, &end);
+            for (uint64_t e = begin; e < end; e++)
+                graph_bfs_discover(ctx, v, ctx->out->targets[e], local, &local_count, &awake, &scout);
+        }
+    }
+
+    if (local_count) {
+        uint64_t slot = graph_atomic_add(&ctx->next_size, local_count);
+        memcpy(ctx->next_queue + slot, local, local_count * sizeof(uint64_t));
+    }
+    graph_atomic_add(&ctx->awake, awake);
+    graph_atomic_add(&ctx->scout, scout);
+}
+
+static void graph_bfs_bottom_up(void *arg, size_t tid, size_t threads)
+{
+    graph_bfs_ctx_t *ctx = arg;
+    uint64_t words = graph_bit_words(ctx->node_count);
+    uint64_t awake = 0, scout = 0;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, words, 16, &first, &last)) {
+        for (uint64_t word = first; word < last; word++) {
+            uint64_t pending = ~ctx->visited[word];
+            uint64_t found = 0;
+
+            while (pending) {
+                unsigned bit = graph_ctz(pending);
+                pending &= pending - 1;
+                uint64_t v = word * 64 + bit;
+
+                uint64_t begin, end;
+                graph_adj_range(ctx->in, v, &begin, &end);
+                for (uint64_t e = begin; e < end; e++) {
+                    uint64_t u = ctx->in->targets[e];
+                    if (graph_bit_test(ctx->front_bits, u)) {
+                        ctx->parent[v] = u;
+                        if (ctx->level)
+                            ctx->level[v] = ctx->depth + 1;
+                        found |= (uint64_t)1 << bit;
+                        awake++;
+                        scout += graph_adj_degree(ctx->out, v);
+                        break;
+                    }
+                }
+            }
+
+            ctx->next_bits[word] = found;
+            ctx->visited[word] |= found;
+        }
+    }
+
+    graph_atomic_add(&ctx->awake, awake);
+    graph_atomic_add(&ctx->scout, scout);
+}
+
+static void graph_bfs_step(graph_pool_t *pool, graph_bfs_ctx_t *ctx, graph_task_fn step)
+{
+    ctx->cursor = 0;
+    ctx->awake = 0;
+    ctx->scout = 0;
+    graph_pool_run(pool, step, ctx);
+    ctx->depth++;
+}
+
+static int
+graph_bfs_direction_optimizing(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t *level,
+    uint64_t *parent
+) {
+    size_t n = graph->node_count;
+    size_t words = graph_bit_words(n);
+    bool ok;
+
+    graph_bfs_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = graph_out(graph);
+    ok = true;
+    if (graph_packed(graph))
+        ctx.packed = &graph->csr->packed;
+    else
+        ctx.in = graph_reverse(graph, &ok);
+    ctx.node_count = n;
+    ctx.parent = parent;
+    ctx.level = level;
+    ctx.visited = calloc(words, sizeof(uint64_t));
+    ctx.front_bits = calloc(words, sizeof(uint64_t));
+    ctx.next_bits = calloc(words, sizeof(uint64_t));
+    ctx.queue = malloc(n * sizeof(uint64_t));
+    ctx.next_queue = malloc(n * sizeof(uint64_t));
+
+    int result = 0;
+    if (!ok || !ctx.visited || !ctx.front_bits || !ctx.next_bits || !ctx.queue || !ctx.next_queue)
+        result = -1;
+
+    graph_pool_t *pool = NULL;
+    if (result == 0)
+        pool = graph_pool_create(graph_thread_count());
+
+    if (result == 0) {
+        for (size_t i = 0; i < n; i++) {
+            parent[i] = FOSSIL_GRAPH_NO_NODE;
+            if (level)
+                level[i] = FOSSIL_GRAPH_NO_NODE;
+        }
+        // Bits past the last node count as visited so they are never scanned
+        if (n % 64)
+            ctx.visited[words - 1] = ~(uint64_t)0 << (n % 64);
+
+        parent[start] = start;
+        if (level)
+            level[start] = 0;
+        graph_bit_set(ctx.visited, start);
+        ctx.queue[0] = start;
+        ctx.queue_size = 1;
+
+        uint64_t edges_to_check = graph->csr ? graph->csr->edge_count : 0;
+        uint64_t scout = graph_adj_degree(ctx.out, start);
+
+        while (ctx.queue_size > 0) {
+            if (!ctx.packed && scout > edges_to_check / GRAPH_BFS_ALPHA) {
+                memset(ctx.front_bits, 0, words * sizeof(uint64_t));
+                for (uint64_t i = 0; i < ctx.queue_size; i++)
+                    graph_bit_set(ctx.front_bits, ctx.queue[i]);
+
+                uint64_t awake = ctx.queue_size, previous;
+                do {
+                    previous = awake;
+                    graph_bfs_step(pool, &ctx, graph_bfs_bottom_up);
+                    awake = ctx.awake;
+                    uint64_t *swap = ctx.front_bits;
+                    ctx.front_bits = ctx.next_bits;
+                    ctx.next_bits = swap;
+                } while (awake >= previous || awake > n / GRAPH_BFS_BETA);
+
+                ctx.queue_size = 0;
+                for (size_t word = 0; word < words; word++) {
+                    uint64_t bits = ctx.front_bits[word];
+                    while (bits) {
+                        ctx.queue[ctx.queue_size++] = word * 64 + graph_ctz(bits);
+                        bits &= bits - 1;
+                    }
+                }
+                scout = 1;
+            } else {
+                edges_to_check -= scout < edges_to_check ? scout : edges_to_check;
+                ctx.next_size = 0;
+                graph_bfs_step(pool, &ctx, graph_bfs_top_down);
+                scout = ctx.scout;
+
+                uint64_t *swap = ctx.queue;
+                ctx.queue = ctx.next_queue;
+                ctx.next_queue = swap;
+                ctx.queue_size = ctx.next_size;
+            }
+        }
+        parent[start] = FOSSIL_GRAPH_NO_NODE;
+    }
+
+    graph_pool_destroy(pool);
+    free(ctx.visited);
+    free(ctx.front_bits);
+    free(ctx.next_bits);
+    free(ctx.queue);
+    free(ctx.next_queue);
+    return result;
+}
+
+// ======================================================
+// DFS
+// ======================================================
+
+/*
+ * Iterative DFS over an explicit stack of (node, next edge) frames, so
+ * depth is bounded by memory rather than the C call stack. Children are
+ * entered in adjacency order, giving the same pre-order as a recursive
+ * DFS. The time counter ticks once per discovery and once per finish.
+ */
+typedef struct graph_dfs_state {
+    bool     *visited;
+    uint64_t *stack_node;
+    uint64_t *stack_edge;
+    graph_packed_cursor_t *stack_cursor;   // compressed graphs only
+    uint64_t  clock;
+} graph_dfs_state_t;
+
+// Next unvisited child of the top frame, advancing its edge position.
+static inline bool
+graph_dfs_child(
+    const fossil_graph_t *graph,
+    graph_dfs_state_t *state,
+    size_t top,
+    uint64_t *child
+) {
+    if (state->stack_cursor) {
+        graph_packed_cursor_t *cursor = &state->stack_cursor[top];
+        while (graph_packed_next(cursor, child))
+            if (!state->visited[*child])
+                return true;
+        return false;
+    }
+
+    uint64_t begin, end;
+    graph_edge_range(graph, state->stack_node[top], &begin, &end);
+    uint64_t e = state->stack_edge[top];
+    while (e < end && state->visited[graph->csr->out.targets[e]])
+        e++;
+    if (e == end)
+        return false;
+    *child = graph->csr->out.targets[e];
+    state->stack_edge[top] = e + 1;
+    return true;
+}
+
+// Pushes a frame for v positioned at its first edge.
+static inline void
+graph_dfs_push(
+    const fossil_graph_t *graph,
+    graph_dfs_state_t *state,
+    size_t top,
+    uint64_t v
+) {
+    state->stack_node[top] = v;
+    if (state->stack_cursor) {
+        graph_packed_open(&graph->csr->packed, v, &state->stack_cursor[top]);
+    } else {
+        uint64_t begin, end;
+        graph_edge_range(graph, v, &begin, &end);
+        state->stack_edge[top] = begin;
+    }
+}
+
+static bool
+graph_dfs_tree(
+    const fossil_graph_t *graph,
+    graph_dfs_state_t *state,
+    uint64_t root,
+    fossil_graph_visit_fn pre,
+    fossil_graph_visit_fn post,
+    void *user,
+    uint64_t *discovery,
+    uint64_t *finish
+) {
+    size_t depth = 0;
+
+    state->visited[root] = true;
+    if (discovery)
+        discovery[root] = state->clock;
+    state->clock++;
+    if (pre && !pre(root, user))
+        return false;
+
+    graph_dfs_push(graph, state, 0, root);
+    depth = 1;
+
+    while (depth > 0) {
+        uint64_t v = state->stack_node[depth - 1];
+        uint64_t to;
+
+        if (graph_dfs_child(graph, state, depth - 1, &to)) {
+            state->visited[to] = true;
+            if (discovery)
+                discovery[to] = state->clock;
+            state->clock++;
+            if (pre && !pre(to, user))
+                return false;
+
+            graph_dfs_push(graph, state, depth, to);
+            depth++;
+        } else {
+            depth--;
+            if (finish)
+                finish[v] = state->clock;
+            state->clock++;
+            if (post && !post(v, user))
+                return false;
+        }
+    }
+    return true;
+}
+
+static int
+graph_dfs_run(
+    const fossil_graph_t *graph,
+    uint64_t start,
+    fossil_graph_visit_fn pre,
+    fossil_graph_visit_fn post,
+    void *user,
+    uint64_t *discovery,
+    uint64_t *finish
+) {
+    size_t n = graph->node_count;
+    graph_dfs_state_t state;
+    state.visited = calloc(n, sizeof(bool));
+    state.stack_node = malloc(n * sizeof(uint64_t));
+    state.stack_edge = NULL;
+    state.stack_cursor = NULL;
+    if (graph_packed(graph))
+        state.stack_cursor = malloc(n * sizeof(graph_packed_cursor_t));
+    else
+        state.stack_edge = malloc(n * sizeof(uint64_t));
+    state.clock = 0;
+    if (!state.visited || !state.stack_node || (!state.stack_edge && !state.stack_cursor)) {
+        free(state.visited);
+        free(state.stack_node);
+        free(state.stack_edge);
+        free(state.stack_cursor);
+        return -1;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (discovery) discovery[i] = FOSSIL_GRAPH_NO_NODE;
+        if (finish) finish[i] = FOSSIL_GRAPH_NO_NODE;
+    }
+
+    if (start != FOSSIL_GRAPH_NO_NODE) {
+        graph_dfs_tree(graph, &state, start, pre, post, user, discovery, finish);
+    } else {
+        for (uint64_t root = 0; root < n; root++) {
+            if (state.visited[root])
+                continue;
+            if (!graph_dfs_tree(graph, &state, root, pre, post, user, discovery, finish))
+                break;
+        }
+    }
+
+    free(state.visited);
+    free(state.stack_node);
+    free(state.stack_edge);
+    free(state.stack_cursor);
+    return 0;
+}
+
+static int
+graph_dfs(
+    fossil_graph_t *graph,
+    uint64_t start,
+    fossil_graph_visit_fn visit,
+    void *user
+) {
+    if (!graph || start >= graph->node_count)
+        return -2;
+
+    if (graph->node_count == 0)
+        return -2;
+
+    return graph_dfs_run(graph, start, visit, NULL, user, NULL, NULL);
+}
+
+// ======================================================
+// Dijkstra
+// ======================================================
+
+/*
+ * Heap-based Dijkstra. dist[] and pred[] must hold node_count entries.
+ * With a target, the search stops as soon as the target is settled, so
+ * only nodes settled before it carry final distances.
+ */
+static int
+graph_dijkstra(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    double *dist,
+    uint64_t *pred
+) {
+    size_t n = graph->node_count;
+    for (size_t i = 0; i < n; i++) {
+        dist[i] = DBL_MAX;
+        pred[i] = FOSSIL_GRAPH_NO_NODE;
+    }
+
+    graph_heap_t heap;
+    if (!graph_heap_init(&heap, n))
+        return -1;
+
+    dist[start] = 0.0;
+    graph_heap_push(&heap, start, 0.0);
+
+    while (heap.size > 0) {
+        double d;
+        uint64_t v = graph_heap_pop(&heap, &d);
+        if (v == target)
+            break;
+
+        uint64_t begin, end;
+        graph_edge_range(graph, v, &begin, &end);
+
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t to = graph->csr->out.targets[e];
+            double alt = d + graph->csr->out.weights[e];
+            if (alt < dist[to]) {
+                dist[to] = alt;
+                pred[to] = v;
+                graph_heap_push(&heap, to, alt);
+            }
+        }
+    }
+
+    graph_heap_free(&heap);
+
+    if (target == FOSSIL_GRAPH_NO_NODE)
+        return 0;
+    return (dist[target] == DBL_MAX) ? -1 : 0;
+}
+
+// Dijkstra over a radix heap; requires integral, non-negative weights.
+static int
+graph_dijkstra_radix(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    double *dist,
+    uint64_t *pred
+) {
+    size_t n = graph->node_count;
+    uint64_t *key = malloc(n * sizeof(uint64_t));
+    if (!key)
+        return -1;
+
+    for (size_t i = 0; i < n; i++) {
+        key[i] = UINT64_MAX;
+        pred[i] = FOSSIL_GRAPH_NO_NODE;
+    }
+
+    graph_radix_heap_t heap;
+    memset(&heap, 0, sizeof(heap));
+
+    int result = 0;
+    key[start] = 0;
+    if (!graph_radix_push(&heap, start, 0))
+        result = -1;
+
+    while (result == 0 && heap.count > 0) {
+        graph_radix_item_t item;
+        if (!graph_radix_pop(&heap, &item)) {
+            result = -1;
+            break;
+        }
+        uint64_t v = item.node;
+        if (item.key != key[v])
+            continue; // stale entry
+        if (v == target)
+            break;
+
+        uint64_t begin, end;
+        graph_edge_range(graph, v, &begin, &end);
+
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t to = graph->csr->out.targets[e];
+            uint64_t alt = item.key + (uint64_t)graph->csr->out.weights[e];
+            if (alt < key[to]) {
+                key[to] = alt;
+                pred[to] = v;
+                if (!graph_radix_push(&heap, to, alt)) {
+                    result = -1;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < n; i++)
+        dist[i] = key[i] == UINT64_MAX ? DBL_MAX : (double)key[i];
+
+    graph_radix_free(&heap);
+    free(key);
+
+    if (result != 0 || target == FOSSIL_GRAPH_NO_NODE)
+        return result;
+    return (dist[target] == DBL_MAX) ? -1 : 0;
+}
+
+// ======================================================
+// Bellman-Ford / SPFA
+// ======================================================
+
+static void graph_sssp_reset(size_t n, uint64_t start, double *dist, uint64_t *pred)
+{
+    for (size_t i = 0; i < n; i++) {
+        dist[i] = DBL_MAX;
+        pred[i] = FOSSIL_GRAPH_NO_NODE;
+    }
+    dist[start] = 0.0;
+}
+
+static int graph_sssp_result(const double *dist, uint64_t target)
+{
+    if (target == FOSSIL_GRAPH_NO_NODE)
+        return 0;
+    return (dist[target] == DBL_MAX) ? -1 : 0;
+}
+
+/*
+ * In-place Bellman-Ford. Rounds stop as soon as one makes no change;
+ * a change in round n proves a negative cycle reachable from start.
+ */
+static int
+graph_bellman_ford(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    double *dist,
+    uint64_t *pred
+) {
+    size_t n = graph->node_count;
+    graph_sssp_reset(n, start, dist, pred);
+
+    for (size_t round = 0; round < n; round++) {
+        bool changed = false;
+        for (uint64_t u = 0; u < n; u++) {
+            if (dist[u] == DBL_MAX)
+                continue;
+
+            uint64_t begin, end;
+            graph_edge_range(graph, u, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                uint64_t v = graph->csr->out.targets[e];
+                double alt = dist[u] + graph->csr->out.weights[e];
+                if (alt < dist[v]) {
+                    dist[v] = alt;
+                    pred[v] = u;
+                    changed = true;
+                }
+            }
+        }
+        if (!changed)
+            return graph_sssp_result(dist, target);
+    }
+    return -5;
+}
+
+/*
+ * Queue-based Bellman-Ford (SPFA): only nodes whose distance dropped are
+ * rescanned. hops[v] counts the edges on v's current path; reaching n
+ * edges means the path repeats a node, i.e. a negative cycle.
+ */
+static int
+graph_spfa(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    double *dist,
+    uint64_t *pred
+) {
+    size_t n = graph->node_count;
+    uint64_t *queue = malloc(n * sizeof(uint64_t));
+    uint64_t *hops = calloc(n, sizeof(uint64_t));
+    uint64_t *queued = calloc(graph_bit_words(n), sizeof(uint64_t));
+    if (!queue || !hops || !queued) {
+        free(queue);
+        free(hops);
+        free(queued);
+        return -1;
+    }
+
+    graph_sssp_reset(n, start, dist, pred);
+
+    // Circular queue: a node is queued at most once at any time
+    size_t head = 0, count = 1;
+    queue[0] = start;
+    graph_bit_set(queued, start);
+
+    int result = 0;
+    while (count > 0 && result == 0) {
+        uint64_t u = queue[head];
+        head = (head + 1) % n;
+        count--;
+        queued[u >> 6] &= ~((uint64_t)1 << (u & 63));
+
+        uint64_t begin, end;
+        graph_edge_range(graph, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t v = graph->csr->out.targets[e];
+            double alt = dist[u] + graph->csr->out.weights[e];
+            if (alt < dist[v]) {
+                dist[v] = alt;
+                pred[v] = u;
+                hops[v] = hops[u] + 1;
+                if (hops[v] >= n) {
+                    result = -5;
+                    break;
+                }
+                if (!graph_bit_test(queued, v)) {
+                    graph_bit_set(queued, v);
+                    queue[(head + count) % n] = v;
+                    count++;
+                }
+            }
+        }
+    }
+
+    free(queue);
+    free(hops);
+    free(queued);
+    return result == 0 ? graph_sssp_result(dist, target) : result;
+}
+
+/*
+ * Parallel Bellman-Ford as synchronous (Jacobi) rounds: every thread
+ * pulls over the in-edges of its own destination nodes, reading the
+ * previous round's distances. Each node has a single writer, so no
+ * atomics are needed and dist/pred never disagree.
+ */
+typedef struct graph_bf_ctx {
+    const fossil_graph_adj_t *in;
+    size_t node_count;
+    const double *dist_old;
+    double *dist_new;
+    uint64_t *pred;
+    uint64_t cursor;
+    uint64_t changed;
+} graph_bf_ctx_t;
+
+static void graph_bf_round(void *arg, size_t tid, size_t threads)
+{
+    graph_bf_ctx_t *ctx = arg;
+    uint64_t first, last, changed = 0;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 1024, &first, &last)) {
+        for (uint64_t v = first; v < last; v++) {
+            double best = ctx->dist_old[v];
+            uint64_t from = FOSSIL_GRAPH_NO_NODE;
+
+            uint64_t begin, end;
+            graph_adj_range(ctx->in, v, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                uint64_t u = ctx->in->targets[e];
+                if (ctx->dist_old[u] == DBL_MAX)
+                    continue;
+                double alt = ctx->dist_old[u] + ctx->in->weights[e];
+                if (alt < best) {
+                    best = alt;
+                    from = u;
+                }
+            }
+
+            ctx->dist_new[v] = best;
+            if (from != FOSSIL_GRAPH_NO_NODE) {
+                ctx->pred[v] = from;
+                changed++;
+            }
+        }
+    }
+    if (changed)
+        graph_atomic_add(&ctx->changed, changed);
+}
+
+static int
+graph_bellman_ford_parallel(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    double *dist,
+    uint64_t *pred
+) {
+    size_t n = graph->node_count;
+    bool ok;
+    const fossil_graph_adj_t *in = graph_reverse(graph, &ok);
+    double *scratch = malloc(n * sizeof(double));
+    if (!ok || !scratch) {
+        free(scratch);
+        return -1;
+    }
+
+    graph_sssp_reset(n, start, dist, pred);
+
+    graph_bf_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.in = in;
+    ctx.node_count = n;
+    ctx.pred = pred;
+
+    graph_pool_t *pool = graph_pool_create(graph_thread_count());
+    double *current = dist, *next = scratch;
+    int result = -5;
+
+    for (size_t round = 0; round < n; round++) {
+        ctx.dist_old = current;
+        ctx.dist_new = next;
+        ctx.cursor = 0;
+        ctx.changed = 0;
+        graph_pool_run(pool, graph_bf_round, &ctx);
+
+        double *swap = current;
+        current = next;
+        next = swap;
+
+        if (ctx.changed == 0) {
+            result = 0;
+            break;
+        }
+    }
+
+    graph_pool_destroy(pool);
+    if (current != dist)
+        memcpy(dist, current, n * sizeof(double));
+    free(scratch);
+    return result == 0 ? graph_sssp_result(dist, target) : result;
+}
+
+/*
+ * Finds a negative cycle with n rounds of Bellman-Ford. If an edge is
+ * still relaxed in round n, walking pred n steps back from its head is
+ * guaranteed to land on a negative cycle of the predecessor graph.
+ */
+static int
+graph_find_negative_cycle(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t *cycle,
+    size_t *cycle_length
+) {
+    size_t n = graph->node_count;
+    double *dist = malloc(n * sizeof(double));
+    uint64_t *pred = malloc(n * sizeof(uint64_t));
+    if (!dist || !pred) {
+        free(dist);
+        free(pred);
+        return -1;
+    }
+
+    // Without a start node every node acts as a source (virtual root)
+    if (start == FOSSIL_GRAPH_NO_NODE) {
+        for (size_t i = 0; i < n; i++) {
+            dist[i] = 0.0;
+            pred[i] = FOSSIL_GRAPH_NO_NODE;
+        }
+    } else {
+        graph_sssp_reset(n, start, dist, pred);
+    }
+
+    uint64_t last = FOSSIL_GRAPH_NO_NODE;
+    for (size_t round = 0; round < n; round++) {
+        last = FOSSIL_GRAPH_NO_NODE;
+        for (uint64_t u = 0; u < n; u++) {
+            if (dist[u] == DBL_MAX)
+                continue;
+
+            uint64_t begin, end;
+            graph_edge_range(graph, u, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                uint64_t v = graph->csr->out.targets[e];
+                double alt = dist[u] + graph->csr->out.weights[e];
+                if (alt < dist[v]) {
+                    dist[v] = alt;
+                    pred[v] = u;
+                    last = v;
+                }
+            }
+        }
+        if (last == FOSSIL_GRAPH_NO_NODE)
+            break;
+    }
+
+    *cycle_length = 0;
+    if (last != FOSSIL_GRAPH_NO_NODE) {
+        for (size_t i = 0; i < n; i++)
+            last = pred[last];
+
+        // pred points backwards along edges; fill the cycle from the end
+        size_t length = 1;
+        for (uint64_t v = pred[last]; v != last; v = pred[v])
+            length++;
+
+        size_t i = length;
+        uint64_t v = last;
+        do {
+            cycle[--i] = v;
+            v = pred[v];
+        } while (v != last);
+        *cycle_length = length;
+    }
+
+    free(dist);
+    free(pred);
+    return 0;
+}
+
+// ======================================================
+// Delta-Stepping
+// ======================================================
+
+/*
+ * Meyer-Sanders delta-stepping. Tentative distances are grouped into
+ * buckets of width delta. The lowest non-empty bucket is drained in
+ * parallel rounds that relax light arcs (w <= delta). After that, every
+ * node it settled relaxes its heavy arcs once. Distances are held as
+ * order-preserving keys, so a relaxation is an atomic min.
+ *
+ * Queued items carry the distance they were pushed with, so a round only
+ * reads values from earlier rounds. stamp[v] is the round of v's final
+ * decrease. pred is rebuilt at the end from tight in-arcs with an older
+ * stamp. That keeps the tree acyclic across zero-weight cycles and
+ * independent of thread timing.
+ */
+
+// Largest bucket window; delta is raised until max_weight fits in it.
+#define GRAPH_DELTA_WINDOW_MAX 65536
+
+// Requested bucket width; <= 0 selects it from the graph.
+static double graph_delta_setting = 0.0;
+
+typedef struct graph_delta_item {
+    uint64_t node;
+    double   dist;
+} graph_delta_item_t;
+
+typedef struct graph_delta_list {
+    graph_delta_item_t *data;
+    size_t size;
+    size_t capacity;
+} graph_delta_list_t;
+
+typedef struct graph_delta_local {
+    graph_delta_list_t *bins;       // window buckets, indexed modulo window
+    graph_delta_list_t  settled;    // items drained from the current bucket
+    bool                failed;     // allocation failure
+} graph_delta_local_t;
+
+typedef struct graph_delta_ctx {
+    const fossil_graph_adj_t *adj;
+    double                delta;
+    size_t                window;
+    uint64_t              bucket;
+    uint64_t              round;
+    volatile uint64_t    *key;
+    volatile uint64_t    *stamp;
+    graph_delta_local_t  *local;
+    size_t                threads;
+    graph_delta_item_t   *frontier;
+    size_t               *offset;       // per-thread gather position
+    bool                  from_settled; // gather settled lists, not bins
+    uint64_t              frontier_size;
+    uint64_t              cursor;
+} graph_delta_ctx_t;
+
+static inline uint64_t graph_delta_bucket(double dist, double delta)
+{
+    double q = dist / delta;
+    return q < 18446744073709549568.0 ? (uint64_t)q : UINT64_MAX;
+}
+
+static bool graph_delta_push(graph_delta_list_t *list, uint64_t node, double dist)
+{
+    if (list->size == list->capacity) {
+        size_t capacity = list->capacity ? 2 * list->capacity : 64;
+        graph_delta_item_t *data = realloc(list->data, capacity * sizeof(*data));
+        if (!data)
+            return false;
+        list->data = data;
+        list->capacity = capacity;
+    }
+    list->data[list->size].node = node;
+    list->data[list->size].dist = dist;
+    list->size++;
+    return true;
+}
+
+static inline graph_delta_list_t *graph_delta_source(graph_delta_ctx_t *ctx, size_t t)
+{
+    graph_delta_local_t *local = &ctx->local[t];
+    return ctx->from_settled ? &local->settled : &local->bins[ctx->bucket % ctx->window];
+}
+
+// Copies every thread's list into the shared frontier.
+static void graph_delta_gather(void *arg, size_t tid, size_t threads)
+{
+    graph_delta_ctx_t *ctx = arg;
+    for (size_t t = tid; t < ctx->threads; t += threads) {
+        graph_delta_list_t *list = graph_delta_source(ctx, t);
+        if (list->size)
+            memcpy(ctx->frontier + ctx->offset[t], list->data, list->size * sizeof(*list->data));
+        list->size = 0;
+    }
+}
+
+static void graph_delta_relax(void *arg, size_t tid, size_t threads)
+{
+    graph_delta_ctx_t *ctx = arg;
+    graph_delta_local_t *local = &ctx->local[tid];
+    const fossil_graph_adj_t *adj = ctx->adj;
+    bool heavy = ctx->from_settled;
+    uint64_t first, last;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->frontier_size, 256, &first, &last)) {
+        for (uint64_t i = first; i < last && !local->failed; i++) {
+            uint64_t u = ctx->frontier[i].node;
+            double d = ctx->frontier[i].dist;
+            if (graph_atomic_load(&ctx->key[u]) < graph_weight_key(d))
+                continue;
+            if (!heavy && !graph_delta_push(&local->settled, u, d)) {
+                local->failed = true;
+                break;
+            }
+
+            uint64_t begin, end;
+            graph_adj_range(adj, u, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                double w = adj->weights[e];
+                if ((w > ctx->delta) != heavy)
+                    continue;
+                uint64_t v = adj->targets[e];
+                double alt = d + w;
+                if (!graph_atomic_min(&ctx->key[v], graph_weight_key(alt)))
+                    continue;
+                graph_atomic_store(&ctx->stamp[v], ctx->round);
+                graph_delta_list_t *bin = &local->bins[graph_delta_bucket(alt, ctx->delta) % ctx->window];
+                if (!graph_delta_push(bin, v, alt)) {
+                    local->failed = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Fills the frontier from the current bucket (or the settled lists) and
+ * relaxes it in one round. Returns the number of items, or SIZE_MAX if
+ * the frontier could not grow.
+ */
+static size_t graph_delta_round(graph_delta_ctx_t *ctx, graph_pool_t *pool, size_t *capacity)
+{
+    size_t total = 0;
+    for (size_t t = 0; t < ctx->threads; t++) {
+        ctx->offset[t] = total;
+        total += graph_delta_source(ctx, t)->size;
+    }
+    if (total == 0)
+        return 0;
+
+    if (total > *capacity) {
+        graph_delta_item_t *frontier = realloc(ctx->frontier, total * sizeof(*frontier));
+        if (!frontier)
+            return SIZE_MAX;
+        ctx->frontier = frontier;
+        *capacity = total;
+    }
+
+    graph_pool_run(pool, graph_delta_gather, ctx);
+    ctx->frontier_size = total;
+    ctx->cursor = 0;
+    ctx->round++;
+    graph_pool_run(pool, graph_delta_relax, ctx);
+    return total;
+}
+
+// Items waiting in bucket + step across all threads.
+static size_t graph_delta_queued(const graph_delta_ctx_t *ctx, size_t step)
+{
+    size_t queued = 0;
+    for (size_t t = 0; t < ctx->threads; t++)
+        queued += ctx->local[t].bins[(ctx->bucket + step) % ctx->window].size;
+    return queued;
+}
+
+// Bucket width: the setting, else max_weight / average degree.
+static double graph_delta_width(const fossil_graph_t *graph, double *max_weight)
+{
+    const fossil_graph_adj_t *adj = graph_out(graph);
+    size_t arcs = graph->csr ? graph->csr->edge_count : 0;
+    double max = 0.0;
+    for (uint64_t u = 0; u < graph->node_count; u++) {
+        uint64_t begin, end;
+        graph_adj_range(adj, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++)
+            if (adj->weights[e] > max)
+                max = adj->weights[e];
+    }
+    *max_weight = max;
+
+    double delta = graph_delta_setting;
+    if (!(delta > 0.0)) {
+        double degree = (double)arcs / (double)graph->node_count;
+        delta = degree > 1.0 ? max / degree : max;
+    }
+    if (delta < max / (GRAPH_DELTA_WINDOW_MAX - 3))
+        delta = max / (GRAPH_DELTA_WINDOW_MAX - 3);
+    return delta > 0.0 ? delta : 1.0;
+}
+
+typedef struct graph_delta_pred_ctx {
+    const fossil_graph_adj_t *in;
+    size_t          node_count;
+    uint64_t        start;
+    const uint64_t *key;
+    const uint64_t *stamp;
+    uint64_t       *pred;
+    uint64_t        cursor;
+} graph_delta_pred_ctx_t;
+
+// pred[v] is the first in-neighbor that is tight and settled earlier.
+static void graph_delta_pred(void *arg, size_t tid, size_t threads)
+{
+    graph_delta_pred_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 1024, &first, &last)) {
+        for (uint64_t v = first; v < last; v++) {
+            ctx->pred[v] = FOSSIL_GRAPH_NO_NODE;
+            if (v == ctx->start || ctx->key[v] == UINT64_MAX)
+                continue;
+
+            double dv = graph_key_weight(ctx->key[v]);
+            uint64_t begin, end;
+            graph_adj_range(ctx->in, v, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                uint64_t u = ctx->in->targets[e];
+                if (ctx->key[u] != UINT64_MAX && ctx->stamp[u] < ctx->stamp[v] &&
+                    graph_key_weight(ctx->key[u]) + ctx->in->weights[e] == dv) {
+                    ctx->pred[v] = u;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static int
+graph_delta_stepping(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    double *dist,
+    uint64_t *pred
+) {
+    size_t n = graph->node_count;
+    double max_weight;
+    double delta = graph_delta_width(graph, &max_weight);
+    size_t window = (size_t)(max_weight / delta) + 3;
+
+    bool ok;
+    const fossil_graph_adj_t *in = graph_reverse(graph, &ok);
+    graph_pool_t *pool = graph_pool_create(graph_thread_count());
+    size_t threads = graph_pool_threads(pool);
+
+    graph_delta_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.adj = graph_out(graph);
+    ctx.delta = delta;
+    ctx.window = window;
+    ctx.threads = threads;
+    ctx.key = malloc(n * sizeof(uint64_t));
+    ctx.stamp = calloc(n, sizeof(uint64_t));
+    ctx.local = calloc(threads, sizeof(graph_delta_local_t));
+    ctx.offset = malloc(threads * sizeof(size_t));
+    ok = ok && ctx.key && ctx.stamp && ctx.local && ctx.offset;
+    for (size_t t = 0; ok && t < threads; t++) {
+        ctx.local[t].bins = calloc(window, sizeof(graph_delta_list_t));
+        ok = ctx.local[t].bins != NULL;
+    }
+
+    size_t capacity = 0;
+    if (ok) {
+        for (size_t v = 0; v < n; v++)
+            ctx.key[v] = UINT64_MAX;
+        ctx.key[start] = graph_weight_key(0.0);
+        ok = graph_delta_push(&ctx.local[0].bins[0], start, 0.0);
+    }
+
+    while (ok) {
+        // Drain the bucket over light arcs, then relax what it settled over
+        // heavy arcs; a heavy arc that rounds into this bucket repeats both
+        do {
+            size_t items;
+            ctx.from_settled = false;
+            while ((items = graph_delta_round(&ctx, pool, &capacity)) != 0 && items != SIZE_MAX)
+                ;
+            ctx.from_settled = true;
+            if (items != SIZE_MAX)
+                items = graph_delta_round(&ctx, pool, &capacity);
+            ok = items != SIZE_MAX;
+            for (size_t t = 0; t < threads; t++)
+                ok = ok && !ctx.local[t].failed;
+        } while (ok && graph_delta_queued(&ctx, 0) > 0);
+        if (!ok)
+            break;
+
+        if (target != FOSSIL_GRAPH_NO_NODE && ctx.key[target] != UINT64_MAX &&
+            graph_delta_bucket(graph_key_weight(ctx.key[target]), delta) <= ctx.bucket)
+            break;
+
+        size_t step = 1;
+        while (step < window && graph_delta_queued(&ctx, step) == 0)
+            step++;
+        if (step == window)
+            break;
+        ctx.bucket += step;
+    }
+
+    if (ok) {
+        // After an early exit only buckets up to the current one are final
+        bool cut = target != FOSSIL_GRAPH_NO_NODE;
+        for (size_t v = 0; cut && v < n; v++)
+            if (ctx.key[v] != UINT64_MAX &&
+                graph_delta_bucket(graph_key_weight(ctx.key[v]), delta) > ctx.bucket)
+                ctx.key[v] = UINT64_MAX;
+
+        graph_delta_pred_ctx_t pctx;
+        pctx.in = in;
+        pctx.node_count = n;
+        pctx.start = start;
+        pctx.key = (const uint64_t *)ctx.key;
+        pctx.stamp = (const uint64_t *)ctx.stamp;
+        pctx.pred = pred;
+        pctx.cursor = 0;
+        graph_pool_run(pool, graph_delta_pred, &pctx);
+
+        for (size_t v = 0; v < n; v++)
+            dist[v] = ctx.key[v] == UINT64_MAX ? DBL_MAX : graph_key_weight(ctx.key[v]);
+    }
+
+    for (size_t t = 0; ctx.local && t < threads; t++) {
+        for (size_t b = 0; ctx.local[t].bins && b < window; b++)
+            free(ctx.local[t].bins[b].data);
+        free(ctx.local[t].bins);
+        free(ctx.local[t].settled.data);
+    }
+    graph_pool_destroy(pool);
+    free((void *)ctx.key);
+    free((void *)ctx.stamp);
+    free(ctx.local);
+    free(ctx.offset);
+    free(ctx.frontier);
+    if (!ok)
+        return -1;
+    return graph_sssp_result(dist, target);
+}
+
+// ======================================================
+// Floyd-Warshall
+// ======================================================
+
+/*
+ * Cache-blocked Floyd-Warshall. For every diagonal tile kb the tile
+ * itself is closed first, then the tiles of row/column kb, then all
+ * remaining tiles; phases 2 and 3 only depend on earlier phases, so
+ * their tiles run in parallel. Inside a tile the update is a min-plus
+ * row kernel: c[j] = min(c[j], a + b[j]). Without next hops this is
+ * the whole algorithm; see graph_fw_hops for the tracked variant.
+ */
+#define GRAPH_FW_TILE 64
+
+// Element-wise, so c and b may be the same row (i == k).
+static void graph_fw_row_f64(double *c, const double *b, double a, size_t len)
+{
+    size_t j = 0;
+#if defined(GRAPH_SIMD_AVX)
+    __m256d va = _mm256_set1_pd(a);
+    for (; j + 4 <= len; j += 4) {
+        __m256d sum = _mm256_add_pd(va, _mm256_loadu_pd(b + j));
+        _mm256_storeu_pd(c + j, _mm256_min_pd(sum, _mm256_loadu_pd(c + j)));
+    }
+#elif defined(GRAPH_SIMD_SSE2)
+    __m128d va = _mm_set1_pd(a);
+    for (; j + 2 <= len; j += 2) {
+        __m128d sum = _mm_add_pd(va, _mm_loadu_pd(b + j));
+        _mm_storeu_pd(c + j, _mm_min_pd(sum, _mm_loadu_pd(c + j)));
+    }
+#elif defined(GRAPH_SIMD_NEON)
+    float64x2_t va = vdupq_n_f64(a);
+    for (; j + 2 <= len; j += 2) {
+        float64x2_t sum = vaddq_f64(va, vld1q_f64(b + j));
+        vst1q_f64(c + j, vminq_f64(sum, vld1q_f64(c + j)));
+    }
+#endif
+    for (; j < len; j++) {
+        double sum = a + b[j];
+        if (sum < c[j])
+            c[j] = sum;
+    }
+}
+
+static void graph_fw_row_f32(float *c, const float *b, float a, size_t len)
+{
+    size_t j = 0;
+#if defined(GRAPH_SIMD_AVX)
+    __m256 va = _mm256_set1_ps(a);
+    for (; j + 8 <= len; j += 8) {
+        __m256 sum = _mm256_add_ps(va, _mm256_loadu_ps(b + j));
+        _mm256_storeu_ps(c + j, _mm256_min_ps(sum, _mm256_loadu_ps(c + j)));
+    }
+#elif defined(GRAPH_SIMD_SSE2)
+    __m128 va = _mm_set1_ps(a);
+    for (; j + 4 <= len; j += 4) {
+        __m128 sum = _mm_add_ps(va, _mm_loadu_ps(b + j));
+        _mm_storeu_ps(c + j, _mm_min_ps(sum, _mm_loadu_ps(c + j)));
+    }
+#elif defined(GRAPH_SIMD_NEON)
+    float32x4_t va = vdupq_n_f32(a);
+    for (; j + 4 <= len; j += 4) {
+        float32x4_t sum = vaddq_f32(va, vld1q_f32(b + j));
+        vst1q_f32(c + j, vminq_f32(sum, vld1q_f32(c + j)));
+    }
+#endif
+    for (; j < len; j++) {
+        float sum = a + b[j];
+        if (sum < c[j])
+            c[j] = sum;
+    }
+}
+
+typedef struct graph_fw_ctx {
+    void     *dist;
+    uint64_t *next;       // optional next-hop matrix
+    size_t    n;
+    size_t    blocks;
+    bool      f32;
+    size_t    kb;
+    uint64_t  cursor;
+} graph_fw_ctx_t;
+
+static void graph_fw_tile(const graph_fw_ctx_t *ctx, size_t ib, size_t jb)
+{
+    size_t n = ctx->n;
+    size_t i0 = ib * GRAPH_FW_TILE, i1 = i0 + GRAPH_FW_TILE < n ? i0 + GRAPH_FW_TILE : n;
+    size_t j0 = jb * GRAPH_FW_TILE, j1 = j0 + GRAPH_FW_TILE < n ? j0 + GRAPH_FW_TILE : n;
+    size_t k0 = ctx->kb * GRAPH_FW_TILE, k1 = k0 + GRAPH_FW_TILE < n ? k0 + GRAPH_FW_TILE : n;
+
+    for (size_t k = k0; k < k1; k++) {
+        for (size_t i = i0; i < i1; i++) {
+            if (ctx->f32) {
+                float *d = ctx->dist;
+                float a = d[i * n + k];
+                if (a != FLT_MAX)
+                    graph_fw_row_f32(d + i * n + j0, d + k * n + j0, a, j1 - j0);
+            } else {
+                double *d = ctx->dist;
+                double a = d[i * n + k];
+                if (a != DBL_MAX)
+                    graph_fw_row_f64(d + i * n + j0, d + k * n + j0, a, j1 - j0);
+            }
+        }
+    }
+}
+
+// Phase 2: tiles of block row kb and block column kb.
+static void graph_fw_cross(void *arg, size_t tid, size_t threads)
+{
+    graph_fw_ctx_t *ctx = arg;
+    uint64_t others = ctx->blocks - 1;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, 2 * others, 1, &first, &last)) {
+        uint64_t t = first % others;
+        size_t b = t < ctx->kb ? t : t + 1;
+        if (first < others)
+            graph_fw_tile(ctx, ctx->kb, b);
+        else
+            graph_fw_tile(ctx, b, ctx->kb);
+    }
+}
+
+// Phase 3: every tile outside block row and column kb.
+static void graph_fw_rest(void *arg, size_t tid, size_t threads)
+{
+    graph_fw_ctx_t *ctx = arg;
+    uint64_t others = ctx->blocks - 1;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, others * others, 1, &first, &last)) {
+        size_t ib = first / others, jb = first % others;
+        graph_fw_tile(ctx, ib < ctx->kb ? ib : ib + 1, jb < ctx->kb ? jb : jb + 1);
+    }
+}
+
+/*
+ * Next-hop tracking keeps the classic pivot order (one pivot at a time,
+ * rows in parallel). Tiles see pivot rows that are already closed over
+ * the whole block, which is fine for distances but can link hops into
+ * a loop along zero-weight cycles.
+ */
+static void graph_fw_hops(void *arg, size_t tid, size_t threads)
+{
+    graph_fw_ctx_t *ctx = arg;
+    size_t n = ctx->n, k = ctx->kb;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    // Row k only changes on a negative cycle, so it is left alone
+    while (graph_claim(&ctx->cursor, n, 64, &first, &last)) {
+        for (size_t i = first; i < last; i++) {
+            if (i == k)
+                continue;
+            uint64_t hop = ctx->next[i * n + k];
+            uint64_t *row = ctx->next + i * n;
+            if (ctx->f32) {
+                float *d = ctx->dist;
+                float a = d[i * n + k];
+                if (a == FLT_MAX)
+                    continue;
+                for (size_t j = 0; j < n; j++) {
+                    float sum = a + d[k * n + j];
+                    if (sum < d[i * n + j]) {
+                        d[i * n + j] = sum;
+                        row[j] = hop;
+                    }
+                }
+            } else {
+                double *d = ctx->dist;
+                double a = d[i * n + k];
+                if (a == DBL_MAX)
+                    continue;
+                for (size_t j = 0; j < n; j++) {
+                    double sum = a + d[k * n + j];
+                    if (sum < d[i * n + j]) {
+                        d[i * n + j] = sum;
+                        row[j] = hop;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static int
+graph_floyd_warshall(
+    void *dist,
+    size_t n,
+    bool f32,
+    uint64_t *next
+) {
+    graph_fw_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.dist = dist;
+    ctx.next = next;
+    ctx.n = n;
+    ctx.blocks = (n + GRAPH_FW_TILE - 1) / GRAPH_FW_TILE;
+    ctx.f32 = f32;
+
+    graph_pool_t *pool = ctx.blocks > 1 ? graph_pool_create(graph_thread_count()) : NULL;
+
+    if (next) {
+        for (ctx.kb = 0; ctx.kb < n; ctx.kb++) {
+            ctx.cursor = 0;
+            graph_pool_run(pool, graph_fw_hops, &ctx);
+        }
+    } else {
+        for (ctx.kb = 0; ctx.kb < ctx.blocks; ctx.kb++) {
+            graph_fw_tile(&ctx, ctx.kb, ctx.kb);
+            if (ctx.blocks == 1)
+                break;
+            ctx.cursor = 0;
+            graph_pool_run(pool, graph_fw_cross, &ctx);
+            ctx.cursor = 0;
+            graph_pool_run(pool, graph_fw_rest, &ctx);
+        }
+    }
+    graph_pool_destroy(pool);
+
+    for (size_t i = 0; i < n; i++) {
+        if (f32 ? ((float *)dist)[i * n + i] < 0.0f : ((double *)dist)[i * n + i] < 0.0)
+            return -5;
+    }
+    return 0;
+}
+
+// Fills next-hop entries for the direct edges encoded in dist.
+static void graph_fw_init_next(const void *dist, size_t n, bool f32, uint64_t *next)
+{
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            bool edge = f32 ? ((const float *)dist)[i * n + j] != FLT_MAX
+                            : ((const double *)dist)[i * n + j] != DBL_MAX;
+            next[i * n + j] = (i == j || edge) ? j : FOSSIL_GRAPH_NO_NODE;
+        }
+    }
+}
+
+static int graph_fw_type(const char *type_id, bool *f32)
+{
+    if (algorithm_equals(type_id, "f32")) {
+        *f32 = true;
+        return 0;
+    }
+    if (algorithm_equals(type_id, "f64")) {
+        *f32 = false;
+        return 0;
+    }
+    return -3;
+}
+
+// All-pairs run for the exec interface; the path comes from next hops.
+static int
+graph_exec_floyd_warshall(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    fossil_graph_visit_fn visit,
+    void *user
+) {
+    size_t n = graph->node_count;
+    if (n > SIZE_MAX / n / sizeof(double))
+        return -1;
+
+    double *dist = malloc(n * n * sizeof(double));
+    uint64_t *next = malloc(n * n * sizeof(uint64_t));
+    int result = -1;
+    if (dist && next)
+        result = fossil_algorithm_graph_floyd_warshall(graph, "f64", dist, next);
+
+    if (result == 0 && next[start * n + target] == FOSSIL_GRAPH_NO_NODE)
+        result = -1;
+
+    if (result == 0 && visit) {
+        uint64_t v = start;
+        while (visit(v, user) && v != target)
+            v = next[v * n + target];
+    }
+
+    free(dist);
+    free(next);
+    return result;
+}
+
+// ======================================================
+// Connected Components
+// ======================================================
+
+/*
+ * Afforest (Sutton et al.): link every node to its first few neighbors,
+ * compress, sample the most common component and then only scan the
+ * remaining edges of nodes outside it. Links always hook the larger root
+ * under the smaller one with a CAS, so each root is the smallest node of
+ * its component and concurrent links never form a cycle.
+ */
+#define GRAPH_CC_NEIGHBOR_ROUNDS 2
+#define GRAPH_CC_SAMPLES 1024
+
+// Fills the optional size array and component count from dense ids.
+static void
+graph_components_sizes(
+    const uint64_t *component,
+    size_t n,
+    size_t components,
+    uint64_t *sizes,
+    size_t *count
+) {
+    if (sizes) {
+        memset(sizes, 0, components * sizeof(uint64_t));
+        for (size_t v = 0; v < n; v++)
+            sizes[component[v]]++;
+    }
+    if (count)
+        *count = components;
+}
+
+typedef struct graph_cc_ctx {
+    fossil_graph_t *graph;
+    volatile uint64_t *parent;
+    uint64_t round;          // neighbor index linked in the sampling rounds
+    uint64_t skip;           // sampled largest component, or NO_NODE
+    uint64_t cursor;
+} graph_cc_ctx_t;
+
+static void graph_cc_link(volatile uint64_t *parent, uint64_t u, uint64_t v)
+{
+    uint64_t p1 = graph_atomic_load(&parent[u]);
+    uint64_t p2 = graph_atomic_load(&parent[v]);
+
+    while (p1 != p2) {
+        uint64_t high = p1 > p2 ? p1 : p2;
+        uint64_t low = p1 + p2 - high;
+        uint64_t p_high = graph_atomic_load(&parent[high]);
+        if (p_high == low)
+            break;
+        if (p_high == high && graph_atomic_cas(&parent[high], high, low))
+            break;
+        p1 = graph_atomic_load(&parent[graph_atomic_load(&parent[high])]);
+        p2 = graph_atomic_load(&parent[low]);
+    }
+}
+
+static void graph_cc_compress(void *arg, size_t tid, size_t threads)
+{
+    graph_cc_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->graph->node_count, 1024, &first, &last)) {
+        for (uint64_t v = first; v < last; v++) {
+            uint64_t p = graph_atomic_load(&ctx->parent[v]);
+            uint64_t gp = graph_atomic_load(&ctx->parent[p]);
+            while (p != gp) {
+                graph_atomic_store(&ctx->parent[v], gp);
+                p = gp;
+                gp = graph_atomic_load(&ctx->parent[p]);
+            }
+        }
+    }
+}
+
+// Links neighbor number ctx->round of every node.
+static void graph_cc_neighbor_round(void *arg, size_t tid, size_t threads)
+{
+    graph_cc_ctx_t *ctx = arg;
+    const fossil_graph_adj_t *out = graph_out(ctx->graph);
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->graph->node_count, 1024, &first, &last)) {
+        for (uint64_t v = first; v < last; v++) {
+            if (graph_packed(ctx->graph)) {
+                graph_packed_cursor_t cursor;
+                uint64_t w = FOSSIL_GRAPH_NO_NODE;
+                graph_packed_open(&ctx->graph->csr->packed, v, &cursor);
+                bool found = true;
+                for (uint64_t i = 0; found && i <= ctx->round; i++)
+                    found = graph_packed_next(&cursor, &w);
+                if (found)
+                    graph_cc_link(ctx->parent, v, w);
+                continue;
+            }
+
+            uint64_t begin, end;
+            graph_adj_range(out, v, &begin, &end);
+            if (begin + ctx->round < end)
+                graph_cc_link(ctx->parent, v, out->targets[begin + ctx->round]);
+        }
+    }
+}
+
+// Links the edges the neighbor rounds did not cover.
+static void graph_cc_finish(void *arg, size_t tid, size_t threads)
+{
+    graph_cc_ctx_t *ctx = arg;
+    const fossil_graph_adj_t *out = graph_out(ctx->graph);
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->graph->node_count, 256, &first, &last)) {
+        for (uint64_t v = first; v < last; v++) {
+            if (graph_atomic_load(&ctx->parent[v]) == ctx->skip)
+                continue;
+            if (graph_packed(ctx->graph)) {
+                graph_packed_cursor_t cursor;
+                uint64_t w, i = 0;
+                graph_packed_open(&ctx->graph->csr->packed, v, &cursor);
+                while (graph_packed_next(&cursor, &w))
+                    if (i++ >= GRAPH_CC_NEIGHBOR_ROUNDS)
+                        graph_cc_link(ctx->parent, v, w);
+                continue;
+            }
+            uint64_t begin, end;
+            graph_adj_range(out, v, &begin, &end);
+            for (uint64_t e = begin + GRAPH_CC_NEIGHBOR_ROUNDS; e < end; e++)
+                graph_cc_link(ctx->parent, v, out->targets[e]);
+        }
+    }
+}
+
+// Most frequent root among a fixed pseudo-random sample of nodes.
+static uint64_t graph_cc_sample(const uint64_t *parent, size_t n)
+{
+    uint64_t sample[GRAPH_CC_SAMPLES];
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < GRAPH_CC_SAMPLES; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        sample[i] = parent[state % n];
+    }
+    qsort(sample, GRAPH_CC_SAMPLES, sizeof(uint64_t), graph_u64_compare);
+
+    uint64_t best = sample[0];
+    size_t best_run = 0, run = 0;
+    for (size_t i = 0; i < GRAPH_CC_SAMPLES; i++) {
+        run = (i > 0 && sample[i] == sample[i - 1]) ? run + 1 : 1;
+        if (run > best_run) {
+            best_run = run;
+            best = sample[i];
+        }
+    }
+    return best;
+}
+
+/*
+ * Weakly connected components. On return component[v] holds dense ids
+ * numbered in order of each component's smallest node.
+ */
+static int
+graph_connected_components(
+    fossil_graph_t *graph,
+    uint64_t *component,
+    uint64_t *sizes,
+    size_t *count
+) {
+    size_t n = graph->node_count;
+    graph_cc_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.graph = graph;
+    ctx.parent = component;
+    ctx.skip = FOSSIL_GRAPH_NO_NODE;
+
+    for (uint64_t v = 0; v < n; v++)
+        component[v] = v;
+
+    graph_pool_t *pool = graph_pool_create(graph_thread_count());
+
+    for (ctx.round = 0; ctx.round < GRAPH_CC_NEIGHBOR_ROUNDS; ctx.round++) {
+        ctx.cursor = 0;
+        graph_pool_run(pool, graph_cc_neighbor_round, &ctx);
+        ctx.cursor = 0;
+        graph_pool_run(pool, graph_cc_compress, &ctx);
+    }
+
+    /*
+     * Skipping the sampled component is only sound when every edge is
+     * also seen from its other endpoint, i.e. for undirected graphs.
+     */
+    if (!graph->directed)
+        ctx.skip = graph_cc_sample(component, n);
+
+    ctx.cursor = 0;
+    graph_pool_run(pool, graph_cc_finish, &ctx);
+    ctx.cursor = 0;
+    graph_pool_run(pool, graph_cc_compress, &ctx);
+    graph_pool_destroy(pool);
+
+    // Roots are the smallest node of their component, so ids fill in order
+    size_t components = 0;
+    for (uint64_t v = 0; v < n; v++) {
+        if (component[v] == v)
+            component[v] = components++;
+        else
+            component[v] = component[component[v]];
+    }
+
+    graph_components_sizes(component, n, components, sizes, count);
+    return 0;
+}
+
+// ======================================================
+// Strongly Connected Components
+// ======================================================
+
+/*
+ * Iterative Tarjan over the nodes whose component is still
+ * FOSSIL_GRAPH_NO_NODE; nodes with a component are treated as removed.
+ * Each SCC is labelled with its root node. A node is on the Tarjan
+ * stack exactly when it has an index but no component yet.
+ */
+static int graph_scc_tarjan_remaining(fossil_graph_t *graph, uint64_t *component)
+{
+    size_t n = graph->node_count;
+    const fossil_graph_adj_t *out = graph_out(graph);
+    uint64_t *index = malloc(n * sizeof(uint64_t));
+    uint64_t *low = malloc(n * sizeof(uint64_t));
+    uint64_t *stack = malloc(n * sizeof(uint64_t));
+    uint64_t *call_node = malloc(n * sizeof(uint64_t));
+    uint64_t *call_edge = malloc(n * sizeof(uint64_t));
+    if (!index || !low || !stack || !call_node || !call_edge) {
+        free(index);
+        free(low);
+        free(stack);
+        free(call_node);
+        free(call_edge);
+        return -1;
+    }
+
+    for (size_t v = 0; v < n; v++)
+        index[v] = FOSSIL_GRAPH_NO_NODE;
+
+    uint64_t clock = 0;
+    size_t stack_size = 0, depth = 0;
+    for (uint64_t s = 0; s < n; s++) {
+        if (component[s] != FOSSIL_GRAPH_NO_NODE || index[s] != FOSSIL_GRAPH_NO_NODE)
+            continue;
+
+        uint64_t end;
+        index[s] = low[s] = clock++;
+        stack[stack_size++] = s;
+        call_node[depth] = s;
+        graph_adj_range(out, s, &call_edge[depth], &end);
+        depth++;
+
+        while (depth > 0) {
+            uint64_t v = call_node[depth - 1];
+            uint64_t begin;
+            graph_adj_range(out, v, &begin, &end);
+
+            if (call_edge[depth - 1] < end) {
+                uint64_t w = out->targets[call_edge[depth - 1]++];
+                if (component[w] != FOSSIL_GRAPH_NO_NODE)
+                    continue;
+                if (index[w] == FOSSIL_GRAPH_NO_NODE) {
+                    index[w] = low[w] = clock++;
+                    stack[stack_size++] = w;
+                    call_node[depth] = w;
+                    graph_adj_range(out, w, &call_edge[depth], &end);
+                    depth++;
+                } else if (index[w] < low[v]) {
+                    low[v] = index[w];
+                }
+                continue;
+            }
+
+            depth--;
+            if (low[v] == index[v]) {
+                uint64_t w;
+                do {
+                    w = stack[--stack_size];
+                    component[w] = v;
+                } while (w != v);
+            }
+            if (depth > 0 && low[v] < low[call_node[depth - 1]])
+                low[call_node[depth - 1]] = low[v];
+        }
+    }
+
+    free(index);
+    free(low);
+    free(stack);
+    free(call_node);
+    free(call_edge);
+    return 0;
+}
+
+/*
+ * Renumbers representative labels to dense ids in the order of each
+ * component's smallest node.
+ */
+static int
+graph_components_relabel(
+    uint64_t *component,
+    size_t n,
+    uint64_t *sizes,
+    size_t *count
+) {
+    uint64_t *dense = malloc(n * sizeof(uint64_t));
+    if (!dense)
+        return -1;
+    for (size_t v = 0; v < n; v++)
+        dense[v] = FOSSIL_GRAPH_NO_NODE;
+
+    size_t components = 0;
+    for (size_t v = 0; v < n; v++) {
+        uint64_t rep = component[v];
+        if (dense[rep] == FOSSIL_GRAPH_NO_NODE)
+            dense[rep] = components++;
+        component[v] = dense[rep];
+    }
+    free(dense);
+
+    graph_components_sizes(component, n, components, sizes, count);
+    return 0;
+}
+
+static int
+graph_scc_tarjan(
+    fossil_graph_t *graph,
+    uint64_t *component,
+    uint64_t *sizes,
+    size_t *count
+) {
+    for (size_t v = 0; v < graph->node_count; v++)
+        component[v] = FOSSIL_GRAPH_NO_NODE;
+
+    if (graph_scc_tarjan_remaining(graph, component) != 0)
+        return -1;
+    return graph_components_relabel(component, graph->node_count, sizes, count);
+}
+
+/*
+ * Parallel SCC in the spirit of Multistep (Slota et al.): trim nodes
+ * without live in- or out-neighbors, peel the SCC of a high-degree
+ * pivot with a parallel forward search followed by a backward search
+ * restricted to the forward set, trim again and finish the (typically
+ * small) remainder with the serial Tarjan above.
+ */
+#define GRAPH_SCC_TRIM_ROUNDS 8
+#define GRAPH_SCC_FORWARD 1
+#define GRAPH_SCC_PEELED 2
+
+typedef struct graph_scc_ctx {
+    size_t node_count;
+    const fossil_graph_adj_t *out;
+    const fossil_graph_adj_t *in;
+    volatile uint64_t *component;
+    volatile uint64_t *color;
+    const fossil_graph_adj_t *adj;    // direction of the current search
+    uint64_t from;                    // color a node must have to be reached
+    uint64_t to;                      // color it is given
+    uint64_t *queue;
+    uint64_t *next_queue;
+    uint64_t queue_size;
+    uint64_t next_size;
+    uint64_t cursor;
+    uint64_t trimmed;
+} graph_scc_ctx_t;
+
+static bool
+graph_scc_has_live(
+    const graph_scc_ctx_t *ctx,
+    const fossil_graph_adj_t *adj,
+    uint64_t v
+) {
+    uint64_t begin, end;
+    graph_adj_range(adj, v, &begin, &end);
+    for (uint64_t e = begin; e < end; e++) {
+        uint64_t w = adj->targets[e];
+        if (w != v && graph_atomic_load(&ctx->component[w]) == FOSSIL_GRAPH_NO_NODE)
+            return true;
+    }
+    return false;
+}
+
+/*
+ * A node whose remaining neighbors were trimmed concurrently is still a
+ * singleton SCC: trimmed nodes never lie on a cycle with live ones.
+ */
+static void graph_scc_trim(void *arg, size_t tid, size_t threads)
+{
+    graph_scc_ctx_t *ctx = arg;
+    uint64_t trimmed = 0;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 1024, &first, &last)) {
+        for (uint64_t v = first; v < last; v++) {
+            if (graph_atomic_load(&ctx->component[v]) != FOSSIL_GRAPH_NO_NODE)
+                continue;
+            if (!graph_scc_has_live(ctx, ctx->out, v) || !graph_scc_has_live(ctx, ctx->in, v)) {
+                graph_atomic_store(&ctx->component[v], v);
+                trimmed++;
+            }
+        }
+    }
+    graph_atomic_add(&ctx->trimmed, trimmed);
+}
+
+static void graph_scc_search_step(void *arg, size_t tid, size_t threads)
+{
+    graph_scc_ctx_t *ctx = arg;
+    uint64_t local[GRAPH_BFS_BATCH];
+    size_t local_count = 0;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->queue_size, 64, &first, &last)) {
+        for (uint64_t i = first; i < last; i++) {
+            uint64_t begin, end;
+            graph_adj_range(ctx->adj, ctx->queue[i], &begin, &end);
+
+            for (uint64_t e = begin; e < end; e++) {
+                uint64_t w = ctx->adj->targets[e];
+                if (ctx->component[w] != FOSSIL_GRAPH_NO_NODE)
+                    continue;
+                if (graph_atomic_load(&ctx->color[w]) != ctx->from ||
+                    !graph_atomic_cas(&ctx->color[w], ctx->from, ctx->to))
+                    continue;
+
+                local[local_count++] = w;
+                if (local_count == GRAPH_BFS_BATCH) {
+                    uint64_t slot = graph_atomic_add(&ctx->next_size, local_count);
+                    memcpy(ctx->next_queue + slot, local, local_count * sizeof(uint64_t));
+                    local_count = 0;
+                }
+            }
+        }
+    }
+
+    if (local_count) {
+        uint64_t slot = graph_atomic_add(&ctx->next_size, local_count);
+        memcpy(ctx->next_queue + slot, local, local_count * sizeof(uint64_t));
+    }
+}
+
+// Level-synchronous search from the pivot, recoloring from -> to.
+static void
+graph_scc_search(
+    graph_scc_ctx_t *ctx,
+    graph_pool_t *pool,
+    const fossil_graph_adj_t *adj,
+    uint64_t pivot,
+    uint64_t from,
+    uint64_t to
+) {
+    ctx->adj = adj;
+    ctx->from = from;
+    ctx->to = to;
+    ctx->color[pivot] = to;
+    ctx->queue[0] = pivot;
+    ctx->queue_size = 1;
+
+    while (ctx->queue_size > 0) {
+        ctx->cursor = 0;
+        ctx->next_size = 0;
+        graph_pool_run(pool, graph_scc_search_step, ctx);
+
+        uint64_t *swap = ctx->queue;
+        ctx->queue = ctx->next_queue;
+        ctx->next_queue = swap;
+        ctx->queue_size = ctx->next_size;
+    }
+}
+
+static void graph_scc_trim_rounds(graph_scc_ctx_t *ctx, graph_pool_t *pool)
+{
+    for (size_t round = 0; round < GRAPH_SCC_TRIM_ROUNDS; round++) {
+        ctx->cursor = 0;
+        ctx->trimmed = 0;
+        graph_pool_run(pool, graph_scc_trim, ctx);
+        if (ctx->trimmed == 0)
+            break;
+    }
+}
+
+static int
+graph_scc_parallel(
+    fossil_graph_t *graph,
+    uint64_t *component,
+    uint64_t *sizes,
+    size_t *count
+) {
+    size_t n = graph->node_count;
+
+    // Without direction, strong and weak connectivity coincide
+    if (!graph->directed)
+        return graph_connected_components(graph, component, sizes, count);
+
+    bool ok = true;
+    graph_scc_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.node_count = n;
+    ctx.out = graph_out(graph);
+    ctx.in = graph_reverse(graph, &ok);
+    ctx.component = component;
+    ctx.color = calloc(n, sizeof(uint64_t));
+    ctx.queue = malloc(n * sizeof(uint64_t));
+    ctx.next_queue = malloc(n * sizeof(uint64_t));
+    if (!ok || !ctx.color || !ctx.queue || !ctx.next_queue) {
+        free((void *)ctx.color);
+        free(ctx.queue);
+        free(ctx.next_queue);
+        return -1;
+    }
+
+    for (size_t v = 0; v < n; v++)
+        component[v] = FOSSIL_GRAPH_NO_NODE;
+
+    graph_pool_t *pool = graph_pool_create(graph_thread_count());
+    graph_scc_trim_rounds(&ctx, pool);
+
+    // The pivot with the largest degree product is likely in the giant SCC
+    uint64_t pivot = FOSSIL_GRAPH_NO_NODE, best = 0;
+    for (uint64_t v = 0; v < n; v++) {
+        if (component[v] != FOSSIL_GRAPH_NO_NODE)
+            continue;
+        uint64_t score = (graph_adj_degree(ctx.out, v) + 1) * (graph_adj_degree(ctx.in, v) + 1);
+        if (pivot == FOSSIL_GRAPH_NO_NODE || score > best) {
+            pivot = v;
+            best = score;
+        }
+    }
+
+    if (pivot != FOSSIL_GRAPH_NO_NODE) {
+        // Nodes reached forward and then backward within the forward set
+        graph_scc_search(&ctx, pool, ctx.out, pivot, 0, GRAPH_SCC_FORWARD);
+        graph_scc_search(&ctx, pool, ctx.in, pivot, GRAPH_SCC_FORWARD, GRAPH_SCC_PEELED);
+        for (size_t v = 0; v < n; v++) {
+            if (ctx.color[v] == GRAPH_SCC_PEELED)
+                component[v] = pivot;
+        }
+        graph_scc_trim_rounds(&ctx, pool);
+    }
+    graph_pool_destroy(pool);
+
+    free((void *)ctx.color);
+    free(ctx.queue);
+    free(ctx.next_queue);
+
+    if (graph_scc_tarjan_remaining(graph, component) != 0)
+        return -1;
+    return graph_components_relabel(component, n, sizes, count);
+}
+
+typedef int (*graph_components_fn)(fossil_graph_t *, uint64_t *, uint64_t *, size_t *);
+
+static graph_components_fn graph_components_select(const char *algorithm_id)
+{
+    if (algorithm_equals(algorithm_id, "cc"))
+        return graph_connected_components;
+    if (algorithm_equals(algorithm_id, "scc"))
+        return graph_scc_tarjan;
+    if (algorithm_equals(algorithm_id, "scc-parallel"))
+        return graph_scc_parallel;
+    return NULL;
+}
+
+// Reports the nodes that share start's component, in node order.
+static int
+graph_exec_components(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t start,
+    fossil_graph_visit_fn visit,
+    void *user
+) {
+    uint64_t *component = malloc(graph->node_count * sizeof(uint64_t));
+    if (!component)
+        return -1;
+
+    int result = fossil_algorithm_graph_components(graph, algorithm_id, component, NULL, NULL);
+    if (result == 0 && visit) {
+        for (uint64_t v = 0; v < graph->node_count; v++) {
+            if (component[v] == component[start] && !visit(v, user))
+                break;
+        }
+    }
+
+    free(component);
+    return result;
+}
+
+// ======================================================
+// Topological Order
+// ======================================================
+
+/*
+ * Kahn's algorithm. order doubles as the FIFO queue; indeg ends up
+ * non-zero exactly for the nodes that could not be ordered (those on a
+ * cycle or downstream of one). level[v] is the longest hop distance
+ * from a source, i.e. the wavefront v belongs to.
+ */
+static void
+graph_toposort_kahn(
+    fossil_graph_t *graph,
+    uint64_t *order,
+    uint64_t *level,
+    uint64_t *indeg,
+    size_t *count
+) {
+    size_t n = graph->node_count;
+    const fossil_graph_adj_t *out = graph_out(graph);
+    memset(indeg, 0, n * sizeof(uint64_t));
+    for (uint64_t u = 0; u < n; u++) {
+        uint64_t begin, end;
+        graph_adj_range(out, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++)
+            indeg[out->targets[e]]++;
+    }
+
+    size_t head = 0, tail = 0;
+    for (uint64_t v = 0; v < n; v++) {
+        if (level)
+            level[v] = 0;
+        if (indeg[v] == 0)
+            order[tail++] = v;
+    }
+
+    while (head < tail) {
+        uint64_t u = order[head++];
+        uint64_t begin, end;
+        graph_adj_range(out, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t v = out->targets[e];
+            if (level && level[u] + 1 > level[v])
+                level[v] = level[u] + 1;
+            if (--indeg[v] == 0)
+                order[tail++] = v;
+        }
+    }
+    *count = tail;
+}
+
+typedef struct graph_topo_ctx {
+    const fossil_graph_adj_t *out;
+    size_t node_count;
+    volatile uint64_t *indeg;
+    const uint64_t *frontier;
+    uint64_t frontier_size;
+    uint64_t *next;
+    uint64_t next_size;
+    uint64_t cursor;
+} graph_topo_ctx_t;
+
+static void graph_topo_count(void *arg, size_t tid, size_t threads)
+{
+    graph_topo_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 1024, &first, &last)) {
+        for (uint64_t v = first; v < last; v++) {
+            uint64_t begin, end;
+            graph_adj_range(ctx->out, v, &begin, &end);
+            for (uint64_t e = begin; e < end; e++)
+                graph_atomic_add(&ctx->indeg[ctx->out->targets[e]], 1);
+        }
+    }
+}
+
+// Releases the successors of one wavefront; the last decrement wins.
+static void graph_topo_step(void *arg, size_t tid, size_t threads)
+{
+    graph_topo_ctx_t *ctx = arg;
+    uint64_t local[GRAPH_BFS_BATCH];
+    size_t local_count = 0;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->frontier_size, 64, &first, &last)) {
+        for (uint64_t i = first; i < last; i++) {
+            uint64_t begin, end;
+            graph_adj_range(ctx->out, ctx->frontier[i], &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                uint64_t v = ctx->out->targets[e];
+                if (graph_atomic_add(&ctx->indeg[v], (uint64_t)-1) != 1)
+                    continue;
+
+                local[local_count++] = v;
+                if (local_count == GRAPH_BFS_BATCH) {
+                    uint64_t slot = graph_atomic_add(&ctx->next_size, local_count);
+                    memcpy(ctx->next + slot, local, local_count * sizeof(uint64_t));
+                    local_count = 0;
+                }
+            }
+        }
+    }
+
+    if (local_count) {
+        uint64_t slot = graph_atomic_add(&ctx->next_size, local_count);
+        memcpy(ctx->next + slot, local, local_count * sizeof(uint64_t));
+    }
+}
+
+/*
+ * Level-synchronous Kahn: every wavefront is released in parallel and
+ * written to order sorted by node id, so the result is deterministic.
+ */
+static void
+graph_toposort_levels(
+    fossil_graph_t *graph,
+    uint64_t *order,
+    uint64_t *level,
+    uint64_t *indeg,
+    size_t *count
+) {
+    size_t n = graph->node_count;
+    graph_topo_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = graph_out(graph);
+    ctx.node_count = n;
+    ctx.indeg = indeg;
+    memset(indeg, 0, n * sizeof(uint64_t));
+
+    graph_pool_t *pool = graph_pool_create(graph_thread_count());
+    if (ctx.out)
+        graph_pool_run(pool, graph_topo_count, &ctx);
+
+    size_t done = 0;
+    for (uint64_t v = 0; v < n; v++) {
+        if (indeg[v] == 0)
+            order[done++] = v;
+    }
+
+    // Each wavefront is appended right behind the previous one in order
+    size_t begin = 0;
+    for (uint64_t depth = 0; begin < done; depth++) {
+        ctx.frontier = order + begin;
+        ctx.frontier_size = done - begin;
+        ctx.next = order + done;
+        ctx.next_size = 0;
+        ctx.cursor = 0;
+        if (level) {
+            for (size_t i = begin; i < done; i++)
+                level[order[i]] = depth;
+        }
+        graph_pool_run(pool, graph_topo_step, &ctx);
+
+        qsort(ctx.next, ctx.next_size, sizeof(uint64_t), graph_u64_compare);
+        begin = done;
+        done += ctx.next_size;
+    }
+    graph_pool_destroy(pool);
+    *count = done;
+}
+
+typedef void (*graph_toposort_fn)(fossil_graph_t *, uint64_t *, uint64_t *, uint64_t *, size_t *);
+
+static graph_toposort_fn graph_toposort_select(const char *algorithm_id)
+{
+    if (algorithm_equals(algorithm_id, "toposort"))
+        return graph_toposort_kahn;
+    if (algorithm_equals(algorithm_id, "toposort-parallel"))
+        return graph_toposort_levels;
+    return NULL;
+}
+
+/*
+ * Walks backwards over unordered nodes: each has an unordered
+ * predecessor, so the walk must close a cycle.
+ */
+static int
+graph_find_cycle(
+    fossil_graph_t *graph,
+    uint64_t *cycle,
+    size_t *cycle_length
+) {
+    size_t n = graph->node_count;
+    uint64_t *indeg = malloc(n * sizeof(uint64_t));
+    uint64_t *order = malloc(n * sizeof(uint64_t));
+    if (!indeg || !order) {
+        free(indeg);
+        free(order);
+        return -1;
+    }
+
+    size_t count;
+    graph_toposort_kahn(graph, order, NULL, indeg, &count);
+    *cycle_length = 0;
+    if (count == n) {
+        free(indeg);
+        free(order);
+        return 0;
+    }
+
+    bool ok = true;
+    const fossil_graph_adj_t *in = graph_reverse(graph, &ok);
+    if (!ok) {
+        free(indeg);
+        free(order);
+        return -1;
+    }
+
+    // order is reused as the step at which each node was walked
+    uint64_t *step = order;
+    for (size_t v = 0; v < n; v++)
+        step[v] = FOSSIL_GRAPH_NO_NODE;
+
+    uint64_t v = 0;
+    while (indeg[v] == 0)
+        v++;
+
+    size_t length = 0;
+    while (step[v] == FOSSIL_GRAPH_NO_NODE) {
+        step[v] = length;
+        cycle[length++] = v;
+
+        uint64_t begin, end;
+        graph_adj_range(in, v, &begin, &end);
+        uint64_t u = v;
+        for (uint64_t e = begin; e < end; e++) {
+            if (indeg[in->targets[e]] != 0) {
+                u = in->targets[e];
+                break;
+            }
+        }
+        v = u;
+    }
+
+    // cycle[step[v] ..] runs against the edges; reverse it into edge order
+    size_t first = step[v];
+    size_t k = length - first;
+    for (size_t i = 0; i < k / 2; i++) {
+        uint64_t swap = cycle[first + i];
+        cycle[first + i] = cycle[length - 1 - i];
+        cycle[length - 1 - i] = swap;
+    }
+    memmove(cycle, cycle + first, k * sizeof(uint64_t));
+    *cycle_length = k;
+
+    free(indeg);
+    free(order);
+    return 0;
+}
+
+/*
+ * Single pass over a topological order; longest paths negate the
+ * comparison rather than the weights.
+ */
+static int
+graph_dag_path(
+    fossil_graph_t *graph,
+    bool longest,
+    uint64_t start,
+    double *dist,
+    uint64_t *pred
+) {
+    size_t n = graph->node_count;
+    uint64_t *order = malloc(n * sizeof(uint64_t));
+    uint64_t *indeg = malloc(n * sizeof(uint64_t));
+    if (!order || !indeg) {
+        free(order);
+        free(indeg);
+        return -1;
+    }
+
+    size_t count;
+    graph_toposort_kahn(graph, order, NULL, indeg, &count);
+    free(indeg);
+    if (count < n) {
+        free(order);
+        return -4;
+    }
+
+    double unreached = longest ? -DBL_MAX : DBL_MAX;
+    for (size_t v = 0; v < n; v++) {
+        dist[v] = start == FOSSIL_GRAPH_NO_NODE ? 0.0 : unreached;
+        pred[v] = FOSSIL_GRAPH_NO_NODE;
+    }
+    if (start != FOSSIL_GRAPH_NO_NODE)
+        dist[start] = 0.0;
+
+    const fossil_graph_adj_t *out = graph_out(graph);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t u = order[i];
+        if (dist[u] == unreached)
+            continue;
+
+        uint64_t begin, end;
+        graph_adj_range(out, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t v = out->targets[e];
+            double alt = dist[u] + (out->weights ? out->weights[e] : 1.0);
+            if (longest ? alt > dist[v] : alt < dist[v]) {
+                dist[v] = alt;
+                pred[v] = u;
+            }
+        }
+    }
+
+    free(order);
+    return 0;
+}
+
+// Reports the topological order to the exec visitor.
+static int
+graph_exec_toposort(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    fossil_graph_visit_fn visit,
+    void *user
+) {
+    uint64_t *order = malloc(graph->node_count * sizeof(uint64_t));
+    if (!order)
+        return -1;
+
+    size_t count = 0;
+    int result = fossil_algorithm_graph_toposort(graph, algorithm_id, order, NULL, &count);
+    if (result == 0 && visit) {
+        for (size_t i = 0; i < count && visit(order[i], user); i++)
+            ;
+    }
+
+    free(order);
+    return result;
+}
+
+// ======================================================
+// Minimum Spanning Forest
+// ======================================================
+
+/*
+ * All three algorithms see each undirected edge once, as the arc from
+ * its smaller endpoint; self-loops never join two trees. Weight ties may
+ * pick different trees, but the total weight is always the same.
+ */
+typedef struct graph_mst_out {
+    fossil_graph_edge_t *edges;      // optional
+    size_t count;
+    double total;
+} graph_mst_out_t;
+
+static inline void graph_mst_emit(graph_mst_out_t *out, uint64_t u, uint64_t v, double w)
+{
+    if (out->edges) {
+        out->edges[out->count].from = u < v ? u : v;
+        out->edges[out->count].to = u < v ? v : u;
+        out->edges[out->count].weight = w;
+    }
+    out->count++;
+    out->total += w;
+}
+
+static uint64_t graph_uf_find(uint64_t *parent, uint64_t v)
+{
+    while (parent[v] != v) {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+typedef struct graph_mst_edge {
+    uint64_t key;
+    uint64_t u;
+    uint64_t v;
+} graph_mst_edge_t;
+
+/*
+ * LSD radix sort on the weight key, 16 bits per pass. Passes where every
+ * key shares the digit (e.g. the low mantissa bits of integer weights)
+ * are skipped.
+ */
+static bool graph_mst_radix_sort(graph_mst_edge_t *edges, size_t count)
+{
+    graph_mst_edge_t *buffer = malloc((count ? count : 1) * sizeof(graph_mst_edge_t));
+    size_t *bucket = malloc(65536 * sizeof(size_t));
+    if (!buffer || !bucket) {
+        free(buffer);
+        free(bucket);
+        return false;
+    }
+
+    graph_mst_edge_t *src = edges, *dst = buffer;
+    for (unsigned shift = 0; shift < 64; shift += 16) {
+        memset(bucket, 0, 65536 * sizeof(size_t));
+        for (size_t i = 0; i < count; i++)
+            bucket[(src[i].key >> shift) & 0xFFFF]++;
+        if (count == 0 || bucket[(src[0].key >> shift) & 0xFFFF] == count)
+            continue;
+
+        size_t sum = 0;
+        for (size_t d = 0; d < 65536; d++) {
+            size_t c = bucket[d];
+            bucket[d] = sum;
+            sum += c;
+        }
+        for (size_t i = 0; i < count; i++)
+            dst[bucket[(src[i].key >> shift) & 0xFFFF]++] = src[i];
+
+        graph_mst_edge_t *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != edges)
+        memcpy(edges, src, count * sizeof(graph_mst_edge_t));
+
+    free(buffer);
+    free(bucket);
+    return true;
+}
+
+static int graph_mst_kruskal(fossil_graph_t *graph, graph_mst_out_t *out)
+{
+    size_t n = graph->node_count;
+    const fossil_graph_adj_t *adj = graph_out(graph);
+    size_t arcs = adj ? adj->offsets[n] : 0;
+
+    graph_mst_edge_t *edges = malloc((arcs ? arcs : 1) * sizeof(graph_mst_edge_t));
+    uint64_t *parent = malloc(n * sizeof(uint64_t));
+    if (!edges || !parent) {
+        free(edges);
+        free(parent);
+        return -1;
+    }
+
+    size_t m = 0;
+    for (uint64_t u = 0; u < n; u++) {
+        uint64_t begin, end;
+        graph_adj_range(adj, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            if (u < adj->targets[e]) {
+                edges[m].key = graph_weight_key(adj->weights[e]);
+                edges[m].u = u;
+                edges[m].v = adj->targets[e];
+                m++;
+            }
+        }
+    }
+    if (!graph_mst_radix_sort(edges, m)) {
+        free(edges);
+        free(parent);
+        return -1;
+    }
+
+    for (uint64_t v = 0; v < n; v++)
+        parent[v] = v;
+    for (size_t i = 0; i < m && out->count + 1 < n; i++) {
+        uint64_t a = graph_uf_find(parent, edges[i].u);
+        uint64_t b = graph_uf_find(parent, edges[i].v);
+        if (a == b)
+            continue;
+        parent[a > b ? a : b] = a < b ? a : b;
+        graph_mst_emit(out, edges[i].u, edges[i].v, graph_key_weight(edges[i].key));
+    }
+
+    free(edges);
+    free(parent);
+    return 0;
+}
+
+static int graph_mst_prim(fossil_graph_t *graph, graph_mst_out_t *out)
+{
+    size_t n = graph->node_count;
+    const fossil_graph_adj_t *adj = graph_out(graph);
+    double *best = malloc(n * sizeof(double));
+    uint64_t *from = malloc(n * sizeof(uint64_t));
+    uint64_t *done = calloc(graph_bit_words(n), sizeof(uint64_t));
+    graph_heap_t heap;
+    bool heap_ok = graph_heap_init(&heap, n);
+    if (!best || !from || !done || !heap_ok) {
+        free(best);
+        free(from);
+        free(done);
+        if (heap_ok)
+            graph_heap_free(&heap);
+        return -1;
+    }
+
+    for (size_t v = 0; v < n; v++) {
+        best[v] = DBL_MAX;
+        from[v] = FOSSIL_GRAPH_NO_NODE;
+    }
+
+    // One tree per unreached root gives the spanning forest
+    for (uint64_t root = 0; root < n; root++) {
+        if (graph_bit_test(done, root))
+            continue;
+        graph_heap_push(&heap, root, 0.0);
+
+        while (heap.size > 0) {
+            double key;
+            uint64_t u = graph_heap_pop(&heap, &key);
+            graph_bit_set(done, u);
+            if (from[u] != FOSSIL_GRAPH_NO_NODE)
+                graph_mst_emit(out, from[u], u, best[u]);
+
+            uint64_t begin, end;
+            graph_adj_range(adj, u, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                uint64_t v = adj->targets[e];
+                if (graph_bit_test(done, v) || !(adj->weights[e] < best[v]))
+                    continue;
+                best[v] = adj->weights[e];
+                from[v] = u;
+                graph_heap_push(&heap, v, best[v]);
+            }
+        }
+    }
+
+    free(best);
+    free(from);
+    free(done);
+    graph_heap_free(&heap);
+    return 0;
+}
+
+/*
+ * Parallel Boruvka. Each round every node finds its lightest arc to
+ * another tree, each tree keeps the lightest of those (CAS on the
+ * tree's candidate node) and the chosen edges are hooked with the same
+ * lock-free link as "cc". Edges are compared by (weight, smaller
+ * endpoint, larger endpoint); two trees that pick the same pair emit
+ * it once.
+ */
+typedef struct graph_boruvka_ctx {
+    const fossil_graph_adj_t *adj;
+    size_t node_count;
+    volatile uint64_t *parent;     // tree root of every node (compressed)
+    volatile uint64_t *candidate;  // per root: node holding the tree's best arc
+    uint64_t *best_arc;            // per node: lightest arc leaving its tree
+    uint64_t *chosen;              // nodes whose best arc joins the forest
+    uint64_t chosen_count;
+    graph_mst_out_t *out;
+    uint64_t cursor;
+} graph_boruvka_ctx_t;
+
+static bool
+graph_boruvka_less(
+    const graph_boruvka_ctx_t *ctx,
+    uint64_t u1,
+    uint64_t e1,
+    uint64_t u2,
+    uint64_t e2
+) {
+    double w1 = ctx->adj->weights[e1], w2 = ctx->adj->weights[e2];
+    if (w1 != w2)
+        return w1 < w2;
+    uint64_t v1 = ctx->adj->targets[e1], v2 = ctx->adj->targets[e2];
+    uint64_t lo1 = u1 < v1 ? u1 : v1, lo2 = u2 < v2 ? u2 : v2;
+    if (lo1 != lo2)
+        return lo1 < lo2;
+    uint64_t hi1 = u1 < v1 ? v1 : u1, hi2 = u2 < v2 ? v2 : u2;
+    return hi1 < hi2;
+}
+
+static void graph_boruvka_scan(void *arg, size_t tid, size_t threads)
+{
+    graph_boruvka_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 256, &first, &last)) {
+        for (uint64_t u = first; u < last; u++) {
+            uint64_t root = ctx->parent[u];
+            uint64_t best = FOSSIL_GRAPH_NO_NODE;
+            uint64_t begin, end;
+            graph_adj_range(ctx->adj, u, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                if (ctx->parent[ctx->adj->targets[e]] == root)
+                    continue;
+                if (best == FOSSIL_GRAPH_NO_NODE || graph_boruvka_less(ctx, u, e, u, best))
+                    best = e;
+            }
+            ctx->best_arc[u] = best;
+        }
+    }
+}
+
+// Each tree keeps the node with the lightest outgoing arc.
+static void graph_boruvka_elect(void *arg, size_t tid, size_t threads)
+{
+    graph_boruvka_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 1024, &first, &last)) {
+        for (uint64_t u = first; u < last; u++) {
+            uint64_t best = ctx->best_arc[u];
+            uint64_t root = ctx->parent[u];
+            if (best == FOSSIL_GRAPH_NO_NODE)
+                continue;
+
+            for (;;) {
+                uint64_t holder = graph_atomic_load(&ctx->candidate[root]);
+                if (holder != FOSSIL_GRAPH_NO_NODE &&
+                    !graph_boruvka_less(ctx, u, best, holder, ctx->best_arc[holder]))
+                    break;
+                if (graph_atomic_cas(&ctx->candidate[root], holder, u))
+                    break;
+            }
+        }
+    }
+}
+
+static void graph_boruvka_select(void *arg, size_t tid, size_t threads)
+{
+    graph_boruvka_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 1024, &first, &last)) {
+        for (uint64_t root = first; root < last; root++) {
+            uint64_t u = ctx->candidate[root];
+            if (ctx->parent[root] != root || u == FOSSIL_GRAPH_NO_NODE)
+                continue;
+
+            // Skip the pair when the other tree picked the same edge and has the smaller root
+            uint64_t e = ctx->best_arc[u];
+            uint64_t other = ctx->parent[ctx->adj->targets[e]];
+            uint64_t mirror = ctx->candidate[other];
+            if (other < root && mirror != FOSSIL_GRAPH_NO_NODE &&
+                !graph_boruvka_less(ctx, u, e, mirror, ctx->best_arc[mirror]) &&
+                !graph_boruvka_less(ctx, mirror, ctx->best_arc[mirror], u, e))
+                continue;
+
+            ctx->chosen[graph_atomic_add(&ctx->chosen_count, 1)] = u;
+        }
+    }
+}
+
+static void graph_boruvka_link(void *arg, size_t tid, size_t threads)
+{
+    graph_boruvka_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->chosen_count, 256, &first, &last)) {
+        for (uint64_t i = first; i < last; i++) {
+            uint64_t u = ctx->chosen[i];
+            graph_cc_link(ctx->parent, u, ctx->adj->targets[ctx->best_arc[u]]);
+        }
+    }
+}
+
+static int graph_mst_boruvka(fossil_graph_t *graph, graph_mst_out_t *out)
+{
+    size_t n = graph->node_count;
+    graph_boruvka_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.adj = graph_out(graph);
+    ctx.node_count = n;
+    ctx.out = out;
+    ctx.parent = malloc(n * sizeof(uint64_t));
+    ctx.candidate = malloc(n * sizeof(uint64_t));
+    ctx.best_arc = malloc(n * sizeof(uint64_t));
+    ctx.chosen = malloc(n * sizeof(uint64_t));
+    if (!ctx.parent || !ctx.candidate || !ctx.best_arc || !ctx.chosen) {
+        free((void *)ctx.parent);
+        free((void *)ctx.candidate);
+        free(ctx.best_arc);
+        free(ctx.chosen);
+        return -1;
+    }
+    for (uint64_t v = 0; v < n; v++) {
+        ctx.parent[v] = v;
+        ctx.candidate[v] = FOSSIL_GRAPH_NO_NODE;
+    }
+
+    graph_cc_ctx_t compress;
+    memset(&compress, 0, sizeof(compress));
+    compress.graph = graph;
+    compress.parent = ctx.parent;
+
+    graph_pool_t *pool = graph_pool_create(graph_thread_count());
+    for (;;) {
+        ctx.cursor = 0;
+        graph_pool_run(pool, graph_boruvka_scan, &ctx);
+        ctx.cursor = 0;
+        graph_pool_run(pool, graph_boruvka_elect, &ctx);
+        ctx.cursor = 0;
+        ctx.chosen_count = 0;
+        graph_pool_run(pool, graph_boruvka_select, &ctx);
+        if (ctx.chosen_count == 0)
+            break;
+
+        // The chosen edges form a forest over the current trees
+        for (uint64_t i = 0; i < ctx.chosen_count; i++) {
+            uint64_t u = ctx.chosen[i];
+            uint64_t e = ctx.best_arc[u];
+            graph_mst_emit(out, u, ctx.adj->targets[e], ctx.adj->weights[e]);
+        }
+
+        ctx.cursor = 0;
+        graph_pool_run(pool, graph_boruvka_link, &ctx);
+        compress.cursor = 0;
+        graph_pool_run(pool, graph_cc_compress, &compress);
+        for (uint64_t v = 0; v < n; v++)
+            ctx.candidate[v] = FOSSIL_GRAPH_NO_NODE;
+    }
+    graph_pool_destroy(pool);
+
+    free((void *)ctx.parent);
+    free((void *)ctx.candidate);
+    free(ctx.best_arc);
+    free(ctx.chosen);
+    return 0;
+}
+
+typedef int (*graph_mst_fn)(fossil_graph_t *, graph_mst_out_t *);
+
+static graph_mst_fn graph_mst_select(const char *algorithm_id)
+{
+    if (algorithm_equals(algorithm_id, "mst-kruskal"))
+        return graph_mst_kruskal;
+    if (algorithm_equals(algorithm_id, "mst-prim"))
+        return graph_mst_prim;
+    if (algorithm_equals(algorithm_id, "mst-boruvka"))
+        return graph_mst_boruvka;
+    return NULL;
+}
+
+// Reports start's tree in breadth-first order over the MST edges.
+static int
+graph_exec_mst(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t start,
+    fossil_graph_visit_fn visit,
+    void *user
+) {
+    size_t n = graph->node_count;
+    fossil_graph_edge_t *edges = malloc(n * sizeof(fossil_graph_edge_t));
+    if (!edges)
+        return -1;
+
+    size_t count = 0;
+    int result = fossil_algorithm_graph_mst(graph, algorithm_id, edges, &count, NULL);
+    if (result == 0 && visit) {
+        fossil_graph_t *tree = fossil_algorithm_graph_create(n, false, true);
+        if (!tree || fossil_algorithm_graph_build(tree, edges, count) != 0)
+            result = -1;
+        else
+            result = graph_bfs(tree, start, visit, user);
+        fossil_algorithm_graph_destroy(tree);
+    }
+
+    free(edges);
+    return result;
+}
+
+// ======================================================
+// Point-to-Point Routing
+// ======================================================
+
+typedef int (*graph_route_fn)(
+    fossil_graph_t *, uint64_t, uint64_t, fossil_graph_heuristic_fn, void *,
+    uint64_t *, size_t *, double *);
+
+/*
+ * A*: the open set is the indexed heap keyed by g + h, settled nodes go
+ * into a closed bitset and are never reopened, so h must be consistent
+ * (h(u) <= w(u, v) + h(v)) for the returned path to be optimal. A NULL
+ * heuristic degenerates to Dijkstra with early exit.
+ */
+static int
+graph_astar(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    fossil_graph_heuristic_fn h,
+    void *user,
+    uint64_t *path,
+    size_t *path_length,
+    double *cost
+) {
+    size_t n = graph->node_count;
+    double *g = malloc(n * sizeof(double));
+    uint64_t *pred = malloc(n * sizeof(uint64_t));
+    uint64_t *closed = calloc(graph_bit_words(n), sizeof(uint64_t));
+    graph_heap_t open;
+    bool open_ok = graph_heap_init(&open, n);
+    if (!g || !pred || !closed || !open_ok) {
+        free(g);
+        free(pred);
+        free(closed);
+        if (open_ok)
+            graph_heap_free(&open);
+        return -1;
+    }
+
+    for (size_t v = 0; v < n; v++) {
+        g[v] = DBL_MAX;
+        pred[v] = FOSSIL_GRAPH_NO_NODE;
+    }
+    g[start] = 0.0;
+    graph_heap_push(&open, start, h ? h(start, target, user) : 0.0);
+
+    const fossil_graph_adj_t *out = graph_out(graph);
+    while (open.size > 0) {
+        double f;
+        uint64_t u = graph_heap_pop(&open, &f);
+        if (u == target)
+            break;
+        graph_bit_set(closed, u);
+
+        uint64_t begin, end;
+        graph_adj_range(out, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t v = out->targets[e];
+            if (graph_bit_test(closed, v))
+                continue;
+            double alt = g[u] + out->weights[e];
+            if (alt < g[v]) {
+                g[v] = alt;
+                pred[v] = u;
+                graph_heap_push(&open, v, alt + (h ? h(v, target, user) : 0.0));
+            }
+        }
+    }
+
+    int result = g[target] == DBL_MAX ? -1 : 0;
+    if (result == 0) {
+        graph_write_path(pred, start, target, path, path_length);
+        if (cost)
+            *cost = g[target];
+    }
+
+    free(g);
+    free(pred);
+    free(closed);
+    graph_heap_free(&open);
+    return result;
+}
+
+// Writes start ... meet from pred and meet ... target from succ.
+static void
+graph_write_meeting_path(
+    const uint64_t *pred,
+    const uint64_t *succ,
+    uint64_t start,
+    uint64_t meet,
+    uint64_t target,
+    uint64_t *path,
+    size_t *path_length
+) {
+    size_t head;
+    graph_write_path(pred, start, meet, path, &head);
+
+    size_t length = head;
+    for (uint64_t v = meet; v != target; v = succ[v]) {
+        if (path)
+            path[length] = succ[v];
+        length++;
+    }
+    if (path_length)
+        *path_length = length;
+}
+
+/*
+ * Bidirectional Dijkstra: forward over out-arcs from start, backward
+ * over in-arcs from target, always advancing the side with the smaller
+ * heap top. mu is the best start -> target length seen so far through
+ * a node labelled by both sides; once top_f + top_b >= mu no shorter
+ * path can exist.
+ */
+static int
+graph_bidirectional_dijkstra(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    fossil_graph_heuristic_fn h,
+    void *user,
+    uint64_t *path,
+    size_t *path_length,
+    double *cost
+) {
+    (void)h;
+    (void)user;
+    size_t n = graph->node_count;
+    bool ok = true;
+    const fossil_graph_adj_t *adj[2] = {graph_out(graph), graph_reverse(graph, &ok)};
+    double *dist[2] = {malloc(n * sizeof(double)), malloc(n * sizeof(double))};
+    uint64_t *link[2] = {malloc(n * sizeof(uint64_t)), malloc(n * sizeof(uint64_t))};
+    graph_heap_t heap[2];
+    bool heap_ok[2] = {graph_heap_init(&heap[0], n), graph_heap_init(&heap[1], n)};
+
+    int result = -1;
+    if (ok && dist[0] && dist[1] && link[0] && link[1] && heap_ok[0] && heap_ok[1]) {
+        for (size_t v = 0; v < n; v++) {
+            dist[0][v] = dist[1][v] = DBL_MAX;
+            link[0][v] = link[1][v] = FOSSIL_GRAPH_NO_NODE;
+        }
+        dist[0][start] = 0.0;
+        dist[1][target] = 0.0;
+        graph_heap_push(&heap[0], start, 0.0);
+        graph_heap_push(&heap[1], target, 0.0);
+
+        double mu = start == target ? 0.0 : DBL_MAX;
+        uint64_t meet = start == target ? start : FOSSIL_GRAPH_NO_NODE;
+
+        while (heap[0].size > 0 && heap[1].size > 0 &&
+               heap[0].data[0].key + heap[1].data[0].key < mu) {
+            int side = heap[0].data[0].key <= heap[1].data[0].key ? 0 : 1;
+            double d;
+            uint64_t u = graph_heap_pop(&heap[side], &d);
+
+            uint64_t begin, end;
+            graph_adj_range(adj[side], u, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                uint64_t v = adj[side]->targets[e];
+                double alt = d + adj[side]->weights[e];
+                if (!(alt < dist[side][v]))
+                    continue;
+                dist[side][v] = alt;
+                link[side][v] = u;
+                graph_heap_push(&heap[side], v, alt);
+
+                if (dist[!side][v] != DBL_MAX && alt + dist[!side][v] < mu) {
+                    mu = alt + dist[!side][v];
+                    meet = v;
+                }
+            }
+        }
+
+        if (meet != FOSSIL_GRAPH_NO_NODE) {
+            graph_write_meeting_path(link[0], link[1], start, meet, target, path, path_length);
+            if (cost)
+                *cost = mu;
+            result = 0;
+        }
+    }
+
+    for (int side = 0; side < 2; side++) {
+        free(dist[side]);
+        free(link[side]);
+        if (heap_ok[side])
+            graph_heap_free(&heap[side]);
+    }
+    return result;
+}
+
+/*
+ * Bidirectional BFS on hop counts: each step expands one whole level of
+ * the side with the smaller frontier. The first level that touches the
+ * other side's labels contains the shortest meeting, so the search
+ * stops after finishing it.
+ */
+static int
+graph_bidirectional_bfs(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    fossil_graph_heuristic_fn h,
+    void *user,
+    uint64_t *path,
+    size_t *path_length,
+    double *cost
+) {
+    (void)h;
+    (void)user;
+    size_t n = graph->node_count;
+    bool ok = true;
+    const fossil_graph_adj_t *adj[2] = {graph_out(graph), graph_reverse(graph, &ok)};
+    uint64_t *depth[2] = {malloc(n * sizeof(uint64_t)), malloc(n * sizeof(uint64_t))};
+    uint64_t *link[2] = {malloc(n * sizeof(uint64_t)), malloc(n * sizeof(uint64_t))};
+    uint64_t *queue[2] = {malloc(n * sizeof(uint64_t)), malloc(n * sizeof(uint64_t))};
+
+    int result = -1;
+    if (ok && depth[0] && depth[1] && link[0] && link[1] && queue[0] && queue[1]) {
+        for (size_t v = 0; v < n; v++) {
+            depth[0][v] = depth[1][v] = FOSSIL_GRAPH_NO_NODE;
+            link[0][v] = link[1][v] = FOSSIL_GRAPH_NO_NODE;
+        }
+        depth[0][start] = 0;
+        depth[1][target] = 0;
+        queue[0][0] = start;
+        queue[1][0] = target;
+
+        // Each queue holds its side's nodes in BFS order; [head, tail) is the frontier
+        size_t head[2] = {0, 0}, tail[2] = {1, 1};
+        uint64_t best = start == target ? 0 : FOSSIL_GRAPH_NO_NODE;
+        uint64_t meet = start == target ? start : FOSSIL_GRAPH_NO_NODE;
+
+        while (meet == FOSSIL_GRAPH_NO_NODE && head[0] < tail[0] && head[1] < tail[1]) {
+            int side = tail[0] - head[0] <= tail[1] - head[1] ? 0 : 1;
+            size_t level_end = tail[side];
+
+            for (; head[side] < level_end; head[side]++) {
+                uint64_t u = queue[side][head[side]];
+                uint64_t begin, end;
+                graph_adj_range(adj[side], u, &begin, &end);
+                for (uint64_t e = begin; e < end; e++) {
+                    uint64_t v = adj[side]->targets[e];
+                    if (depth[side][v] != FOSSIL_GRAPH_NO_NODE)
+                        continue;
+                    depth[side][v] = depth[side][u] + 1;
+                    link[side][v] = u;
+                    queue[side][tail[side]++] = v;
+
+                    if (depth[!side][v] != FOSSIL_GRAPH_NO_NODE &&
+                        depth[side][v] + depth[!side][v] < best) {
+                        best = depth[side][v] + depth[!side][v];
+                        meet = v;
+                    }
+                }
+            }
+        }
+
+        if (meet != FOSSIL_GRAPH_NO_NODE) {
+            graph_write_meeting_path(link[0], link[1], start, meet, target, path, path_length);
+            if (cost)
+                *cost = (double)best;
+            result = 0;
+        }
+    }
+
+    for (int side = 0; side < 2; side++) {
+        free(depth[side]);
+        free(link[side]);
+        free(queue[side]);
+    }
+    return result;
+}
+
+static graph_route_fn graph_route_select(const char *algorithm_id)
+{
+    if (algorithm_equals(algorithm_id, "astar"))
+        return graph_astar;
+    if (algorithm_equals(algorithm_id, "bidirectional-dijkstra"))
+        return graph_bidirectional_dijkstra;
+    if (algorithm_equals(algorithm_id, "bidirectional-bfs"))
+        return graph_bidirectional_bfs;
+    return NULL;
+}
+
+// Exec runs routes without a heuristic and visits the path.
+static int
+graph_exec_route(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t start,
+    uint64_t target,
+    fossil_graph_visit_fn visit,
+    void *user
+) {
+    uint64_t *path = malloc(graph->node_count * sizeof(uint64_t));
+    if (!path)
+        return -1;
+
+    size_t length = 0;
+    int result = fossil_algorithm_graph_route(
+        graph, algorithm_id, start, target, NULL, NULL, path, &length, NULL);
+    if (result == 0 && visit) {
+        for (size_t i = 0; i < length && visit(path[i], user); i++)
+            ;
+    }
+
+    free(path);
+    return result;
+}
+
+// ======================================================
+// Contraction Hierarchies
+// ======================================================
+
+/*
+ * Nodes are contracted one at a time in order of increasing edge
+ * difference; contracting v adds a shortcut u -> x for every pair of
+ * live neighbors whose shortest u -> x path runs through v. A query
+ * then only ever climbs to higher-ranked nodes, from the start along
+ * up-arcs and from the target backwards along down-arcs, which keeps
+ * both search spaces tiny on road-like graphs.
+ */
+struct fossil_graph_ch {
+    size_t             node_count;
+    size_t             up_count;
+    size_t             down_count;
+    fossil_graph_adj_t up;        // u -> x with x ranked above u
+    fossil_graph_adj_t down;      // at x: every u of u -> x with u ranked above x
+    uint64_t          *up_mid;    // contracted middle node, NO_NODE for input arcs
+    uint64_t          *down_mid;
+    void              *mapping;   // file view when loaded, NULL when owned
+    size_t             mapping_size;
+};
+
+typedef struct graph_ch_header {
+    char     magic[8];      // "FOSSILCH"
+    uint64_t byte_order;    // GRAPH_FILE_ORDER as written
+    uint64_t version;
+    uint64_t node_count;
+    uint64_t up_count;
+    uint64_t down_count;
+    uint64_t reserved[2];
+} graph_ch_header_t;
+
+#define GRAPH_CH_VERSION 1
+
+// Settled-node budget of one witness search. Giving up early only adds
+// shortcuts that were not strictly needed; queries stay exact.
+#define GRAPH_CH_WITNESS_LIMIT 500
+
+typedef struct graph_ch_arc {
+    uint64_t node;
+    uint64_t mid;
+    double   weight;
+} graph_ch_arc_t;
+
+typedef struct graph_ch_list {
+    graph_ch_arc_t *data;
+    size_t size;
+    size_t capacity;
+} graph_ch_list_t;
+
+// Lowers the arc to node to weight, or appends it.
+static bool graph_ch_list_relax(graph_ch_list_t *list, uint64_t node, double weight, uint64_t mid)
+{
+    for (size_t i = 0; i < list->size; i++) {
+        if (list->data[i].node != node)
+            continue;
+        if (weight < list->data[i].weight) {
+            list->data[i].weight = weight;
+            list->data[i].mid = mid;
+        }
+        return true;
+    }
+
+    if (list->size == list->capacity) {
+        size_t capacity = list->capacity ? 2 * list->capacity : 4;
+        graph_ch_arc_t *data = realloc(list->data, capacity * sizeof(*data));
+        if (!data)
+            return false;
+        list->data = data;
+        list->capacity = capacity;
+    }
+    list->data[list->size].node = node;
+    list->data[list->size].mid = mid;
+    list->data[list->size].weight = weight;
+    list->size++;
+    return true;
+}
+
+// Drops the arc to node; list order does not matter.
+static void graph_ch_list_remove(graph_ch_list_t *list, uint64_t node)
+{
+    for (size_t i = 0; i < list->size; i++) {
+        if (list->data[i].node == node) {
+            list->data[i] = list->data[--list->size];
+            return;
+        }
+    }
+}
+
+/*
+ * Preprocessing state: a mutable copy of the graph as in- and out-lists.
+ * Live nodes only list arcs to live nodes; a contracted node keeps its
+ * lists as they were at contraction time, which are exactly its arcs
+ * into the higher-ranked remainder. The witness search scratch space
+ * is reset through its touched list.
+ */
+typedef struct graph_ch_builder {
+    size_t           n;
+    graph_ch_list_t *out;
+    graph_ch_list_t *in;
+    uint64_t        *retired;     // contracted neighbors per node
+    double          *dist;
+    uint64_t        *touched;
+    size_t           touched_count;
+    uint64_t        *target;      // == stamp for the current search's targets
+    uint64_t         stamp;
+    graph_heap_t     heap;
+} graph_ch_builder_t;
+
+/*
+ * Bounded Dijkstra from source over live nodes other than skip. It ends
+ * once the stamped targets are settled, the bound is passed, or the
+ * settle budget runs out.
+ */
+static void
+graph_ch_witness(
+    graph_ch_builder_t *b,
+    uint64_t source,
+    uint64_t skip,
+    double bound,
+    size_t targets
+) {
+    for (size_t i = 0; i < b->touched_count; i++)
+        b->dist[b->touched[i]] = DBL_MAX;
+    b->touched_count = 0;
+    graph_heap_clear(&b->heap);
+
+    b->dist[source] = 0.0;
+    b->touched[b->touched_count++] = source;
+    graph_heap_push(&b->heap, source, 0.0);
+
+    for (size_t settled = 0; b->heap.size > 0 && settled < GRAPH_CH_WITNESS_LIMIT; settled++) {
+        double d;
+        uint64_t u = graph_heap_pop(&b->heap, &d);
+        if (d > bound)
+            break;
+        if (b->target[u] == b->stamp && --targets == 0)
+            break;
+
+        const graph_ch_list_t *out = &b->out[u];
+        for (size_t i = 0; i < out->size; i++) {
+            uint64_t x = out->data[i].node;
+            double alt = d + out->data[i].weight;
+            if (x == skip || alt > bound || !(alt < b->dist[x]))
+                continue;
+            if (b->dist[x] == DBL_MAX)
+                b->touched[b->touched_count++] = x;
+            b->dist[x] = alt;
+            graph_heap_push(&b->heap, x, alt);
+        }
+    }
+}
+
+/*
+ * Counts the shortcuts contracting v needs and, when apply is set,
+ * inserts them. Returns false only on allocation failure.
+ */
+static bool graph_ch_contract(graph_ch_builder_t *b, uint64_t v, bool apply, size_t *shortcuts)
+{
+    const graph_ch_list_t *in = &b->in[v];
+    const graph_ch_list_t *out = &b->out[v];
+    *shortcuts = 0;
+    if (in->size == 0 || out->size == 0)
+        return true;
+
+    double max_out = 0.0;
+    b->stamp++;
+    for (size_t j = 0; j < out->size; j++) {
+        b->target[out->data[j].node] = b->stamp;
+        if (out->data[j].weight > max_out)
+            max_out = out->data[j].weight;
+    }
+
+    for (size_t i = 0; i < in->size; i++) {
+        uint64_t u = in->data[i].node;
+        double w1 = in->data[i].weight;
+        graph_ch_witness(b, u, v, w1 + max_out, out->size);
+
+        for (size_t j = 0; j < out->size; j++) {
+            uint64_t x = out->data[j].node;
+            double via = w1 + out->data[j].weight;
+            if (x == u || b->dist[x] <= via)
+                continue;
+
+            (*shortcuts)++;
+            if (apply && (!graph_ch_list_relax(&b->out[u], x, via, v) ||
+                          !graph_ch_list_relax(&b->in[x], u, via, v)))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Edge difference plus the number of already contracted neighbors,
+// which spreads contractions evenly over the graph.
+static bool graph_ch_priority(graph_ch_builder_t *b, uint64_t v, double *priority)
+{
+    size_t shortcuts;
+    if (!graph_ch_contract(b, v, false, &shortcuts))
+        return false;
+
+    double degree = (double)(b->in[v].size + b->out[v].size);
+    *priority = (double)shortcuts - degree + (double)b->retired[v];
+    return true;
+}
+
+// Removes v from its neighbors' lists, freezing v's own.
+static void graph_ch_retire(graph_ch_builder_t *b, uint64_t v)
+{
+    for (size_t i = 0; i < b->in[v].size; i++) {
+        uint64_t u = b->in[v].data[i].node;
+        graph_ch_list_remove(&b->out[u], v);
+        b->retired[u]++;
+    }
+    for (size_t i = 0; i < b->out[v].size; i++) {
+        uint64_t x = b->out[v].data[i].node;
+        graph_ch_list_remove(&b->in[x], v);
+        b->retired[x]++;
+    }
+}
+
+// Flattens the frozen per-node lists into a CSR.
+static bool
+graph_ch_export(
+    const graph_ch_builder_t *b,
+    const graph_ch_list_t *lists,
+    fossil_graph_adj_t *adj,
+    uint64_t **mid,
+    size_t *count
+) {
+    size_t n = b->n;
+    adj->offsets = malloc((n + 1) * sizeof(uint64_t));
+    if (!adj->offsets)
+        return false;
+
+    size_t total = 0;
+    for (size_t v = 0; v < n; v++) {
+        adj->offsets[v] = total;
+        total += lists[v].size;
+    }
+    adj->offsets[n] = total;
+
+    adj->targets = malloc((total ? total : 1) * sizeof(uint64_t));
+    adj->weights = malloc((total ? total : 1) * sizeof(double));
+    *mid = malloc((total ? total : 1) * sizeof(uint64_t));
+    if (!adj->targets || !adj->weights || !*mid)
+        return false;
+
+    for (size_t v = 0; v < n; v++) {
+        uint64_t slot = adj->offsets[v];
+        for (size_t i = 0; i < lists[v].size; i++, slot++) {
+            adj->targets[slot] = lists[v].data[i].node;
+            adj->weights[slot] = lists[v].data[i].weight;
+            (*mid)[slot] = lists[v].data[i].mid;
+        }
+    }
+    *count = total;
+    return true;
+}
+
+static void graph_ch_free(fossil_graph_ch_t *ch)
+{
+    if (!ch) return;
+    if (ch->mapping) {
+        graph_file_unmap(ch->mapping, ch->mapping_size);
+    } else {
+        adj_free(&ch->up);
+        adj_free(&ch->down);
+        free(ch->up_mid);
+        free(ch->down_mid);
+    }
+    free(ch);
+}
+
+static void graph_ch_builder_free(graph_ch_builder_t *b)
+{
+    for (size_t v = 0; b->out && v < b->n; v++)
+        free(b->out[v].data);
+    for (size_t v = 0; b->in && v < b->n; v++)
+        free(b->in[v].data);
+    free(b->out);
+    free(b->in);
+    free(b->retired);
+    free(b->dist);
+    free(b->touched);
+    free(b->target);
+}
+
+static int graph_ch_build(fossil_graph_t *graph, fossil_graph_ch_t **out)
+{
+    size_t n = graph->node_count;
+    size_t alloc = n ? n : 1;
+    graph_ch_builder_t b;
+    memset(&b, 0, sizeof(b));
+    b.n = n;
+    b.out = calloc(alloc, sizeof(*b.out));
+    b.in = calloc(alloc, sizeof(*b.in));
+    b.retired = calloc(alloc, sizeof(uint64_t));
+    b.dist = malloc(alloc * sizeof(double));
+    b.touched = malloc(alloc * sizeof(uint64_t));
+    b.target = calloc(alloc, sizeof(uint64_t));
+
+    graph_heap_t order;
+    bool heaps = graph_heap_init(&b.heap, alloc);
+    bool order_ok = graph_heap_init(&order, alloc);
+    fossil_graph_ch_t *ch = calloc(1, sizeof(*ch));
+
+    bool ok = heaps && order_ok && ch && b.out && b.in && b.retired && b.dist && b.touched && b.target;
+    if (ok) {
+        for (size_t v = 0; v < n; v++)
+            b.dist[v] = DBL_MAX;
+
+        // Self-loops never lie on a shortest path; parallel arcs keep the lightest
+        const fossil_graph_adj_t *adj = graph_out(graph);
+        for (uint64_t u = 0; ok && u < n; u++) {
+            uint64_t begin, end;
+            graph_adj_range(adj, u, &begin, &end);
+            for (uint64_t e = begin; ok && e < end; e++) {
+                uint64_t x = adj->targets[e];
+                if (x != u)
+                    ok = graph_ch_list_relax(&b.out[u], x, adj->weights[e], FOSSIL_GRAPH_NO_NODE) &&
+                         graph_ch_list_relax(&b.in[x], u, adj->weights[e], FOSSIL_GRAPH_NO_NODE);
+            }
+        }
+
+        for (uint64_t v = 0; ok && v < n; v++) {
+            double priority;
+            ok = graph_ch_priority(&b, v, &priority);
+            if (ok)
+                graph_heap_push(&order, v, priority);
+        }
+
+        // Lazy updates: a node whose fresh priority no longer beats the
+        // next candidate goes back into the queue
+        while (ok && order.size > 0) {
+            double key, priority;
+            uint64_t v = graph_heap_pop(&order, &key);
+            ok = graph_ch_priority(&b, v, &priority);
+            if (!ok)
+                break;
+            if (order.size > 0 && priority > order.data[0].key) {
+                graph_heap_push(&order, v, priority);
+                continue;
+            }
+
+            size_t shortcuts;
+            ok = graph_ch_contract(&b, v, true, &shortcuts);
+            graph_ch_retire(&b, v);
+        }
+    }
+
+    if (ok) {
+        ch->node_count = n;
+        ok = graph_ch_export(&b, b.out, &ch->up, &ch->up_mid, &ch->up_count) &&
+             graph_ch_export(&b, b.in, &ch->down, &ch->down_mid, &ch->down_count);
+    }
+
+    graph_ch_builder_free(&b);
+    if (heaps)
+        graph_heap_free(&b.heap);
+    if (order_ok)
+        graph_heap_free(&order);
+    if (!ok) {
+        graph_ch_free(ch);
+        return -1;
+    }
+    *out = ch;
+    return 0;
+}
+
+/*
+ * Lazy binary heap for queries. Stale entries are skipped on pop, so
+ * nothing proportional to node_count has to be initialised per query.
+ */
+typedef struct graph_ch_queue {
+    graph_heap_entry_t *data;
+    size_t size;
+    size_t capacity;
+} graph_ch_queue_t;
+
+static bool graph_ch_queue_push(graph_ch_queue_t *queue, uint64_t node, double key)
+{
+    if (queue->size == queue->capacity) {
+        size_t capacity = queue->capacity ? 2 * queue->capacity : 64;
+        graph_heap_entry_t *data = realloc(queue->data, capacity * sizeof(*data));
+        if (!data)
+            return false;
+        queue->data = data;
+        queue->capacity = capacity;
+    }
+
+    size_t i = queue->size++;
+    while (i > 0 && queue->data[(i - 1) / 2].key > key) {
+        queue->data[i] = queue->data[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    queue->data[i].key = key;
+    queue->data[i].node = node;
+    return true;
+}
+
+static graph_heap_entry_t graph_ch_queue_pop(graph_ch_queue_t *queue)
+{
+    graph_heap_entry_t top = queue->data[0];
+    graph_heap_entry_t item = queue->data[--queue->size];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= queue->size)
+            break;
+        if (child + 1 < queue->size && queue->data[child + 1].key < queue->data[child].key)
+            child++;
+        if (queue->data[child].key >= item.key)
+            break;
+        queue->data[i] = queue->data[child];
+        i = child;
+    }
+    if (queue->size > 0)
+        queue->data[i] = item;
+    return top;
+}
+
+// Per-side query state; dist/pred/arc are valid where the seen bit is set.
+typedef struct graph_ch_side {
+    const fossil_graph_adj_t *adj;
+    uint64_t *seen;
+    double   *dist;
+    uint64_t *pred;
+    uint64_t *arc;
+    graph_ch_queue_t queue;
+} graph_ch_side_t;
+
+// Middle node of the hierarchy arc from -> to.
+static uint64_t graph_ch_mid(const fossil_graph_ch_t *ch, uint64_t from, uint64_t to)
+{
+    for (uint64_t e = ch->up.offsets[from]; e < ch->up.offsets[from + 1]; e++)
+        if (ch->up.targets[e] == to)
+            return ch->up_mid[e];
+    for (uint64_t e = ch->down.offsets[to]; e < ch->down.offsets[to + 1]; e++)
+        if (ch->down.targets[e] == from)
+            return ch->down_mid[e];
+    return FOSSIL_GRAPH_NO_NODE;
+}
+
+typedef struct graph_ch_span {
+    uint64_t from;
+    uint64_t to;
+    uint64_t mid;
+} graph_ch_span_t;
+
+typedef struct graph_ch_spans {
+    graph_ch_span_t *data;
+    size_t size;
+    size_t capacity;
+} graph_ch_spans_t;
+
+static bool graph_ch_spans_push(graph_ch_spans_t *spans, uint64_t from, uint64_t to, uint64_t mid)
+{
+    if (spans->size == spans->capacity) {
+        size_t capacity = spans->capacity ? 2 * spans->capacity : 64;
+        graph_ch_span_t *data = realloc(spans->data, capacity * sizeof(*data));
+        if (!data)
+            return false;
+        spans->data = data;
+        spans->capacity = capacity;
+    }
+    spans->data[spans->size].from = from;
+    spans->data[spans->size].to = to;
+    spans->data[spans->size].mid = mid;
+    spans->size++;
+    return true;
+}
+
+/*
+ * Expands the hierarchy path through meet into input arcs: shortcuts
+ * are split at their middle node on an explicit stack until only
+ * original arcs remain, emitted in start -> target order.
+ */
+static bool
+graph_ch_unpack(
+    const fossil_graph_ch_t *ch,
+    const graph_ch_side_t *side,
+    uint64_t start,
+    uint64_t meet,
+    uint64_t target,
+    uint64_t *path,
+    size_t *path_length
+) {
+    graph_ch_spans_t stack = {NULL, 0, 0};
+    bool ok = true;
+
+    // Backward half first, target end deepest, so the stack pops in order
+    for (uint64_t v = meet; ok && v != target; v = side[1].pred[v])
+        ok = graph_ch_spans_push(&stack, v, side[1].pred[v], ch->down_mid[side[1].arc[v]]);
+    for (size_t i = 0, j = stack.size; ok && i + 1 < j; i++, j--) {
+        graph_ch_span_t swap = stack.data[i];
+        stack.data[i] = stack.data[j - 1];
+        stack.data[j - 1] = swap;
+    }
+    for (uint64_t v = meet; ok && v != start; v = side[0].pred[v])
+        ok = graph_ch_spans_push(&stack, side[0].pred[v], v, ch->up_mid[side[0].arc[v]]);
+
+    size_t length = 1;
+    if (path)
+        path[0] = start;
+    while (ok && stack.size > 0) {
+        graph_ch_span_t span = stack.data[--stack.size];
+        if (span.mid == FOSSIL_GRAPH_NO_NODE) {
+            // Zero-weight cycles could repeat nodes; never write past node_count
+            if (path && length < ch->node_count)
+                path[length] = span.to;
+            length++;
+            continue;
+        }
+        ok = graph_ch_spans_push(&stack, span.mid, span.to, graph_ch_mid(ch, span.mid, span.to)) &&
+             graph_ch_spans_push(&stack, span.from, span.mid, graph_ch_mid(ch, span.from, span.mid));
+    }
+
+    free(stack.data);
+    if (ok && path_length)
+        *path_length = length;
+    return ok;
+}
+
+static int
+graph_ch_query(
+    const fossil_graph_ch_t *ch,
+    uint64_t start,
+    uint64_t target,
+    uint64_t *path,
+    size_t *path_length,
+    double *cost
+) {
+    size_t n = ch->node_count;
+    graph_ch_side_t side[2];
+    bool ok = true;
+    for (int s = 0; s < 2; s++) {
+        // calloc/malloc of large blocks hand out untouched pages, so the
+        // cost follows the search space rather than node_count
+        side[s].adj = s == 0 ? &ch->up : &ch->down;
+        side[s].seen = calloc(graph_bit_words(n), sizeof(uint64_t));
+        side[s].dist = malloc(n * sizeof(double));
+        side[s].pred = malloc(n * sizeof(uint64_t));
+        side[s].arc = malloc(n * sizeof(uint64_t));
+        side[s].queue.data = NULL;
+        side[s].queue.size = side[s].queue.capacity = 0;
+        ok = ok && side[s].seen && side[s].dist && side[s].pred && side[s].arc;
+    }
+
+    uint64_t source[2] = {start, target};
+    for (int s = 0; ok && s < 2; s++) {
+        graph_bit_set(side[s].seen, source[s]);
+        side[s].dist[source[s]] = 0.0;
+        side[s].pred[source[s]] = FOSSIL_GRAPH_NO_NODE;
+        ok = graph_ch_queue_push(&side[s].queue, source[s], 0.0);
+    }
+
+    double mu = start == target ? 0.0 : DBL_MAX;
+    uint64_t meet = start == target ? start : FOSSIL_GRAPH_NO_NODE;
+
+    // Each side stops once its smallest key reaches mu
+    while (ok) {
+        bool live[2];
+        for (int s = 0; s < 2; s++)
+            live[s] = side[s].queue.size > 0 && side[s].queue.data[0].key < mu;
+        if (!live[0] && !live[1])
+            break;
+        int s = !live[1] || (live[0] && side[0].queue.data[0].key <= side[1].queue.data[0].key) ? 0 : 1;
+        graph_ch_side_t *self = &side[s], *other = &side[!s];
+
+        graph_heap_entry_t top = graph_ch_queue_pop(&self->queue);
+        uint64_t u = top.node;
+        if (top.key > self->dist[u])
+            continue;
+
+        for (uint64_t e = self->adj->offsets[u]; ok && e < self->adj->offsets[u + 1]; e++) {
+            uint64_t v = self->adj->targets[e];
+            double alt = top.key + self->adj->weights[e];
+            if (graph_bit_test(self->seen, v) && !(alt < self->dist[v]))
+                continue;
+            graph_bit_set(self->seen, v);
+            self->dist[v] = alt;
+            self->pred[v] = u;
+            self->arc[v] = e;
+            ok = graph_ch_queue_push(&self->queue, v, alt);
+
+            if (graph_bit_test(other->seen, v) && alt + other->dist[v] < mu) {
+                mu = alt + other->dist[v];
+                meet = v;
+            }
+        }
+    }
+
+    int result = -1;
+    if (ok && meet != FOSSIL_GRAPH_NO_NODE) {
+        if (path || path_length)
+            ok = graph_ch_unpack(ch, side, start, meet, target, path, path_length);
+        if (ok) {
+            if (cost)
+                *cost = mu;
+            result = 0;
+        }
+    }
+
+    for (int s = 0; s < 2; s++) {
+        free(side[s].seen);
+        free(side[s].dist);
+        free(side[s].pred);
+        free(side[s].arc);
+        free(side[s].queue.data);
+    }
+    return result;
+}
+
+static int graph_ch_save(const fossil_graph_ch_t *ch, const char *file_path)
+{
+    FILE *file = fopen(file_path, "wb");
+    if (!file)
+        return -1;
+
+    graph_ch_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "FOSSILCH", 8);
+    header.byte_order = GRAPH_FILE_ORDER;
+    header.version = GRAPH_CH_VERSION;
+    header.node_count = ch->node_count;
+    header.up_count = ch->up_count;
+    header.down_count = ch->down_count;
+
+    size_t n = ch->node_count;
+    bool ok = graph_file_section(file, &header, sizeof(header)) &&
+              graph_file_section(file, ch->up.offsets, (n + 1) * sizeof(uint64_t)) &&
+              graph_file_section(file, ch->up.targets, ch->up_count * sizeof(uint64_t)) &&
+              graph_file_section(file, ch->up.weights, ch->up_count * sizeof(double)) &&
+              graph_file_section(file, ch->up_mid, ch->up_count * sizeof(uint64_t)) &&
+              graph_file_section(file, ch->down.offsets, (n + 1) * sizeof(uint64_t)) &&
+              graph_file_section(file, ch->down.targets, ch->down_count * sizeof(uint64_t)) &&
+              graph_file_section(file, ch->down.weights, ch->down_count * sizeof(double)) &&
+              graph_file_section(file, ch->down_mid, ch->down_count * sizeof(uint64_t));
+    if (fclose(file) != 0)
+        ok = false;
+    return ok ? 0 : -1;
+}
+
+// Points adj and mid into the mapped file at *offset and advances it.
+static void
+graph_ch_attach(
+    unsigned char *base,
+    size_t *offset,
+    size_t n,
+    size_t count,
+    fossil_graph_adj_t *adj,
+    uint64_t **mid
+) {
+    adj->offsets = (uint64_t *)(void *)(base + *offset);
+    *offset += graph_file_align((n + 1) * sizeof(uint64_t));
+    adj->targets = (uint64_t *)(void *)(base + *offset);
+    *offset += graph_file_align(count * sizeof(uint64_t));
+    adj->weights = (double *)(void *)(base + *offset);
+    *offset += graph_file_align(count * sizeof(double));
+    *mid = (uint64_t *)(void *)(base + *offset);
+    *offset += graph_file_align(count * sizeof(uint64_t));
+}
+
+static int graph_ch_load(const char *file_path, fossil_graph_ch_t **out)
+{
+    void *base;
+    size_t size;
+    if (!graph_file_map(file_path, &base, &size))
+        return -1;
+
+    // Every count is bounded by the file size before any size arithmetic
+    graph_ch_header_t header;
+    bool valid = size >= sizeof(header);
+    if (valid) {
+        memcpy(&header, base, sizeof(header));
+        size_t limit = size / sizeof(uint64_t);
+        valid = memcmp(header.magic, "FOSSILCH", 8) == 0 &&
+                header.byte_order == GRAPH_FILE_ORDER &&
+                header.version == GRAPH_CH_VERSION &&
+                header.node_count < limit && header.up_count < limit && header.down_count < limit;
+    }
+    if (valid) {
+        size_t n = (size_t)header.node_count;
+        size_t need = graph_file_align(sizeof(header)) +
+                      2 * graph_file_align((n + 1) * sizeof(uint64_t)) +
+                      3 * graph_file_align((size_t)header.up_count * sizeof(uint64_t)) +
+                      3 * graph_file_align((size_t)header.down_count * sizeof(uint64_t));
+        valid = need <= size;
+    }
+
+    fossil_graph_ch_t *ch = valid ? calloc(1, sizeof(*ch)) : NULL;
+    if (!ch) {
+        graph_file_unmap(base, size);
+        return valid ? -1 : -2;
+    }
+
+    ch->node_count = (size_t)header.node_count;
+    ch->up_count = (size_t)header.up_count;
+    ch->down_count = (size_t)header.down_count;
+    ch->mapping = base;
+    ch->mapping_size = size;
+
+    size_t offset = graph_file_align(sizeof(header));
+    graph_ch_attach(base, &offset, ch->node_count, ch->up_count, &ch->up, &ch->up_mid);
+    graph_ch_attach(base, &offset, ch->node_count, ch->down_count, &ch->down, &ch->down_mid);
+
+    size_t n = ch->node_count;
+    if (ch->up.offsets[0] != 0 || ch->up.offsets[n] != ch->up_count ||
+        ch->down.offsets[0] != 0 || ch->down.offsets[n] != ch->down_count) {
+        graph_ch_free(ch);
+        return -2;
+    }
+
+    *out = ch;
+    return 0;
+}
+
+// ======================================================
+// PageRank
+// ======================================================
+
+/*
+ * Pull-based power iteration over the in-adjacency. Every node sums
+ * rank[u] / outdeg(u) over its in-arcs, so each thread only writes its
+ * own nodes. Dangling mass is spread over the teleport set. When the
+ * contribution vector outgrows GRAPH_PR_BLOCK_BYTES, the sources are
+ * cut into cache-sized segments and each segment's arcs are pulled in a
+ * separate pass. The random reads then stay inside one segment.
+ *
+ * Sums are reduced per fixed chunk of nodes, so results do not depend
+ * on the thread count.
+ */
+#define GRAPH_PR_BLOCK_BYTES ((size_t)1 << 20)
+#define GRAPH_PR_CHUNK 4096
+
+// In-arcs [begin, end) of node whose sources all lie in one segment.
+typedef struct graph_pr_run {
+    uint64_t node;
+    uint64_t begin;
+    uint64_t end;
+} graph_pr_run_t;
+
+typedef struct graph_pr_ctx {
+    const fossil_graph_adj_t *out;
+    const fossil_graph_adj_t *in;
+    size_t                n;
+    bool                  f32;
+    double                damping;
+    const uint64_t       *seed;      // teleport bitset, NULL for uniform
+    double                base;      // teleport term of this iteration
+    void                 *rank;
+    void                 *next;
+    void                 *contrib;
+    void                 *acc;       // segment sums, NULL when not blocked
+    double               *partial;   // one slot per GRAPH_PR_CHUNK nodes
+    const graph_pr_run_t *runs;
+    size_t                run_count;
+    uint64_t              cursor;
+} graph_pr_ctx_t;
+
+static inline double graph_pr_get(const void *values, uint64_t i, bool f32)
+{
+    return f32 ? (double)((const float *)values)[i] : ((const double *)values)[i];
+}
+
+static inline void graph_pr_set(void *values, uint64_t i, double x, bool f32)
+{
+    if (f32)
+        ((float *)values)[i] = (float)x;
+    else
+        ((double *)values)[i] = x;
+}
+
+// contrib = rank / outdeg; dangling rank is summed per chunk.
+static void graph_pr_contrib(void *arg, size_t tid, size_t threads)
+{
+    graph_pr_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->n, GRAPH_PR_CHUNK, &first, &last)) {
+        double dangling = 0.0;
+        for (uint64_t u = first; u < last; u++) {
+            double r = graph_pr_get(ctx->rank, u, ctx->f32);
+            uint64_t begin, end;
+            graph_adj_range(ctx->out, u, &begin, &end);
+            uint64_t degree = end - begin;
+            if (degree == 0)
+                dangling += r;
+            graph_pr_set(ctx->contrib, u, degree ? r / (double)degree : 0.0, ctx->f32);
+            if (ctx->acc)
+                graph_pr_set(ctx->acc, u, 0.0, ctx->f32);
+        }
+        ctx->partial[first / GRAPH_PR_CHUNK] = dangling;
+    }
+}
+
+// Pulls one segment. A chunk is widened to whole nodes so that all runs
+// of a node are summed by the same thread.
+static void graph_pr_segment(void *arg, size_t tid, size_t threads)
+{
+    graph_pr_ctx_t *ctx = arg;
+    const graph_pr_run_t *runs = ctx->runs;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->run_count, 1024, &first, &last)) {
+        while (first > 0 && first < last && runs[first].node == runs[first - 1].node)
+            first++;
+        while (last < ctx->run_count && runs[last].node == runs[last - 1].node)
+            last++;
+
+        for (uint64_t i = first; i < last;) {
+            uint64_t v = runs[i].node;
+            double sum = 0.0;
+            for (; i < last && runs[i].node == v; i++)
+                for (uint64_t e = runs[i].begin; e < runs[i].end; e++)
+                    sum += graph_pr_get(ctx->contrib, ctx->in->targets[e], ctx->f32);
+            graph_pr_set(ctx->acc, v, graph_pr_get(ctx->acc, v, ctx->f32) + sum, ctx->f32);
+        }
+    }
+}
+
+// next = damping * pulled + teleport; the L1 change is summed per chunk.
+static void graph_pr_update(void *arg, size_t tid, size_t threads)
+{
+    graph_pr_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->n, GRAPH_PR_CHUNK, &first, &last)) {
+        double residual = 0.0;
+        for (uint64_t v = first; v < last; v++) {
+            double sum = 0.0;
+            if (ctx->acc) {
+                sum = graph_pr_get(ctx->acc, v, ctx->f32);
+            } else {
+                uint64_t begin, end;
+                graph_adj_range(ctx->in, v, &begin, &end);
+                for (uint64_t e = begin; e < end; e++)
+                    sum += graph_pr_get(ctx->contrib, ctx->in->targets[e], ctx->f32);
+            }
+
+            double value = ctx->damping * sum;
+            if (!ctx->seed || graph_bit_test(ctx->seed, v))
+                value += ctx->base;
+            graph_pr_set(ctx->next, v, value, ctx->f32);
+
+            double delta = value - graph_pr_get(ctx->rank, v, ctx->f32);
+            residual += delta < 0.0 ? -delta : delta;
+        }
+        ctx->partial[first / GRAPH_PR_CHUNK] = residual;
+    }
+}
+
+/*
+ * Splits every in-list into runs of sources from the same segment and
+ * groups the runs by segment, nodes ascending. segment_start receives
+ * segments + 1 offsets into the returned array.
+ */
+static graph_pr_run_t *
+graph_pr_runs(
+    const fossil_graph_adj_t *in,
+    size_t n,
+    size_t block,
+    size_t segments,
+    size_t *segment_start
+) {
+    memset(segment_start, 0, (segments + 1) * sizeof(size_t));
+    for (uint64_t v = 0; v < n; v++) {
+        uint64_t begin, end;
+        graph_adj_range(in, v, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            size_t seg = (size_t)(in->targets[e] / block);
+            if (e == begin || seg != in->targets[e - 1] / block)
+                segment_start[seg + 1]++;
+        }
+    }
+    for (size_t s = 0; s < segments; s++)
+        segment_start[s + 1] += segment_start[s];
+
+    size_t total = segment_start[segments];
+    graph_pr_run_t *runs = malloc((total ? total : 1) * sizeof(*runs));
+    size_t *fill = malloc(segments * sizeof(size_t));
+    if (!runs || !fill) {
+        free(runs);
+        free(fill);
+        return NULL;
+    }
+    memcpy(fill, segment_start, segments * sizeof(size_t));
+
+    for (uint64_t v = 0; v < n; v++) {
+        uint64_t begin, end;
+        graph_adj_range(in, v, &begin, &end);
+        for (uint64_t e = begin; e < end;) {
+            size_t seg = (size_t)(in->targets[e] / block);
+            graph_pr_run_t *run = &runs[fill[seg]++];
+            run->node = v;
+            run->begin = e;
+            while (e < end && in->targets[e] / block == seg)
+                e++;
+            run->end = e;
+        }
+    }
+    free(fill);
+    return runs;
+}
+
+// Sums the per-chunk partials in chunk order.
+static double graph_pr_reduce(const double *partial, size_t chunks)
+{
+    double sum = 0.0;
+    for (size_t c = 0; c < chunks; c++)
+        sum += partial[c];
+    return sum;
+}
+
+static int
+graph_pagerank(
+    fossil_graph_t *graph,
+    bool f32,
+    const uint64_t *seeds,
+    size_t seed_count,
+    double damping,
+    double tolerance,
+    size_t max_iterations,
+    void *rank,
+    size_t *iterations,
+    fossil_graph_metric_fn metric,
+    void *user
+) {
+    size_t n = graph->node_count;
+    size_t elem = f32 ? sizeof(float) : sizeof(double);
+    size_t chunks = (n + GRAPH_PR_CHUNK - 1) / GRAPH_PR_CHUNK;
+    size_t block = GRAPH_PR_BLOCK_BYTES / elem;
+    size_t segments = n > block ? (n + block - 1) / block : 0;
+
+    graph_pr_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    bool ok;
+    ctx.in = graph_reverse(graph, &ok);
+    ctx.out = graph_out(graph);
+    ctx.n = n;
+    ctx.f32 = f32;
+    ctx.damping = damping;
+    ctx.next = malloc(n * elem);
+    ctx.contrib = malloc(n * elem);
+    ctx.partial = malloc(chunks * sizeof(double));
+    uint64_t *seed = seeds ? calloc(graph_bit_words(n), sizeof(uint64_t)) : NULL;
+    size_t *segment_start = segments ? malloc((segments + 1) * sizeof(size_t)) : NULL;
+    graph_pr_run_t *runs = NULL;
+    if (segments) {
+        ctx.acc = malloc(n * elem);
+        runs = segment_start ? graph_pr_runs(ctx.in, n, block, segments, segment_start) : NULL;
+    }
+    ok = ok && ctx.next && ctx.contrib && ctx.partial && (!seeds || seed) &&
+         (!segments || (ctx.acc && runs));
+
+    // Teleport mass per node: uniform, or shared by the distinct seeds
+    double teleport = 1.0 / (double)n;
+    if (ok && seeds) {
+        size_t distinct = 0;
+        for (size_t i = 0; i < seed_count; i++) {
+            if (!graph_bit_test(seed, seeds[i])) {
+                graph_bit_set(seed, seeds[i]);
+                distinct++;
+            }
+        }
+        teleport = 1.0 / (double)distinct;
+        ctx.seed = seed;
+    }
+
+    graph_pool_t *pool = ok ? graph_pool_create(graph_thread_count()) : NULL;
+    int result = -1;
+    size_t done = 0;
+    if (ok) {
+        ctx.rank = rank;
+        for (uint64_t v = 0; v < n; v++)
+            graph_pr_set(ctx.rank, v, !seed || graph_bit_test(seed, v) ? teleport : 0.0, f32);
+
+        while (done < max_iterations) {
+            ctx.cursor = 0;
+            graph_pool_run(pool, graph_pr_contrib, &ctx);
+            double dangling = graph_pr_reduce(ctx.partial, chunks);
+            ctx.base = teleport * ((1.0 - damping) + damping * dangling);
+
+            for (size_t s = 0; s < segments; s++) {
+                ctx.runs = runs + segment_start[s];
+                ctx.run_count = segment_start[s + 1] - segment_start[s];
+                ctx.cursor = 0;
+                graph_pool_run(pool, graph_pr_segment, &ctx);
+            }
+
+            ctx.cursor = 0;
+            graph_pool_run(pool, graph_pr_update, &ctx);
+            double residual = graph_pr_reduce(ctx.partial, chunks);
+
+            void *swap = ctx.rank;
+            ctx.rank = ctx.next;
+            ctx.next = swap;
+            done++;
+
+            if (residual < tolerance || (metric && !metric(done, residual, user))) {
+                result = 0;
+                break;
+            }
+        }
+        if (tolerance <= 0.0)
+            result = 0;
+
+        // The scratch buffer may hold the final iterate
+        if (ctx.rank != rank) {
+            memcpy(rank, ctx.rank, n * elem);
+            ctx.next = ctx.rank;
+        }
+        if (iterations)
+            *iterations = done;
+    }
+
+    graph_pool_destroy(pool);
+    free(ctx.next);
+    free(ctx.contrib);
+    free(ctx.acc);
+    free(ctx.partial);
+    free(seed);
+    free(segment_start);
+    free(runs);
+    return result;
+}
+
+typedef struct graph_pr_order {
+    double   rank;
+    uint64_t node;
+} graph_pr_order_t;
+
+static int graph_pr_order_compare(const void *a, const void *b)
+{
+    const graph_pr_order_t *x = a, *y = b;
+    if (x->rank != y->rank)
+        return x->rank < y->rank ? 1 : -1;
+    return (x->node > y->node) - (x->node < y->node);
+}
+
+// Exec reports every node by descending rank, ties by id.
+static int
+graph_exec_pagerank(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t start,
+    fossil_graph_visit_fn visit,
+    void *user
+) {
+    size_t n = graph->node_count;
+    bool personal = algorithm_equals(algorithm_id, "ppr");
+    double *rank = malloc(n * sizeof(double));
+    graph_pr_order_t *order = malloc(n * sizeof(*order));
+    int result = -1;
+    if (rank && order)
+        result = graph_pagerank(graph, false, personal ? &start : NULL, personal ? 1 : 0,
+                                0.85, 1e-6, 100, rank, NULL, NULL, NULL);
+    if (result == 0) {
+        for (uint64_t v = 0; v < n; v++) {
+            order[v].rank = rank[v];
+            order[v].node = v;
+        }
+        qsort(order, n, sizeof(*order), graph_pr_order_compare);
+        for (size_t i = 0; visit && i < n; i++)
+            if (!visit(order[i].node, user))
+                break;
+    }
+    free(rank);
+    free(order);
+    return result;
+}
+
+// ======================================================
+// k-Core Decomposition
+// ======================================================
+
+/*
+ * Core numbers on the undirected view of the graph: out- plus in-arcs,
+ * self-loops ignored, parallel edges counted once per copy.
+ * Batagelj-Zaversnik keeps the nodes in an array sorted by current
+ * degree with the start of every degree bin, so taking the minimum and
+ * demoting a neighbor are O(1) swaps and the whole run is O(V + E).
+ *
+ * The parallel variant peels one level k in rounds: every node of
+ * degree <= k leaves at once and neighbors that drop to k form the next
+ * round. Rounds are appended to the order sorted by id, so the order
+ * does not depend on the thread count.
+ */
+#define GRAPH_CORE_NONE  UINT64_MAX
+#define GRAPH_CORE_BATCH 64
+
+typedef struct graph_core_ctx {
+    const fossil_graph_adj_t *adj[2];   // out, plus in for directed graphs
+    size_t    node_count;
+    uint64_t *degree;
+    uint64_t *core;         // GRAPH_CORE_NONE until peeled
+    uint64_t *order;        // peeled nodes; also holds the rounds
+    uint64_t  round_begin;
+    uint64_t  round_end;
+    uint64_t  tail;         // next free order slot
+    uint64_t  level;
+    uint64_t  cursor;
+} graph_core_ctx_t;
+
+static void graph_core_degrees(void *arg, size_t tid, size_t threads)
+{
+    graph_core_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 1024, &first, &last)) {
+        for (uint64_t v = first; v < last; v++) {
+            uint64_t degree = 0;
+            for (int a = 0; a < 2; a++) {
+                uint64_t begin, end;
+                graph_adj_range(ctx->adj[a], v, &begin, &end);
+                for (uint64_t e = begin; e < end; e++)
+                    degree += ctx->adj[a]->targets[e] != v;
+            }
+            ctx->degree[v] = degree;
+        }
+    }
+}
+
+// Batagelj-Zaversnik; degree becomes the core numbers.
+static bool graph_core_bz(graph_core_ctx_t *ctx)
+{
+    size_t n = ctx->node_count;
+    uint64_t *degree = ctx->degree, *vert = ctx->order;
+    uint64_t max_degree = 0;
+    for (size_t v = 0; v < n; v++)
+        if (degree[v] > max_degree)
+            max_degree = degree[v];
+
+    uint64_t *bin = calloc((size_t)max_degree + 1, sizeof(uint64_t));
+    uint64_t *pos = malloc(n * sizeof(uint64_t));
+    if (!bin || !pos) {
+        free(bin);
+        free(pos);
+        return false;
+    }
+
+    for (size_t v = 0; v < n; v++)
+        bin[degree[v]]++;
+    uint64_t start = 0;
+    for (uint64_t d = 0; d <= max_degree; d++) {
+        uint64_t size = bin[d];
+        bin[d] = start;
+        start += size;
+    }
+    for (uint64_t v = 0; v < n; v++) {
+        pos[v] = bin[degree[v]]++;
+        vert[pos[v]] = v;
+    }
+    for (uint64_t d = max_degree; d > 0; d--)
+        bin[d] = bin[d - 1];
+    bin[0] = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t v = vert[i];
+        for (int a = 0; a < 2; a++) {
+            uint64_t begin, end;
+            graph_adj_range(ctx->adj[a], v, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                uint64_t u = ctx->adj[a]->targets[e];
+                if (u == v || degree[u] <= degree[v])
+                    continue;
+                // Swap u with the first node of its bin, then shrink the bin
+                uint64_t du = degree[u], pu = pos[u], pw = bin[du], w = vert[pw];
+                if (u != w) {
+                    pos[u] = pw;
+                    vert[pu] = w;
+                    pos[w] = pu;
+                    vert[pw] = u;
+                }
+                bin[du]++;
+                degree[u]--;
+            }
+        }
+    }
+    free(bin);
+    free(pos);
+    return true;
+}
+
+// Peels the current round; nodes that drop to the level join the next.
+static void graph_core_peel(void *arg, size_t tid, size_t threads)
+{
+    graph_core_ctx_t *ctx = arg;
+    uint64_t level = ctx->level, batch[GRAPH_CORE_BATCH], first, last;
+    size_t size = 0;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->round_end - ctx->round_begin, 64, &first, &last)) {
+        for (uint64_t i = first; i < last; i++) {
+            uint64_t v = ctx->order[ctx->round_begin + i];
+            for (int a = 0; a < 2; a++) {
+                uint64_t begin, end;
+                graph_adj_range(ctx->adj[a], v, &begin, &end);
+                for (uint64_t e = begin; e < end; e++) {
+                    uint64_t u = ctx->adj[a]->targets[e];
+                    if (u == v || graph_atomic_load(&ctx->core[u]) != GRAPH_CORE_NONE)
+                        continue;
+                    // Exactly one thread sees u pass level + 1 on its way down
+                    if (graph_atomic_add(&ctx->degree[u], UINT64_MAX) != level + 1)
+                        continue;
+                    graph_atomic_store(&ctx->core[u], level);
+                    batch[size++] = u;
+                    if (size == GRAPH_CORE_BATCH) {
+                        uint64_t slot = graph_atomic_add(&ctx->tail, size);
+                        memcpy(ctx->order + slot, batch, size * sizeof(uint64_t));
+                        size = 0;
+                    }
+                }
+            }
+        }
+    }
+    if (size) {
+        uint64_t slot = graph_atomic_add(&ctx->tail, size);
+        memcpy(ctx->order + slot, batch, size * sizeof(uint64_t));
+    }
+}
+
+static bool graph_core_parallel(graph_core_ctx_t *ctx, graph_pool_t *pool)
+{
+    size_t n = ctx->node_count;
+    uint64_t *alive = malloc((n ? n : 1) * sizeof(uint64_t));
+    if (!alive)
+        return false;
+    for (uint64_t v = 0; v < n; v++) {
+        alive[v] = v;
+        ctx->core[v] = GRAPH_CORE_NONE;
+    }
+
+    // Each level rescans only the nodes still alive: O(V + E) in total
+    size_t alive_count = n;
+    ctx->tail = 0;
+    ctx->level = 0;
+    while (alive_count > 0) {
+        size_t kept = 0;
+        uint64_t low = UINT64_MAX;
+        for (size_t i = 0; i < alive_count; i++) {
+            uint64_t v = alive[i];
+            if (ctx->core[v] != GRAPH_CORE_NONE)
+                continue;
+            alive[kept++] = v;
+            if (ctx->degree[v] < low)
+                low = ctx->degree[v];
+        }
+        alive_count = kept;
+        if (alive_count == 0)
+            break;
+        if (low > ctx->level)
+            ctx->level = low;
+
+        // alive stays in id order, so the first round is already sorted
+        uint64_t begin = ctx->tail;
+        for (size_t i = 0; i < alive_count; i++) {
+            uint64_t v = alive[i];
+            if (ctx->degree[v] <= ctx->level) {
+                ctx->core[v] = ctx->level;
+                ctx->order[ctx->tail++] = v;
+            }
+        }
+        while (begin < ctx->tail) {
+            ctx->round_begin = begin;
+            ctx->round_end = ctx->tail;
+            ctx->cursor = 0;
+            graph_pool_run(pool, graph_core_peel, ctx);
+            qsort(ctx->order + ctx->round_end, (size_t)(ctx->tail - ctx->round_end),
+                  sizeof(uint64_t), graph_u64_compare);
+            begin = ctx->round_end;
+        }
+        ctx->level++;
+    }
+    free(alive);
+    return true;
+}
+
+/*
+ * Core numbers into core and the degeneracy order (peeling order, so
+ * core numbers never decrease along it) into order; either may be NULL.
+ */
+static int graph_kcore(fossil_graph_t *graph, bool parallel, uint64_t *core, uint64_t *order,
+                       uint64_t *degeneracy)
+{
+    size_t n = graph->node_count;
+    graph_core_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    bool ok = true;
+    ctx.node_count = n;
+    ctx.adj[0] = graph_out(graph);
+    ctx.adj[1] = graph->directed ? graph_reverse(graph, &ok) : NULL;
+    if (!ok)
+        return -1;
+
+    // Sequential peeling turns the degrees into the core numbers in place
+    uint64_t *degree = parallel ? NULL : core;
+    uint64_t *owned_degree = degree ? NULL : malloc((n ? n : 1) * sizeof(uint64_t));
+    uint64_t *owned_core = (parallel && !core) ? malloc((n ? n : 1) * sizeof(uint64_t)) : NULL;
+    uint64_t *owned_order = order ? NULL : malloc((n ? n : 1) * sizeof(uint64_t));
+    ctx.degree = degree ? degree : owned_degree;
+    ctx.core = parallel ? (core ? core : owned_core) : ctx.degree;
+    ctx.order = order ? order : owned_order;
+    if (!ctx.degree || !ctx.core || !ctx.order) {
+        free(owned_degree);
+        free(owned_core);
+        free(owned_order);
+        return -1;
+    }
+
+    graph_pool_t *pool = NULL;
+    if (parallel)
+        pool = graph_pool_create(graph_thread_count());
+    graph_pool_run(pool, graph_core_degrees, &ctx);
+    ok = parallel ? graph_core_parallel(&ctx, pool) : graph_core_bz(&ctx);
+    graph_pool_destroy(pool);
+
+    if (ok && degeneracy) {
+        // Core numbers never decrease along the order
+        *degeneracy = n ? ctx.core[ctx.order[n - 1]] : 0;
+    }
+    free(owned_degree);
+    free(owned_core);
+    free(owned_order);
+    return ok ? 0 : -1;
+}
+
+// Exec reports every node in degeneracy order.
+static int graph_exec_kcore(fossil_graph_t *graph, const char *algorithm_id,
+                            fossil_graph_visit_fn visit, void *user)
+{
+    size_t n = graph->node_count;
+    uint64_t *order = malloc(n * sizeof(uint64_t));
+    int result = order ? graph_kcore(graph, algorithm_equals(algorithm_id, "kcore-parallel"),
+                                     NULL, order, NULL) : -1;
+    for (size_t i = 0; result == 0 && visit && i < n; i++)
+        if (!visit(order[i], user))
+            break;
+    free(order);
+    return result;
+}
+
+// ======================================================
+// Reordering
+// ======================================================
+
+/*
+ * Locality orders over the undirected view of the graph (out- plus
+ * in-arcs). Each order fills perm[old_id] = new_id. Relabeling then
+ * rebuilds the CSR with sorted lists, so nodes that are visited together
+ * also sit together in memory.
+ */
+#define GRAPH_RCM_ROUNDS 8
+
+typedef struct graph_order_item {
+    uint64_t degree;
+    uint64_t node;
+} graph_order_item_t;
+
+typedef struct graph_order {
+    const fossil_graph_adj_t *out;
+    const fossil_graph_adj_t *in;     // NULL for undirected graphs
+    uint64_t                 *seen;   // BFS stamp, 0 = never reached
+    uint64_t                  stamp;
+    graph_order_item_t       *queue;
+} graph_order_t;
+
+static inline uint64_t graph_order_degree(const graph_order_t *ord, uint64_t v)
+{
+    uint64_t begin, end, degree;
+    graph_adj_range(ord->out, v, &begin, &end);
+    degree = end - begin;
+    graph_adj_range(ord->in, v, &begin, &end);
+    return degree + (end - begin);
+}
+
+static int graph_order_ascending(const void *a, const void *b)
+{
+    const graph_order_item_t *x = a, *y = b;
+    if (x->degree != y->degree)
+        return x->degree < y->degree ? -1 : 1;
+    return (x->node > y->node) - (x->node < y->node);
+}
+
+static int graph_order_descending(const void *a, const void *b)
+{
+    const graph_order_item_t *x = a, *y = b;
+    if (x->degree != y->degree)
+        return x->degree > y->degree ? -1 : 1;
+    return (x->node > y->node) - (x->node < y->node);
+}
+
+/*
+ * Breadth-first order of root's component into queue[first...]; returns
+ * the end index. With sorted, the neighbors found from each node are
+ * ordered by ascending degree (Cuthill-McKee). levels receives the
+ * number of BFS levels and last_level the index where the last begins.
+ */
+static size_t
+graph_order_bfs(
+    graph_order_t *ord,
+    uint64_t root,
+    size_t first,
+    bool sorted,
+    size_t *levels,
+    size_t *last_level
+) {
+    uint64_t stamp = ++ord->stamp;
+    graph_order_item_t *queue = ord->queue;
+    size_t head = first, tail = first;
+
+    queue[tail].degree = graph_order_degree(ord, root);
+    queue[tail++].node = root;
+    ord->seen[root] = stamp;
+    *levels = 0;
+
+    while (head < tail) {
+        size_t level_end = tail;
+        *last_level = head;
+        (*levels)++;
+        for (; head < level_end; head++) {
+            uint64_t u = queue[head].node;
+            size_t found = tail;
+            for (int side = 0; side < 2; side++) {
+                const fossil_graph_adj_t *adj = side ? ord->in : ord->out;
+                uint64_t begin, end;
+                graph_adj_range(adj, u, &begin, &end);
+                for (uint64_t e = begin; e < end; e++) {
+                    uint64_t v = adj->targets[e];
+                    if (ord->seen[v] == stamp)
+                        continue;
+                    ord->seen[v] = stamp;
+                    queue[tail].degree = graph_order_degree(ord, v);
+                    queue[tail++].node = v;
+                }
+            }
+            if (sorted && tail - found > 1)
+                qsort(queue + found, tail - found, sizeof(*queue), graph_order_ascending);
+        }
+    }
+    return tail;
+}
+
+/*
+ * George-Liu pseudo-peripheral node: restart from the smallest-degree
+ * node of the last level while that lengthens the BFS.
+ */
+static uint64_t graph_order_peripheral(graph_order_t *ord, uint64_t root, size_t first)
+{
+    size_t levels, last;
+    size_t end = graph_order_bfs(ord, root, first, false, &levels, &last);
+
+    for (size_t round = 0; round < GRAPH_RCM_ROUNDS; round++) {
+        graph_order_item_t best = ord->queue[last];
+        for (size_t i = last + 1; i < end; i++)
+            if (graph_order_ascending(&ord->queue[i], &best) < 0)
+                best = ord->queue[i];
+
+        size_t trial_levels, trial_last;
+        size_t trial_end = graph_order_bfs(ord, best.node, first, false, &trial_levels, &trial_last);
+        if (trial_levels <= levels)
+            break;
+        root = best.node;
+        levels = trial_levels;
+        last = trial_last;
+        end = trial_end;
+    }
+    return root;
+}
+
+static int graph_reorder(fossil_graph_t *graph, const char *algorithm_id, uint64_t *perm)
+{
+    size_t n = graph->node_count;
+    if (algorithm_equals(algorithm_id, "kcore")) {
+        // Degeneracy order: periphery first, densest core last
+        uint64_t *order = malloc(n * sizeof(uint64_t));
+        int result = order ? graph_kcore(graph, false, NULL, order, NULL) : -1;
+        if (result == 0)
+            for (size_t i = 0; i < n; i++)
+                perm[order[i]] = i;
+        free(order);
+        return result;
+    }
+
+    bool rcm = algorithm_equals(algorithm_id, "rcm");
+    bool bfs = algorithm_equals(algorithm_id, "bfs");
+
+    graph_order_t ord;
+    memset(&ord, 0, sizeof(ord));
+    bool ok;
+    ord.out = graph_out(graph);
+    ord.in = graph->directed ? graph_reverse(graph, &ok) : NULL;
+    if (!graph->directed)
+        ok = true;
+
+    graph_order_item_t *items = malloc(n * sizeof(*items));
+    ord.queue = malloc(n * sizeof(*ord.queue));
+    ord.seen = calloc(n, sizeof(uint64_t));
+    if (!ok || !items || !ord.queue || !ord.seen) {
+        free(items);
+        free(ord.queue);
+        free(ord.seen);
+        return -1;
+    }
+
+    for (uint64_t v = 0; v < n; v++) {
+        items[v].degree = graph_order_degree(&ord, v);
+        items[v].node = v;
+    }
+    qsort(items, n, sizeof(*items), rcm ? graph_order_ascending : graph_order_descending);
+
+    if (rcm || bfs) {
+        // One search per component, roots in degree order
+        size_t placed = 0, levels, last;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t root = items[i].node;
+            if (ord.seen[root])
+                continue;
+            if (rcm)
+                root = graph_order_peripheral(&ord, root, placed);
+            placed = graph_order_bfs(&ord, root, placed, rcm, &levels, &last);
+        }
+        for (size_t i = 0; i < n; i++)
+            perm[ord.queue[i].node] = rcm ? n - 1 - i : i;
+    } else {
+        for (size_t i = 0; i < n; i++)
+            perm[items[i].node] = i;
+    }
+
+    free(items);
+    free(ord.queue);
+    free(ord.seen);
+    return 0;
+}
+
+/*
+ * Moves every list to its new slot with renamed targets, then sorts the
+ * lists with counting-sort transposes: the transpose of a symmetric
+ * adjacency is itself with sorted lists; a directed graph is transposed
+ * twice and keeps the middle result as its in-adjacency.
+ */
+static int graph_relabel(const fossil_graph_t *graph, const uint64_t *perm, fossil_graph_t *result)
+{
+    size_t n = graph->node_count;
+    const fossil_graph_adj_t *out = graph_out(graph);
+    if (!out)
+        return 0;
+
+    fossil_graph_csr_t *csr = calloc(1, sizeof(*csr));
+    fossil_graph_adj_t moved;
+    memset(&moved, 0, sizeof(moved));
+    size_t arcs = graph->csr->edge_count;
+    if (csr) {
+        moved.offsets = calloc(n + 1, sizeof(uint64_t));
+        moved.targets = malloc((arcs ? arcs : 1) * sizeof(uint64_t));
+        moved.weights = out->weights ? malloc((arcs ? arcs : 1) * sizeof(double)) : NULL;
+    }
+    if (!csr || !moved.offsets || !moved.targets || (out->weights && !moved.weights)) {
+        adj_free(&moved);
+        free(csr);
+        return -1;
+    }
+
+    for (uint64_t u = 0; u < n; u++)
+        moved.offsets[perm[u] + 1] = graph_adj_degree(out, u);
+    for (size_t v = 0; v < n; v++)
+        moved.offsets[v + 1] += moved.offsets[v];
+    for (uint64_t u = 0; u < n; u++) {
+        uint64_t slot = moved.offsets[perm[u]];
+        uint64_t begin, end;
+        graph_adj_range(out, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++, slot++) {
+            moved.targets[slot] = perm[out->targets[e]];
+            if (moved.weights)
+                moved.weights[slot] = out->weights[e];
+        }
+    }
+
+    bool ok;
+    if (graph->directed)
+        ok = adj_transpose(n, &moved, &csr->in) && adj_transpose(n, &csr->in, &csr->out);
+    else
+        ok = adj_transpose(n, &moved, &csr->out);
+    adj_free(&moved);
+    if (!ok) {
+        csr_free(csr);
+        return -1;
+    }
+
+    csr->edge_count = arcs;
+    csr->negative = graph->csr->negative;
+    csr->integral = graph->csr->integral;
+    result->csr = csr;
+    return 0;
+}
+
+// ======================================================
+// Graph Files
+// ======================================================
+
+/*
+ * Layout after the header: out offsets, targets and weights, then the
+ * same three for the in-adjacency when GRAPH_FILE_REVERSE is set.
+ * Weight sections exist only for weighted graphs.
+ */
+typedef struct graph_file_header {
+    char     magic[8];      // "FOSSILGR"
+    uint64_t byte_order;    // GRAPH_FILE_ORDER as written
+    uint64_t version;
+    uint64_t node_count;
+    uint64_t arc_count;
+    uint64_t flags;
+    uint64_t reserved[2];
+} graph_file_header_t;
+
+#define GRAPH_FILE_VERSION  1
+#define GRAPH_FILE_DIRECTED UINT64_C(1)
+#define GRAPH_FILE_WEIGHTED UINT64_C(2)
+#define GRAPH_FILE_REVERSE  UINT64_C(4)
+#define GRAPH_FILE_NEGATIVE UINT64_C(8)
+#define GRAPH_FILE_INTEGRAL UINT64_C(16)
+
+// Offsets, targets and (when weighted) weights of one adjacency.
+static bool
+graph_file_adj(
+    FILE *file,
+    const fossil_graph_adj_t *adj,
+    const uint64_t *empty,
+    size_t n,
+    size_t arcs,
+    bool weighted
+) {
+    return graph_file_section(file, adj ? adj->offsets : empty, (n + 1) * sizeof(uint64_t)) &&
+           graph_file_section(file, adj ? adj->targets : NULL, arcs * sizeof(uint64_t)) &&
+           (!weighted || graph_file_section(file, adj ? adj->weights : NULL, arcs * sizeof(double)));
+}
+
+static int graph_file_save(fossil_graph_t *graph, const char *file_path, bool reverse)
+{
+    size_t n = graph->node_count;
+    bool ok;
+    reverse = reverse && graph->directed;
+    const fossil_graph_adj_t *in = reverse ? graph_reverse(graph, &ok) : NULL;
+    if (reverse && !ok)
+        return -1;
+
+    // Graphs that were never built are written with empty lists
+    uint64_t *empty = graph->csr ? NULL : calloc(n + 1, sizeof(uint64_t));
+    if (!graph->csr && !empty)
+        return -1;
+
+    FILE *file = fopen(file_path, "wb");
+    if (!file) {
+        free(empty);
+        return -1;
+    }
+
+    graph_file_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "FOSSILGR", 8);
+    header.byte_order = GRAPH_FILE_ORDER;
+    header.version = GRAPH_FILE_VERSION;
+    header.node_count = n;
+    header.arc_count = graph->csr ? graph->csr->edge_count : 0;
+    header.flags = (graph->directed ? GRAPH_FILE_DIRECTED : 0) |
+                   (graph->weighted ? GRAPH_FILE_WEIGHTED : 0) |
+                   (reverse ? GRAPH_FILE_REVERSE : 0) |
+                   (graph->csr && graph->csr->negative ? GRAPH_FILE_NEGATIVE : 0) |
+                   (!graph->csr || graph->csr->integral ? GRAPH_FILE_INTEGRAL : 0);
+
+    size_t arcs = (size_t)header.arc_count;
+    ok = graph_file_section(file, &header, sizeof(header)) &&
+         graph_file_adj(file, graph_out(graph), empty, n, arcs, graph->weighted) &&
+         (!reverse || graph_file_adj(file, in, empty, n, arcs, graph->weighted));
+    if (fclose(file) != 0)
+        ok = false;
+    free(empty);
+    return ok ? 0 : -1;
+}
+
+// Points adj into the mapped file at *offset and advances it.
+static void
+graph_file_attach(
+    unsigned char *base,
+    size_t *offset,
+    size_t n,
+    size_t arcs,
+    bool weighted,
+    fossil_graph_adj_t *adj
+) {
+    adj->offsets = (uint64_t *)(void *)(base + *offset);
+    *offset += graph_file_align((n + 1) * sizeof(uint64_t));
+    adj->targets = (uint64_t *)(void *)(base + *offset);
+    *offset += graph_file_align(arcs * sizeof(uint64_t));
+    adj->weights = NULL;
+    if (weighted) {
+        adj->weights = (double *)(void *)(base + *offset);
+        *offset += graph_file_align(arcs * sizeof(double));
+    }
+}
+
+static int graph_file_load(const char *file_path, fossil_graph_t **out)
+{
+    void *base;
+    size_t size;
+    if (!graph_file_map(file_path, &base, &size))
+        return -1;
+
+    // Every count is bounded by the file size before any size arithmetic
+    graph_file_header_t header;
+    bool valid = size >= sizeof(header);
+    if (valid) {
+        memcpy(&header, base, sizeof(header));
+        size_t limit = size / sizeof(uint64_t);
+        valid = memcmp(header.magic, "FOSSILGR", 8) == 0 &&
+                header.byte_order == GRAPH_FILE_ORDER &&
+                header.version == GRAPH_FILE_VERSION &&
+                header.node_count < limit && header.arc_count < limit;
+    }
+    bool weighted = valid && (header.flags & GRAPH_FILE_WEIGHTED);
+    bool reverse = valid && (header.flags & GRAPH_FILE_REVERSE);
+    if (valid) {
+        size_t n = (size_t)header.node_count;
+        size_t arcs = (size_t)header.arc_count;
+        size_t side = graph_file_align((n + 1) * sizeof(uint64_t)) +
+                      (weighted ? 2 : 1) * graph_file_align(arcs * sizeof(uint64_t));
+        valid = graph_file_align(sizeof(header)) + (reverse ? 2 : 1) * side <= size;
+    }
+
+    fossil_graph_t *graph = valid ? calloc(1, sizeof(*graph)) : NULL;
+    fossil_graph_csr_t *csr = graph ? calloc(1, sizeof(*csr)) : NULL;
+    if (!csr) {
+        free(graph);
+        graph_file_unmap(base, size);
+        return valid ? -1 : -2;
+    }
+
+    size_t n = (size_t)header.node_count;
+    graph->node_count = n;
+    graph->directed = (header.flags & GRAPH_FILE_DIRECTED) != 0;
+    graph->weighted = weighted;
+    graph->csr = csr;
+    csr->edge_count = (size_t)header.arc_count;
+    csr->negative = (header.flags & GRAPH_FILE_NEGATIVE) != 0;
+    csr->integral = (header.flags & GRAPH_FILE_INTEGRAL) != 0;
+    csr->mapping = base;
+    csr->mapping_size = size;
+    csr->in_mapped = reverse && graph->directed;
+
+    size_t offset = graph_file_align(sizeof(header));
+    graph_file_attach(base, &offset, n, csr->edge_count, weighted, &csr->out);
+    if (csr->in_mapped)
+        graph_file_attach(base, &offset, n, csr->edge_count, weighted, &csr->in);
+
+    if (csr->out.offsets[0] != 0 || csr->out.offsets[n] != csr->edge_count ||
+        (csr->in_mapped && (csr->in.offsets[0] != 0 || csr->in.offsets[n] != csr->edge_count))) {
+        fossil_algorithm_graph_destroy(graph);
+        return -2;
+    }
+
+    *out = graph;
+    return 0;
+}
+
+// ======================================================
+// Incremental Maintenance
+// ======================================================
+
+/*
+ * Repairs results of the previous graph after a batch of
+ * fossil_algorithm_graph_update, working on the updated graph and
+ * visiting only the region the batch can change.
+ *
+ * Components: every piece a component breaks into holds an endpoint
+ * of a deleted edge, so each endpoint is checked against the first
+ * endpoint seen with its id. The two searches take turns expanding a
+ * node and stay inside the id; meeting proves them joined, otherwise
+ * the search that runs dry first holds a whole piece, which takes a
+ * fresh id. Inserted edges then unite ids in a union-find by size and
+ * only the absorbed components are relabelled.
+ */
+typedef struct graph_cc_repair {
+    const fossil_graph_adj_t *adj[2];   // out, plus in for directed graphs
+    uint64_t *component;
+    uint64_t *sizes;
+    uint64_t *queue[2];
+    uint64_t *mark;         // search stamp per node, 0 when unseen
+    uint64_t  stamp;
+} graph_cc_repair_t;
+
+/*
+ * Alternating searches from u and v within their component. Returns the
+ * size of the piece cut off, left in queue[*side], or 0 when they meet.
+ */
+static size_t graph_cc_split(graph_cc_repair_t *r, uint64_t u, uint64_t v, int *side)
+{
+    uint64_t label = r->component[u];
+    uint64_t stamp[2] = { r->stamp + 1, r->stamp + 2 };
+    size_t head[2] = { 0, 0 }, tail[2] = { 1, 1 };
+    r->stamp += 2;
+    r->queue[0][0] = u;
+    r->queue[1][0] = v;
+    r->mark[u] = stamp[0];
+    r->mark[v] = stamp[1];
+
+    for (;;) {
+        for (int k = 0; k < 2; k++) {
+            if (head[k] == tail[k]) {
+                *side = k;
+                return tail[k];
+            }
+            uint64_t x = r->queue[k][head[k]++];
+            for (int a = 0; a < 2; a++) {
+                uint64_t begin, end;
+                graph_adj_range(r->adj[a], x, &begin, &end);
+                for (uint64_t e = begin; e < end; e++) {
+                    uint64_t y = r->adj[a]->targets[e];
+                    if (r->component[y] != label || r->mark[y] == stamp[k])
+                        continue;
+                    if (r->mark[y] == stamp[!k])
+                        return 0;
+                    r->mark[y] = stamp[k];
+                    r->queue[k][tail[k]++] = y;
+                }
+            }
+        }
+    }
+}
+
+// Moves the nodes labelled from that are connected to seed over to label.
+static void graph_cc_relabel(graph_cc_repair_t *r, uint64_t seed, uint64_t from, uint64_t label)
+{
+    size_t head = 0, tail = 1;
+    r->queue[0][0] = seed;
+    r->component[seed] = label;
+    while (head < tail) {
+        uint64_t x = r->queue[0][head++];
+        for (int a = 0; a < 2; a++) {
+            uint64_t begin, end;
+            graph_adj_range(r->adj[a], x, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                uint64_t y = r->adj[a]->targets[e];
+                if (r->component[y] == from) {
+                    r->component[y] = label;
+                    r->queue[0][tail++] = y;
+                }
+            }
+        }
+    }
+}
+
+// Union-find over component ids; parent[c] is 0 for roots, else parent + 1.
+static uint64_t graph_cc_root(uint64_t *parent, uint64_t c)
+{
+    while (parent[c]) {
+        uint64_t up = parent[c] - 1;
+        if (parent[up])
+            parent[c] = parent[up];
+        c = up;
+    }
+    return c;
+}
+
+static int
+graph_components_repair(
+    fossil_graph_t *graph,
+    const fossil_graph_edge_t *inserts,
+    size_t insert_count,
+    const fossil_graph_edge_t *deletes,
+    size_t delete_count,
+    uint64_t *component,
+    uint64_t *sizes,
+    size_t *component_count
+) {
+    size_t n = graph->node_count;
+    graph_cc_repair_t r;
+    memset(&r, 0, sizeof(r));
+    bool ok;
+    r.adj[0] = graph_out(graph);
+    r.adj[1] = graph->directed ? graph_reverse(graph, &ok) : NULL;
+    if (graph->directed && !ok)
+        return -1;
+    r.component = component;
+    r.sizes = sizes;
+
+    // Large blocks are mapped lazily, so untouched pages cost nothing
+    r.queue[0] = malloc(n * sizeof(uint64_t));
+    r.queue[1] = malloc(n * sizeof(uint64_t));
+    r.mark = calloc(n, sizeof(uint64_t));
+    uint64_t *parent = calloc(n, sizeof(uint64_t));   // checked endpoint + 1, then union-find
+    uint64_t *anchor = malloc(n * sizeof(uint64_t));
+    uint64_t *absorbed = malloc((insert_count ? insert_count : 1) * sizeof(uint64_t));
+    if (!r.queue[0] || !r.queue[1] || !r.mark || !parent || !anchor || !absorbed) {
+        free(r.queue[0]);
+        free(r.queue[1]);
+        free(r.mark);
+        free(parent);
+        free(anchor);
+        free(absorbed);
+        return -1;
+    }
+
+    size_t count = *component_count;
+    uint64_t fresh = 0;
+    for (size_t i = 0; i < 2 * delete_count; i++) {
+        uint64_t t = i & 1 ? deletes[i / 2].to : deletes[i / 2].from;
+        uint64_t label = component[t];
+        if (!parent[label]) {
+            parent[label] = t + 1;
+            continue;
+        }
+        uint64_t checked = parent[label] - 1;
+        int side;
+        size_t piece = t == checked ? 0 : graph_cc_split(&r, t, checked, &side);
+        if (piece == 0)
+            continue;
+
+        // A split leaves fewer than node_count components, so an id is free
+        while (sizes[fresh] != 0)
+            fresh++;
+        sizes[label] -= piece;
+        sizes[fresh] = piece;
+        for (size_t k = 0; k < piece; k++)
+            component[r.queue[side][k]] = fresh;
+        parent[fresh] = (side ? checked : t) + 1;
+        parent[label] = (side ? t : checked) + 1;
+        count++;
+    }
+    for (size_t i = 0; i < 2 * delete_count; i++) {
+        uint64_t t = i & 1 ? deletes[i / 2].to : deletes[i / 2].from;
+        parent[component[t]] = 0;
+    }
+
+    size_t absorbed_count = 0;
+    for (size_t i = 0; i < insert_count; i++) {
+        uint64_t u = inserts[i].from, v = inserts[i].to;
+        anchor[component[u]] = u;
+        anchor[component[v]] = v;
+        uint64_t a = graph_cc_root(parent, component[u]);
+        uint64_t b = graph_cc_root(parent, component[v]);
+        if (a == b)
+            continue;
+        if (sizes[a] < sizes[b] || (sizes[a] == sizes[b] && b < a)) {
+            uint64_t t = a;
+            a = b;
+            b = t;
+        }
+        parent[b] = a + 1;
+        sizes[a] += sizes[b];
+        absorbed[absorbed_count++] = b;
+    }
+    for (size_t i = 0; i < absorbed_count; i++) {
+        uint64_t b = absorbed[i];
+        graph_cc_relabel(&r, anchor[b], b, graph_cc_root(parent, b));
+        sizes[b] = 0;
+    }
+    *component_count = count - absorbed_count;
+
+    free(r.queue[0]);
+    free(r.queue[1]);
+    free(r.mark);
+    free(parent);
+    free(anchor);
+    free(absorbed);
+    return 0;
+}
+
+/*
+ * Shortest paths: nodes whose tree path used a deleted edge lose their
+ * distance and restart from their best unaffected in-neighbor; inserted
+ * edges relax their head. A Dijkstra pass from just those nodes then
+ * settles everything that changed.
+ */
+static void
+graph_sssp_cut(
+    const fossil_graph_adj_t *out,
+    const uint64_t *pred,
+    unsigned char *affected,
+    uint64_t root,
+    uint64_t *queue,
+    size_t *count
+) {
+    if (affected[root])
+        return;
+    size_t head = *count;
+    affected[root] = 1;
+    queue[(*count)++] = root;
+    while (head < *count) {
+        uint64_t y = queue[head++];
+        uint64_t begin, end;
+        graph_adj_range(out, y, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t x = out->targets[e];
+            if (!affected[x] && pred[x] == y) {
+                affected[x] = 1;
+                queue[(*count)++] = x;
+            }
+        }
+    }
+}
+
+// Relaxes u -> v and queues v when its distance drops.
+static inline bool
+graph_sssp_relax(
+    graph_ch_queue_t *queue,
+    double *dist,
+    uint64_t *pred,
+    uint64_t u,
+    uint64_t v,
+    double w
+) {
+    if (dist[u] == DBL_MAX || !(dist[u] + w < dist[v]))
+        return true;
+    dist[v] = dist[u] + w;
+    pred[v] = u;
+    return graph_ch_queue_push(queue, v, dist[v]);
+}
+
+static int
+graph_sssp_repair(
+    fossil_graph_t *graph,
+    const fossil_graph_edge_t *inserts,
+    size_t insert_count,
+    const fossil_graph_edge_t *deletes,
+    size_t delete_count,
+    double *dist,
+    uint64_t *pred
+) {
+    size_t n = graph->node_count;
+    bool ok;
+    const fossil_graph_adj_t *out = graph_out(graph);
+    const fossil_graph_adj_t *in = graph_reverse(graph, &ok);
+    unsigned char *affected = calloc(n, 1);
+    uint64_t *cut = malloc(n * sizeof(uint64_t));
+    graph_ch_queue_t queue;
+    memset(&queue, 0, sizeof(queue));
+    if (!ok || !affected || !cut) {
+        free(affected);
+        free(cut);
+        return -1;
+    }
+
+    // Roots: heads of deleted tree edges, judged on the old distances
+    size_t count = 0;
+    for (size_t i = 0; i < delete_count; i++) {
+        for (int k = 0; k < (graph->directed ? 1 : 2); k++) {
+            uint64_t u = k ? deletes[i].to : deletes[i].from;
+            uint64_t v = k ? deletes[i].from : deletes[i].to;
+            if (pred[v] == u && dist[u] != DBL_MAX && dist[u] + deletes[i].weight == dist[v])
+                graph_sssp_cut(out, pred, affected, v, cut, &count);
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        dist[cut[i]] = DBL_MAX;
+        pred[cut[i]] = FOSSIL_GRAPH_NO_NODE;
+    }
+    ok = true;
+    for (size_t i = 0; ok && i < count; i++) {
+        uint64_t x = cut[i], begin, end;
+        graph_adj_range(in, x, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t y = in->targets[e];
+            if (!affected[y] && dist[y] != DBL_MAX && dist[y] + in->weights[e] < dist[x]) {
+                dist[x] = dist[y] + in->weights[e];
+                pred[x] = y;
+            }
+        }
+        if (dist[x] != DBL_MAX)
+            ok = graph_ch_queue_push(&queue, x, dist[x]);
+    }
+
+    for (size_t i = 0; ok && i < insert_count; i++) {
+        const fossil_graph_edge_t *edge = &inserts[i];
+        ok = graph_sssp_relax(&queue, dist, pred, edge->from, edge->to, edge->weight);
+        if (ok && !graph->directed)
+            ok = graph_sssp_relax(&queue, dist, pred, edge->to, edge->from, edge->weight);
+    }
+
+    while (ok && queue.size > 0) {
+        graph_heap_entry_t top = graph_ch_queue_pop(&queue);
+        uint64_t u = top.node;
+        if (top.key > dist[u])
+            continue;
+        uint64_t begin, end;
+        graph_adj_range(out, u, &begin, &end);
+        for (uint64_t e = begin; ok && e < end; e++)
+            ok = graph_sssp_relax(&queue, dist, pred, u, out->targets[e], out->weights[e]);
+    }
+
+    free(queue.data);
+    free(affected);
+    free(cut);
+    return ok ? 0 : -1;
+}
+
+// ======================================================
+// Triangles
+// ======================================================
+
+/*
+ * Triangle counting on the undirected view of the graph (direction,
+ * self-loops and parallel edges ignored). Every edge is oriented from
+ * lower to higher (degree, id), which caps oriented out-degrees at
+ * O(sqrt(E)); each triangle is then found exactly once, at its lowest
+ * corner u, as a common entry of the oriented lists of u and v. Lists
+ * are sorted by id and stored as 32-bit ids whenever the node ids fit,
+ * so the intersection can compare 4x4 blocks with SSE2/NEON; lists of
+ * very different length are galloped instead.
+ */
+#define GRAPH_TRI_CHUNK 32
+#define GRAPH_TRI_SKEW  32    // gallop when one list is this much longer
+#define GRAPH_TRI_AHEAD 8     // lists prefetched ahead of the intersection
+
+typedef struct graph_tri_span {
+    uint64_t begin;
+    uint64_t end;
+} graph_tri_span_t;
+
+typedef struct graph_tri_ctx {
+    const fossil_graph_adj_t *adj[2];   // out, plus in for directed graphs
+    size_t    node_count;
+    size_t    max_degree;
+    uint64_t *scratch;      // max_degree entries per thread
+    uint64_t *offsets;      // slots reserved per oriented list
+    graph_tri_span_t *span; // oriented list v after deduplication
+    uint32_t *narrow;       // targets when node ids fit 32 bits
+    uint64_t *wide;         // targets otherwise
+    uint64_t *per_node;     // NULL unless counted per node
+    uint64_t *distinct;     // distinct neighbors, NULL unless needed
+    uint64_t  cursor;
+    uint64_t  total;
+} graph_tri_ctx_t;
+
+static inline uint64_t graph_tri_degree(const graph_tri_ctx_t *ctx, uint64_t v)
+{
+    return graph_adj_degree(ctx->adj[0], v) + graph_adj_degree(ctx->adj[1], v);
+}
+
+// True when edge u - v is oriented u -> v.
+static inline bool graph_tri_above(const graph_tri_ctx_t *ctx, uint64_t u, uint64_t v)
+{
+    uint64_t du = graph_tri_degree(ctx, u), dv = graph_tri_degree(ctx, v);
+    return dv > du || (dv == du && v > u);
+}
+
+// Sizes the oriented lists with duplicates: offsets[u + 1] = bound.
+static void graph_tri_bound(void *arg, size_t tid, size_t threads)
+{
+    graph_tri_ctx_t *ctx = arg;
+    uint64_t first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 1024, &first, &last)) {
+        for (uint64_t u = first; u < last; u++) {
+            uint64_t bound = 0;
+            for (int a = 0; a < 2; a++) {
+                uint64_t begin, end;
+                graph_adj_range(ctx->adj[a], u, &begin, &end);
+                for (uint64_t e = begin; e < end; e++)
+                    bound += graph_tri_above(ctx, u, ctx->adj[a]->targets[e]);
+            }
+            ctx->offsets[u + 1] = bound;
+        }
+    }
+}
+
+// Writes each oriented list sorted and without duplicates.
+static void graph_tri_fill(void *arg, size_t tid, size_t threads)
+{
+    graph_tri_ctx_t *ctx = arg;
+    uint64_t *list = ctx->scratch + tid * ctx->max_degree;
+    uint64_t first, last;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, 256, &first, &last)) {
+        for (uint64_t u = first; u < last; u++) {
+            size_t size = 0;
+            for (int a = 0; a < 2; a++) {
+                uint64_t begin, end;
+                graph_adj_range(ctx->adj[a], u, &begin, &end);
+                for (uint64_t e = begin; e < end; e++) {
+                    uint64_t v = ctx->adj[a]->targets[e];
+                    if (graph_tri_above(ctx, u, v))
+                        list[size++] = v;
+                }
+            }
+            bool sorted = true;
+            for (size_t i = 1; sorted && i < size; i++)
+                sorted = list[i - 1] < list[i];
+            if (!sorted)
+                qsort(list, size, sizeof(uint64_t), graph_u64_compare);
+
+            uint64_t slot = ctx->offsets[u];
+            for (size_t i = 0; i < size; i++) {
+                if (i > 0 && list[i] == list[i - 1])
+                    continue;
+                if (ctx->narrow)
+                    ctx->narrow[slot] = (uint32_t)list[i];
+                else
+                    ctx->wide[slot] = list[i];
+                slot++;
+                if (ctx->distinct)
+                    graph_atomic_add(&ctx->distinct[list[i]], 1);
+            }
+            ctx->span[u].begin = ctx->offsets[u];
+            ctx->span[u].end = slot;
+            if (ctx->distinct)
+                graph_atomic_add(&ctx->distinct[u], slot - ctx->offsets[u]);
+        }
+    }
+}
+
+static inline void graph_tri_hit(uint64_t *per_node, uint64_t w)
+{
+    if (per_node)
+        graph_atomic_add(&per_node[w], 1);
+}
+
+// Exponential search for each entry of the shorter list a in b.
+static uint64_t
+graph_tri_gallop32(const uint32_t *a, size_t na, const uint32_t *b, size_t nb, uint64_t *per_node)
+{
+    uint64_t found = 0;
+    size_t lo = 0;
+    for (size_t i = 0; i < na && lo < nb; i++) {
+        size_t step = 1, hi = lo;
+        while (hi < nb && b[hi] < a[i]) {
+            lo = hi + 1;
+            hi += step;
+            step <<= 1;
+        }
+        if (hi > nb)
+            hi = nb;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (b[mid] < a[i])
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < nb && b[lo] == a[i]) {
+            found++;
+            graph_tri_hit(per_node, a[i]);
+        }
+    }
+    return found;
+}
+
+static uint64_t
+graph_tri_meet32(const uint32_t *a, size_t na, const uint32_t *b, size_t nb, uint64_t *per_node)
+{
+    if (na > nb) {
+        const uint32_t *t = a;
+        size_t tn = na;
+        a = b;
+        na = nb;
+        b = t;
+        nb = tn;
+    }
+    if (na * GRAPH_TRI_SKEW < nb)
+        return graph_tri_gallop32(a, na, b, nb, per_node);
+
+    uint64_t found = 0;
+    size_t i = 0, j = 0;
+#if defined(GRAPH_SIMD_AVX) || defined(GRAPH_SIMD_SSE2) || defined(GRAPH_SIMD_NEON)
+    // Compare four entries of a with every rotation of four entries of b
+    while (i + 4 <= na && j + 4 <= nb) {
+        unsigned mask;
+#if defined(GRAPH_SIMD_NEON)
+        uint32x4_t va = vld1q_u32(a + i), vb = vld1q_u32(b + j);
+        uint32x4_t eq = vorrq_u32(vorrq_u32(vceqq_u32(va, vb), vceqq_u32(va, vextq_u32(vb, vb, 1))),
+                                  vorrq_u32(vceqq_u32(va, vextq_u32(vb, vb, 2)), vceqq_u32(va, vextq_u32(vb, vb, 3))));
+        mask = (vgetq_lane_u32(eq, 0) & 1u) | (vgetq_lane_u32(eq, 1) & 2u) |
+               (vgetq_lane_u32(eq, 2) & 4u) | (vgetq_lane_u32(eq, 3) & 8u);
+#else
+        __m128i va = _mm_loadu_si128((const __m128i *)(const void *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(const void *)(b + j));
+        __m128i eq = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq));
+#endif
+        for (; mask; mask &= mask - 1) {
+            found++;
+            graph_tri_hit(per_node, a[i + graph_ctz(mask)]);
+        }
+        uint32_t amax = a[i + 3], bmax = b[j + 3];
+        if (amax <= bmax)
+            i += 4;
+        if (bmax <= amax)
+            j += 4;
+    }
+#endif
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            found++;
+            graph_tri_hit(per_node, a[i]);
+            i++;
+            j++;
+        }
+    }
+    return found;
+}
+
+static uint64_t
+graph_tri_meet64(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *per_node)
+{
+    uint64_t found = 0;
+    size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            found++;
+            graph_tri_hit(per_node, a[i]);
+            i++;
+            j++;
+        }
+    }
+    return found;
+}
+
+// Counts the triangles whose lowest corner is a claimed node.
+static void graph_tri_count(void *arg, size_t tid, size_t threads)
+{
+    graph_tri_ctx_t *ctx = arg;
+    uint64_t total = 0, first, last;
+    (void)tid;
+    (void)threads;
+
+    while (graph_claim(&ctx->cursor, ctx->node_count, GRAPH_TRI_CHUNK, &first, &last)) {
+        for (uint64_t u = first; u < last; u++) {
+            uint64_t begin = ctx->span[u].begin, end = ctx->span[u].end, at_u = 0;
+            for (uint64_t e = begin; e < end; e++) {
+                // The lists of v are random accesses; fetch their bounds, then their ids
+                if (e + GRAPH_TRI_AHEAD < end)
+                    graph_prefetch(&ctx->span[ctx->narrow ? ctx->narrow[e + GRAPH_TRI_AHEAD]
+                                                          : ctx->wide[e + GRAPH_TRI_AHEAD]]);
+                if (e + GRAPH_TRI_AHEAD / 2 < end) {
+                    uint64_t ahead = ctx->narrow ? ctx->narrow[e + GRAPH_TRI_AHEAD / 2]
+                                                 : ctx->wide[e + GRAPH_TRI_AHEAD / 2];
+                    uint64_t at = ctx->span[ahead].begin;
+                    graph_prefetch(ctx->narrow ? (const void *)(ctx->narrow + at) : (const void *)(ctx->wide + at));
+                }
+                uint64_t v = ctx->narrow ? ctx->narrow[e] : ctx->wide[e];
+                uint64_t vb = ctx->span[v].begin, ve = ctx->span[v].end, found;
+                if (ctx->narrow)
+                    found = graph_tri_meet32(ctx->narrow + begin, end - begin,
+                                             ctx->narrow + vb, ve - vb, ctx->per_node);
+                else
+                    found = graph_tri_meet64(ctx->wide + begin, end - begin,
+                                             ctx->wide + vb, ve - vb, ctx->per_node);
+                if (found && ctx->per_node)
+                    graph_atomic_add(&ctx->per_node[v], found);
+                at_u += found;
+            }
+            if (at_u && ctx->per_node)
+                graph_atomic_add(&ctx->per_node[u], at_u);
+            total += at_u;
+        }
+    }
+    graph_atomic_add(&ctx->total, total);
+}
+
+static int
+graph_triangles(
+    fossil_graph_t *graph,
+    uint64_t *triangle_count,
+    uint64_t *per_node,
+    double *clustering
+) {
+    size_t n = graph->node_count;
+    graph_tri_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    bool ok;
+    ctx.adj[0] = graph_out(graph);
+    ctx.adj[1] = graph->directed ? graph_reverse(graph, &ok) : NULL;
+    if (graph->directed && !ok)
+        return -1;
+    ctx.node_count = n;
+    for (uint64_t v = 0; v < n; v++) {
+        uint64_t degree = graph_tri_degree(&ctx, v);
+        if (degree > ctx.max_degree)
+            ctx.max_degree = (size_t)degree;
+    }
+
+    uint64_t *counts = per_node;
+    if (clustering && !counts)
+        counts = malloc(n * sizeof(uint64_t));
+    if (counts)
+        memset(counts, 0, n * sizeof(uint64_t));
+    ctx.per_node = counts;
+
+    graph_pool_t *pool = graph_pool_create(graph_thread_count());
+    size_t scratch = graph_pool_threads(pool) * ctx.max_degree;
+    ctx.scratch = malloc((scratch ? scratch : 1) * sizeof(uint64_t));
+    ctx.offsets = malloc((n + 1) * sizeof(uint64_t));
+    ctx.span = malloc(n * sizeof(*ctx.span));
+    ctx.distinct = clustering ? calloc(n, sizeof(uint64_t)) : NULL;
+    int result = ctx.scratch && ctx.offsets && ctx.span && (!clustering || (counts && ctx.distinct)) ? 0 : -1;
+
+    if (result == 0) {
+        ctx.offsets[0] = 0;
+        graph_pool_run(pool, graph_tri_bound, &ctx);
+        for (size_t v = 0; v < n; v++)
+            ctx.offsets[v + 1] += ctx.offsets[v];
+
+        size_t slots = ctx.offsets[n] ? (size_t)ctx.offsets[n] : 1;
+        if ((uint64_t)n <= (uint64_t)UINT32_MAX + 1)
+            ctx.narrow = malloc(slots * sizeof(uint32_t));
+        else
+            ctx.wide = malloc(slots * sizeof(uint64_t));
+        result = ctx.narrow || ctx.wide ? 0 : -1;
+    }
+    if (result == 0) {
+        ctx.cursor = 0;
+        graph_pool_run(pool, graph_tri_fill, &ctx);
+        ctx.cursor = 0;
+        graph_pool_run(pool, graph_tri_count, &ctx);
+
+        if (triangle_count)
+            *triangle_count = ctx.total;
+        for (size_t v = 0; clustering && v < n; v++) {
+            double d = (double)ctx.distinct[v];
+            clustering[v] = d > 1.0 ? 2.0 * (double)counts[v] / (d * (d - 1.0)) : 0.0;
+        }
+    }
+    graph_pool_destroy(pool);
+    if (counts != per_node)
+        free(counts);
+    free(ctx.scratch);
+    free(ctx.offsets);
+    free(ctx.span);
+    free(ctx.narrow);
+    free(ctx.wide);
+    free(ctx.distinct);
+    return result;
+}
+
+// Exec reports the nodes on at least one triangle, most triangles first.
+static int graph_exec_triangles(fossil_graph_t *graph, fossil_graph_visit_fn visit, void *user)
+{
+    size_t n = graph->node_count;
+    uint64_t *counts = malloc(n * sizeof(uint64_t));
+    graph_pr_order_t *order = malloc(n * sizeof(*order));
+    int result = counts && order ? graph_triangles(graph, NULL, counts, NULL) : -1;
+    if (result == 0) {
+        size_t size = 0;
+        for (uint64_t v = 0; v < n; v++) {
+            if (counts[v] == 0)
+                continue;
+            order[size].rank = (double)counts[v];
+            order[size].node = v;
+            size++;
+        }
+        qsort(order, size, sizeof(*order), graph_pr_order_compare);
+        for (size_t i = 0; visit && i < size; i++)
+            if (!visit(order[i].node, user))
+                break;
+    }
+    free(counts);
+    free(order);
+    return result;
+}
+
+// ======================================================
+// Maximum Flow
+// ======================================================
+
+/*
+ * Flows run on a residual CSR built from the graph. Edge weights are
+ * capacities (1 on unweighted graphs) and self-loops are dropped. Every
+ * directed edge becomes an arc paired with a zero-capacity mate;
+ * an undirected edge becomes two arcs that are each other's mate,
+ * both with the full capacity. The flow on an arc is its capacity minus
+ * its residual, so mates always carry opposite flows.
+ */
+#define GRAPH_FLOW_FROZEN (UINT64_MAX / 2)  // label that never admits a push
+#define GRAPH_FLOW_RELABEL_WORK 12          // arc scans charged per relabel
+
+typedef struct graph_flow_net {
+    size_t    node_count;
+    size_t    arc_count;
+    uint64_t *offsets;
+    uint64_t *heads;
+    uint64_t *mates;
+    double   *capacity;
+    double   *residual;
+} graph_flow_net_t;
+
+static void graph_flow_net_free(graph_flow_net_t *net)
+{
+    free(net->offsets);
+    free(net->heads);
+    free(net->mates);
+    free(net->capacity);
+    free(net->residual);
+}
+
+/*
+ * Visits every flow edge once; an undirected edge is stored at both
+ * ends and taken from the lower one. Without a cursor it counts the
+ * arcs per node into offsets, with one it fills the arc pairs.
+ */
+static void graph_flow_scan(const fossil_graph_t *graph, graph_flow_net_t *net, uint64_t *cursor)
+{
+    const fossil_graph_adj_t *out = graph_out(graph);
+    for (uint64_t u = 0; u < graph->node_count; u++) {
+        uint64_t begin, end;
+        graph_adj_range(out, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t v = out->targets[e];
+            if (u == v || (!graph->directed && v < u))
+                continue;
+            if (!cursor) {
+                net->offsets[u + 1]++;
+                net->offsets[v + 1]++;
+                continue;
+            }
+            double c = out->weights ? out->weights[e] : 1.0;
+            uint64_t a = cursor[u]++, b = cursor[v]++;
+            net->heads[a] = v;
+            net->heads[b] = u;
+            net->mates[a] = b;
+            net->mates[b] = a;
+            net->capacity[a] = c;
+            net->capacity[b] = graph->directed ? 0.0 : c;
+        }
+    }
+}
+
+static bool graph_flow_net_build(const fossil_graph_t *graph, graph_flow_net_t *net)
+{
+    size_t n = graph->node_count;
+    memset(net, 0, sizeof(*net));
+    net->node_count = n;
+    net->offsets = calloc(n + 1, sizeof(uint64_t));
+    if (!net->offsets)
+        return false;
+    graph_flow_scan(graph, net, NULL);
+    for (size_t v = 0; v < n; v++)
+        net->offsets[v + 1] += net->offsets[v];
+
+    size_t arcs = net->offsets[n];
+    net->arc_count = arcs;
+    net->heads = malloc((arcs ? arcs : 1) * sizeof(uint64_t));
+    net->mates = malloc((arcs ? arcs : 1) * sizeof(uint64_t));
+    net->capacity = malloc((arcs ? arcs : 1) * sizeof(double));
+    net->residual = malloc((arcs ? arcs : 1) * sizeof(double));
+    uint64_t *cursor = malloc((n ? n : 1) * sizeof(uint64_t));
+    if (!net->heads || !net->mates || !net->capacity || !net->residual || !cursor) {
+        free(cursor);
+        graph_flow_net_free(net);
+        return false;
+    }
+    memcpy(cursor, net->offsets, n * sizeof(uint64_t));
+    graph_flow_scan(graph, net, cursor);
+    memcpy(net->residual, net->capacity, arcs * sizeof(double));
+    free(cursor);
+    return true;
+}
+
+/*
+ * Breadth-first levels from source over arcs with residual capacity.
+ * Returns whether sink was reached; the search stops at sink's level.
+ */
+static bool graph_flow_levels(const graph_flow_net_t *net, uint64_t source, uint64_t sink,
+                              uint64_t *level, uint64_t *queue)
+{
+    for (size_t v = 0; v < net->node_count; v++)
+        level[v] = FOSSIL_GRAPH_NO_NODE;
+    level[source] = 0;
+    size_t head = 0, tail = 0;
+    queue[tail++] = source;
+    while (head < tail) {
+        uint64_t v = queue[head++];
+        if (level[sink] != FOSSIL_GRAPH_NO_NODE && level[v] >= level[sink])
+            break;
+        for (uint64_t a = net->offsets[v]; a < net->offsets[v + 1]; a++) {
+            uint64_t w = net->heads[a];
+            if (net->residual[a] > 0.0 && level[w] == FOSSIL_GRAPH_NO_NODE) {
+                level[w] = level[v] + 1;
+                queue[tail++] = w;
+            }
+        }
+    }
+    return level[sink] != FOSSIL_GRAPH_NO_NODE;
+}
+
+static void graph_flow_push(graph_flow_net_t *net, uint64_t a, double amount)
+{
+    net->residual[a] -= amount;
+    net->residual[net->mates[a]] += amount;
+}
+
+/*
+ * Dinic: a blocking flow per BFS level graph. The search is iterative
+ * with a current-arc pointer per node; after an augmentation it backs up
+ * to the first saturated arc, and dead ends leave the level graph.
+ */
+static int graph_flow_dinic(graph_flow_net_t *net, uint64_t source, uint64_t sink)
+{
+    size_t n = net->node_count;
+    uint64_t *level = malloc(n * sizeof(uint64_t));
+    uint64_t *queue = malloc(n * sizeof(uint64_t));
+    uint64_t *current = malloc(n * sizeof(uint64_t));
+    uint64_t *path = malloc(n * sizeof(uint64_t));
+    if (!level || !queue || !current || !path) {
+        free(level);
+        free(queue);
+        free(current);
+        free(path);
+        return -1;
+    }
+
+    while (graph_flow_levels(net, source, sink, level, queue)) {
+        memcpy(current, net->offsets, n * sizeof(uint64_t));
+        size_t depth = 0;
+        uint64_t v = source;
+        for (;;) {
+            if (v == sink) {
+                double bottleneck = DBL_MAX;
+                for (size_t i = 0; i < depth; i++)
+                    if (net->residual[path[i]] < bottleneck)
+                        bottleneck = net->residual[path[i]];
+                size_t saturated = depth;
+                for (size_t i = 0; i < depth; i++) {
+                    graph_flow_push(net, path[i], bottleneck);
+                    if (saturated == depth && net->residual[path[i]] <= 0.0)
+                        saturated = i;
+                }
+                depth = saturated;
+                v = depth ? net->heads[path[depth - 1]] : source;
+                continue;
+            }
+
+            uint64_t end = net->offsets[v + 1];
+            while (current[v] < end) {
+                uint64_t a = current[v];
+                if (net->residual[a] > 0.0 && level[net->heads[a]] == level[v] + 1)
+                    break;
+                current[v]++;
+            }
+            if (current[v] < end) {
+                path[depth++] = current[v];
+                v = net->heads[current[v]];
+                continue;
+            }
+
+            // Dead end: drop v from the level graph and back up
+            if (v == source)
+                break;
+            level[v] = FOSSIL_GRAPH_NO_NODE;
+            depth--;
+            v = depth ? net->heads[path[depth - 1]] : source;
+            current[v]++;
+        }
+    }
+
+    free(level);
+    free(queue);
+    free(current);
+    free(path);
+    return 0;
+}
+
+/*
+ * Highest-label push-relabel. Labels are distance estimates to the
+ * target; active nodes sit in one list per label and the highest is
+ * discharged first. Every label below node_count also keeps a doubly
+ * linked list of all its nodes: when a relabel empties a label, the
+ * nodes above the gap can no longer reach the target and jump to
+ * node_count at once. Labels are recomputed exactly by a reverse BFS
+ * from the target after about 6 * node_count + arcs units of relabel
+ * work.
+ */
+typedef struct graph_flow_pr {
+    graph_flow_net_t *net;
+    size_t    node_count;
+    uint64_t  target;
+    uint64_t  frozen;       // never labeled, activated or relabeled
+    uint64_t *label;
+    uint64_t *current;
+    double   *excess;
+    uint64_t *active;       // head per label, linked through next_active
+    uint64_t *next_active;
+    uint64_t *bucket;       // head per label, linked through next/prev
+    uint64_t *next;
+    uint64_t *prev;
+    uint64_t *queue;
+    uint64_t  top_active;
+    uint64_t  top_bucket;
+    uint64_t  work;
+} graph_flow_pr_t;
+
+static void graph_flow_bucket_add(graph_flow_pr_t *pr, uint64_t v)
+{
+    uint64_t h = pr->label[v];
+    pr->prev[v] = FOSSIL_GRAPH_NO_NODE;
+    pr->next[v] = pr->bucket[h];
+    if (pr->bucket[h] != FOSSIL_GRAPH_NO_NODE)
+        pr->prev[pr->bucket[h]] = v;
+    pr->bucket[h] = v;
+    if (h > pr->top_bucket)
+        pr->top_bucket = h;
+}
+
+static void graph_flow_bucket_remove(graph_flow_pr_t *pr, uint64_t v)
+{
+    if (pr->prev[v] != FOSSIL_GRAPH_NO_NODE)
+        pr->next[pr->prev[v]] = pr->next[v];
+    else
+        pr->bucket[pr->label[v]] = pr->next[v];
+    if (pr->next[v] != FOSSIL_GRAPH_NO_NODE)
+        pr->prev[pr->next[v]] = pr->prev[v];
+}
+
+static void graph_flow_activate(graph_flow_pr_t *pr, uint64_t v)
+{
+    uint64_t h = pr->label[v];
+    pr->next_active[v] = pr->active[h];
+    pr->active[h] = v;
+    if (h > pr->top_active)
+        pr->top_active = h;
+}
+
+// Exact labels: residual distance to the target, node_count if none.
+static void graph_flow_global_relabel(graph_flow_pr_t *pr)
+{
+    graph_flow_net_t *net = pr->net;
+    size_t n = pr->node_count;
+    for (size_t v = 0; v < n; v++) {
+        pr->label[v] = n;
+        pr->current[v] = net->offsets[v];
+        pr->active[v] = FOSSIL_GRAPH_NO_NODE;
+        pr->bucket[v] = FOSSIL_GRAPH_NO_NODE;
+    }
+    pr->label[pr->frozen] = GRAPH_FLOW_FROZEN;
+    pr->label[pr->target] = 0;
+    pr->top_active = 0;
+    pr->top_bucket = 0;
+    pr->work = 0;
+
+    size_t head = 0, tail = 0;
+    pr->queue[tail++] = pr->target;
+    while (head < tail) {
+        uint64_t w = pr->queue[head++];
+        graph_flow_bucket_add(pr, w);
+        if (w != pr->target && pr->excess[w] > 0.0)
+            graph_flow_activate(pr, w);
+        for (uint64_t a = net->offsets[w]; a < net->offsets[w + 1]; a++) {
+            uint64_t v = net->heads[a];
+            if (pr->label[v] == n && net->residual[net->mates[a]] > 0.0) {
+                pr->label[v] = pr->label[w] + 1;
+                pr->queue[tail++] = v;
+            }
+        }
+    }
+}
+
+// Relabels v from its old label, applying the gap heuristic.
+static void graph_flow_relabel(graph_flow_pr_t *pr, uint64_t v)
+{
+    graph_flow_net_t *net = pr->net;
+    size_t n = pr->node_count;
+    uint64_t old = pr->label[v];
+    graph_flow_bucket_remove(pr, v);
+
+    if (pr->bucket[old] == FOSSIL_GRAPH_NO_NODE) {
+        // Gap: v and every node above it are cut off from the target
+        for (uint64_t h = old + 1; h <= pr->top_bucket; h++) {
+            for (uint64_t u = pr->bucket[h]; u != FOSSIL_GRAPH_NO_NODE; u = pr->next[u])
+                pr->label[u] = n;
+            pr->bucket[h] = FOSSIL_GRAPH_NO_NODE;
+        }
+        pr->top_bucket = old ? old - 1 : 0;
+        pr->label[v] = n;
+        return;
+    }
+
+    uint64_t low = n, arc = net->offsets[v];
+    for (uint64_t a = net->offsets[v]; a < net->offsets[v + 1]; a++) {
+        if (net->residual[a] > 0.0 && pr->label[net->heads[a]] < low) {
+            low = pr->label[net->heads[a]];
+            arc = a;
+        }
+    }
+    pr->work += GRAPH_FLOW_RELABEL_WORK + (net->offsets[v + 1] - net->offsets[v]);
+    pr->label[v] = low + 1 < n ? low + 1 : n;
+    pr->current[v] = arc;
+    if (pr->label[v] < n)
+        graph_flow_bucket_add(pr, v);
+}
+
+static void graph_flow_discharge(graph_flow_pr_t *pr, uint64_t v)
+{
+    graph_flow_net_t *net = pr->net;
+    size_t n = pr->node_count;
+    while (pr->excess[v] > 0.0) {
+        if (pr->current[v] == net->offsets[v + 1]) {
+            graph_flow_relabel(pr, v);
+            if (pr->label[v] >= n)
+                return;
+            continue;
+        }
+        uint64_t a = pr->current[v], w = net->heads[a];
+        if (net->residual[a] > 0.0 && pr->label[v] == pr->label[w] + 1) {
+            double amount = pr->excess[v] < net->residual[a] ? pr->excess[v] : net->residual[a];
+            if (pr->excess[w] <= 0.0 && w != pr->target)
+                graph_flow_activate(pr, w);
+            graph_flow_push(net, a, amount);
+            pr->excess[v] -= amount;
+            pr->excess[w] += amount;
+            if (net->residual[a] > 0.0)
+                continue;
+        }
+        pr->current[v]++;
+    }
+}
+
+// Moves all excess that can reach the target there.
+static void graph_flow_run(graph_flow_pr_t *pr)
+{
+    size_t budget = 6 * pr->node_count + pr->net->arc_count;
+    graph_flow_global_relabel(pr);
+    for (;;) {
+        while (pr->top_active > 0 && pr->active[pr->top_active] == FOSSIL_GRAPH_NO_NODE)
+            pr->top_active--;
+        uint64_t v = pr->active[pr->top_active];
+        if (v == FOSSIL_GRAPH_NO_NODE)
+            break;
+        pr->active[pr->top_active] = pr->next_active[v];
+        // Nodes cut off by a gap may still be queued
+        if (pr->label[v] != pr->top_active || pr->label[v] >= pr->node_count)
+            continue;
+        graph_flow_discharge(pr, v);
+        if (pr->work > budget)
+            graph_flow_global_relabel(pr);
+    }
+}
+
+/*
+ * Phase one saturates the source arcs and pushes towards the sink,
+ * leaving a maximum preflow. Phase two runs the same loop towards the
+ * source, returning the stranded excess so that every arc carries a
+ * valid flow.
+ */
+static int graph_flow_push_relabel(graph_flow_net_t *net, uint64_t source, uint64_t sink)
+{
+    size_t n = net->node_count;
+    graph_flow_pr_t pr;
+    memset(&pr, 0, sizeof(pr));
+    pr.net = net;
+    pr.node_count = n;
+    pr.label = malloc(n * sizeof(uint64_t));
+    pr.current = malloc(n * sizeof(uint64_t));
+    pr.excess = calloc(n, sizeof(double));
+    pr.active = malloc(n * sizeof(uint64_t));
+    pr.next_active = malloc(n * sizeof(uint64_t));
+    pr.bucket = malloc(n * sizeof(uint64_t));
+    pr.next = malloc(n * sizeof(uint64_t));
+    pr.prev = malloc(n * sizeof(uint64_t));
+    pr.queue = malloc(n * sizeof(uint64_t));
+    int result = 0;
+    if (!pr.label || !pr.current || !pr.excess || !pr.active || !pr.next_active ||
+        !pr.bucket || !pr.next || !pr.prev || !pr.queue)
+        result = -1;
+
+    if (result == 0) {
+        for (uint64_t a = net->offsets[source]; a < net->offsets[source + 1]; a++) {
+            double amount = net->residual[a];
+            if (amount > 0.0) {
+                graph_flow_push(net, a, amount);
+                pr.excess[net->heads[a]] += amount;
+            }
+        }
+        pr.target = sink;
+        pr.frozen = source;
+        graph_flow_run(&pr);
+        pr.target = source;
+        pr.frozen = sink;
+        graph_flow_run(&pr);
+    }
+
+    free(pr.label);
+    free(pr.current);
+    free(pr.excess);
+    free(pr.active);
+    free(pr.next_active);
+    free(pr.bucket);
+    free(pr.next);
+    free(pr.prev);
+    free(pr.queue);
+    return result;
+}
+
+/*
+ * Solves, then reports the flow leaving the source, every arc carrying
+ * positive flow and the source side of the minimum cut: the nodes still
+ * reachable from the source in the residual graph.
+ */
+static int graph_max_flow(
+    fossil_graph_t *graph,
+    bool dinic,
+    uint64_t source,
+    uint64_t sink,
+    double *flow_value,
+    fossil_graph_edge_t *flows,
+    size_t *flow_count,
+    bool *source_side
+) {
+    size_t n = graph->node_count;
+    graph_flow_net_t net;
+    if (!graph_flow_net_build(graph, &net))
+        return -1;
+    int result = dinic ? graph_flow_dinic(&net, source, sink)
+                       : graph_flow_push_relabel(&net, source, sink);
+
+    if (result == 0 && flow_value) {
+        double total = 0.0;
+        for (uint64_t a = net.offsets[source]; a < net.offsets[source + 1]; a++)
+            total += net.capacity[a] - net.residual[a];
+        *flow_value = total;
+    }
+
+    if (result == 0 && (flows || flow_count)) {
+        size_t count = 0;
+        for (uint64_t u = 0; u < n; u++) {
+            for (uint64_t a = net.offsets[u]; a < net.offsets[u + 1]; a++) {
+                double flow = net.capacity[a] - net.residual[a];
+                if (flow <= 0.0)
+                    continue;
+                if (flows) {
+                    flows[count].from = u;
+                    flows[count].to = net.heads[a];
+                    flows[count].weight = flow;
+                }
+                count++;
+            }
+        }
+        if (flow_count)
+            *flow_count = count;
+    }
+
+    if (result == 0 && source_side) {
+        uint64_t *level = malloc(n * sizeof(uint64_t));
+        uint64_t *queue = malloc(n * sizeof(uint64_t));
+        if (level && queue) {
+            // The sink is unreachable now, so this is a full search
+            graph_flow_levels(&net, source, sink, level, queue);
+            for (size_t v = 0; v < n; v++)
+                source_side[v] = level[v] != FOSSIL_GRAPH_NO_NODE;
+        } else {
+            result = -1;
+        }
+        free(level);
+        free(queue);
+    }
+
+    graph_flow_net_free(&net);
+    return result;
+}
+
+// Exec reports the source side of the minimum cut in node order.
+static int graph_exec_max_flow(fossil_graph_t *graph, const char *algorithm_id, uint64_t source,
+                               uint64_t sink, fossil_graph_visit_fn visit, void *user)
+{
+    size_t n = graph->node_count;
+    bool *side = malloc(n * sizeof(bool));
+    int result = side ? graph_max_flow(graph, algorithm_equals(algorithm_id, "dinic"), source, sink,
+                                       NULL, NULL, NULL, side) : -1;
+    for (uint64_t v = 0; result == 0 && visit && v < n; v++)
+        if (side[v] && !visit(v, user))
+            break;
+    free(side);
+    return result;
+}
+
+// ======================================================
+// Matching
+// ======================================================
+
+/*
+ * Hopcroft-Karp on the undirected view of the graph. Each phase runs a
+ * BFS from the free left nodes to the nearest free right node, then
+ * augments along vertex-disjoint shortest paths with an iterative DFS,
+ * so the search stays off the call stack on long alternating paths.
+ * A greedy pass seeds the matching first.
+ */
+#define GRAPH_MATCH_FAR UINT64_MAX
+
+typedef struct graph_match {
+    const fossil_graph_adj_t *out;
+    const fossil_graph_adj_t *in;   // NULL for undirected graphs
+    size_t    node_count;
+    bool     *left;
+    uint64_t *mate;
+    uint64_t *dist;
+    uint64_t *cursor;
+    uint64_t *stack;
+} graph_match_t;
+
+static inline uint64_t graph_match_degree(const graph_match_t *mt, uint64_t v)
+{
+    return graph_adj_degree(mt->out, v) + (mt->in ? graph_adj_degree(mt->in, v) : 0);
+}
+
+// k-th neighbor over the out-arcs, then the in-arcs.
+static inline uint64_t graph_match_neighbor(const graph_match_t *mt, uint64_t v, uint64_t k)
+{
+    uint64_t begin, end;
+    graph_adj_range(mt->out, v, &begin, &end);
+    if (k < end - begin)
+        return mt->out->targets[begin + k];
+    k -= end - begin;
+    graph_adj_range(mt->in, v, &begin, &end);
+    return mt->in->targets[begin + k];
+}
+
+// Two-colors every component from its lowest id; false if not bipartite.
+static bool graph_match_color(graph_match_t *mt)
+{
+    size_t n = mt->node_count;
+    bool *seen = calloc(n, sizeof(bool));
+    if (!seen)
+        return false;
+    bool bipartite = true;
+    for (uint64_t root = 0; bipartite && root < n; root++) {
+        if (seen[root])
+            continue;
+        size_t head = 0, tail = 0;
+        seen[root] = true;
+        mt->left[root] = true;
+        mt->stack[tail++] = root;
+        while (bipartite && head < tail) {
+            uint64_t v = mt->stack[head++];
+            uint64_t degree = graph_match_degree(mt, v);
+            for (uint64_t k = 0; k < degree; k++) {
+                uint64_t w = graph_match_neighbor(mt, v, k);
+                if (!seen[w]) {
+                    seen[w] = true;
+                    mt->left[w] = !mt->left[v];
+                    mt->stack[tail++] = w;
+                } else if (mt->left[w] == mt->left[v]) {
+                    bipartite = false;
+                    break;
+                }
+            }
+        }
+    }
+    free(seen);
+    return bipartite;
+}
+
+// Layers the left nodes; returns the length of the shortest augmenting path.
+static uint64_t graph_match_layers(graph_match_t *mt)
+{
+    size_t n = mt->node_count, head = 0, tail = 0;
+    for (uint64_t u = 0; u < n; u++) {
+        mt->dist[u] = GRAPH_MATCH_FAR;
+        if (mt->left[u] && mt->mate[u] == FOSSIL_GRAPH_NO_NODE) {
+            mt->dist[u] = 0;
+            mt->stack[tail++] = u;
+        }
+    }
+
+    uint64_t limit = GRAPH_MATCH_FAR;
+    while (head < tail) {
+        uint64_t u = mt->stack[head++];
+        if (mt->dist[u] >= limit)
+            break;
+        uint64_t degree = graph_match_degree(mt, u);
+        for (uint64_t k = 0; k < degree; k++) {
+            uint64_t w = graph_match_neighbor(mt, u, k);
+            if (mt->left[w])
+                continue;
+            uint64_t x = mt->mate[w];
+            if (x == FOSSIL_GRAPH_NO_NODE) {
+                if (limit == GRAPH_MATCH_FAR)
+                    limit = mt->dist[u] + 1;
+            } else if (mt->dist[x] == GRAPH_MATCH_FAR) {
+                mt->dist[x] = mt->dist[u] + 1;
+                mt->stack[tail++] = x;
+            }
+        }
+    }
+    return limit;
+}
+
+/*
+ * Looks for a layered augmenting path from the free left node root and
+ * flips it. Left nodes that lead nowhere leave the layering.
+ */
+static bool graph_match_augment(graph_match_t *mt, uint64_t root, uint64_t limit)
+{
+    size_t top = 0;
+    mt->stack[0] = root;
+    for (;;) {
+        uint64_t u = mt->stack[top];
+        if (mt->cursor[u] == graph_match_degree(mt, u)) {
+            mt->dist[u] = GRAPH_MATCH_FAR;
+            if (top == 0)
+                return false;
+            top--;
+            mt->cursor[mt->stack[top]]++;
+            continue;
+        }
+
+        uint64_t w = graph_match_neighbor(mt, u, mt->cursor[u]);
+        if (!mt->left[w]) {
+            uint64_t x = mt->mate[w];
+            if (x == FOSSIL_GRAPH_NO_NODE && mt->dist[u] + 1 == limit) {
+                // Flip the path: each stacked node takes the node its cursor names
+                for (size_t k = top + 1; k-- > 0;) {
+                    uint64_t v = mt->stack[k];
+                    uint64_t r = graph_match_neighbor(mt, v, mt->cursor[v]);
+                    mt->mate[v] = r;
+                    mt->mate[r] = v;
+                }
+                return true;
+            }
+            if (x != FOSSIL_GRAPH_NO_NODE && mt->dist[x] == mt->dist[u] + 1) {
+                mt->stack[++top] = x;
+                continue;
+            }
+        }
+        mt->cursor[u]++;
+    }
+}
+
+static int graph_matching(fossil_graph_t *graph, const bool *left, uint64_t *mate, size_t *matching_size)
+{
+    size_t n = graph->node_count;
+    graph_match_t mt;
+    memset(&mt, 0, sizeof(mt));
+    bool ok = true;
+    mt.node_count = n;
+    mt.out = graph_out(graph);
+    mt.in = graph->directed ? graph_reverse(graph, &ok) : NULL;
+    mt.left = malloc(n * sizeof(bool));
+    mt.mate = mate ? mate : malloc(n * sizeof(uint64_t));
+    mt.dist = malloc(n * sizeof(uint64_t));
+    mt.cursor = malloc(n * sizeof(uint64_t));
+    mt.stack = malloc(n * sizeof(uint64_t));
+
+    int result = 0;
+    if (!ok || !mt.left || !mt.mate || !mt.dist || !mt.cursor || !mt.stack)
+        result = -1;
+    if (result == 0) {
+        if (left)
+            memcpy(mt.left, left, n * sizeof(bool));
+        else if (!graph_match_color(&mt))
+            result = -4;
+    }
+
+    size_t size = 0;
+    if (result == 0) {
+        for (uint64_t v = 0; v < n; v++)
+            mt.mate[v] = FOSSIL_GRAPH_NO_NODE;
+
+        // Greedy seed: first free right neighbor
+        for (uint64_t u = 0; u < n; u++) {
+            if (!mt.left[u])
+                continue;
+            uint64_t degree = graph_match_degree(&mt, u);
+            for (uint64_t k = 0; k < degree; k++) {
+                uint64_t w = graph_match_neighbor(&mt, u, k);
+                if (!mt.left[w] && mt.mate[w] == FOSSIL_GRAPH_NO_NODE) {
+                    mt.mate[u] = w;
+                    mt.mate[w] = u;
+                    size++;
+                    break;
+                }
+            }
+        }
+
+        for (;;) {
+            uint64_t limit = graph_match_layers(&mt);
+            if (limit == GRAPH_MATCH_FAR)
+                break;
+            memset(mt.cursor, 0, n * sizeof(uint64_t));
+            for (uint64_t u = 0; u < n; u++)
+                if (mt.left[u] && mt.mate[u] == FOSSIL_GRAPH_NO_NODE && mt.dist[u] == 0 &&
+                    graph_match_augment(&mt, u, limit))
+                    size++;
+        }
+        if (matching_size)
+            *matching_size = size;
+    }
+
+    free(mt.left);
+    if (!mate)
+        free(mt.mate);
+    free(mt.dist);
+    free(mt.cursor);
+    free(mt.stack);
+    return result;
+}
+
+// Exec reports every matched pair once, lower id first, by lower id.
+static int graph_exec_matching(fossil_graph_t *graph, fossil_graph_visit_fn visit, void *user)
+{
+    size_t n = graph->node_count;
+    uint64_t *mate = malloc(n * sizeof(uint64_t));
+    int result = mate ? graph_matching(graph, NULL, mate, NULL) : -1;
+    for (uint64_t v = 0; result == 0 && visit && v < n; v++) {
+        if (mate[v] == FOSSIL_GRAPH_NO_NODE || mate[v] < v)
+            continue;
+        if (!visit(v, user) || !visit(mate[v], user))
+            break;
+    }
+    free(mate);
+    return result;
+}
+
+/*
+ * Hungarian method in its shortest augmenting path form: rows are
+ * added one at a time and each is routed to a free column by a
+ * Dijkstra-like sweep over the reduced costs, O(rows^2 * cols) in all.
+ * The sweep reads one cost row at a time and keeps the per-column state
+ * in contiguous arrays, so every pass is a linear scan. Needs
+ * rows <= cols; wider problems are solved on the transpose.
+ */
+static int graph_hungarian(const double *cost, size_t rows, size_t cols, uint64_t *column)
+{
+    // Index 0 is the virtual column that holds the row being added
+    double *row_pot = calloc(rows + 1, sizeof(double));
+    double *col_pot = calloc(cols + 1, sizeof(double));
+    double *slack = malloc((cols + 1) * sizeof(double));
+    size_t *owner = calloc(cols + 1, sizeof(size_t));
+    size_t *way = calloc(cols + 1, sizeof(size_t));
+    bool *used = malloc((cols + 1) * sizeof(bool));
+    if (!row_pot || !col_pot || !slack || !owner || !way || !used) {
+        free(row_pot);
+        free(col_pot);
+        free(slack);
+        free(owner);
+        free(way);
+        free(used);
+        return -1;
+    }
+
+    for (size_t i = 1; i <= rows; i++) {
+        owner[0] = i;
+        size_t j0 = 0;
+        for (size_t j = 0; j <= cols; j++) {
+            slack[j] = DBL_MAX;
+            used[j] = false;
+        }
+        do {
+            used[j0] = true;
+            size_t i0 = owner[j0], j1 = 0;
+            const double *row = cost + (i0 - 1) * cols;
+            double delta = DBL_MAX, base = row_pot[i0];
+            for (size_t j = 1; j <= cols; j++) {
+                if (used[j])
+                    continue;
+                double reduced = row[j - 1] - base - col_pot[j];
+                if (reduced < slack[j]) {
+                    slack[j] = reduced;
+                    way[j] = j0;
+                }
+                if (slack[j] < delta) {
+                    delta = slack[j];
+                    j1 = j;
+                }
+            }
+            for (size_t j = 0; j <= cols; j++) {
+                if (used[j]) {
+                    row_pot[owner[j]] += delta;
+                    col_pot[j] -= delta;
+                } else {
+                    slack[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (owner[j0] != 0);
+
+        // Shift the assignment back along the alternating path
+        do {
+            size_t j1 = way[j0];
+            owner[j0] = owner[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    for (size_t j = 1; j <= cols; j++)
+        if (owner[j])
+            column[owner[j] - 1] = j - 1;
+
+    free(row_pot);
+    free(col_pot);
+    free(slack);
+    free(owner);
+    free(way);
+    free(used);
+    return 0;
+}
+
+static int graph_assignment(const double *cost, size_t rows, size_t cols, uint64_t *assignment,
+                            double *total_cost)
+{
+    uint64_t *column = assignment ? assignment : malloc(rows * sizeof(uint64_t));
+    if (!column)
+        return -1;
+    for (size_t i = 0; i < rows; i++)
+        column[i] = FOSSIL_GRAPH_NO_NODE;
+
+    int result;
+    if (rows <= cols) {
+        result = graph_hungarian(cost, rows, cols, column);
+    } else {
+        // Assign every column to a row on the transposed matrix instead
+        double *transposed = malloc(rows * cols * sizeof(double));
+        uint64_t *row = malloc(cols * sizeof(uint64_t));
+        result = transposed && row ? 0 : -1;
+        if (result == 0) {
+            for (size_t i = 0; i < rows; i++)
+                for (size_t j = 0; j < cols; j++)
+                    transposed[j * rows + i] = cost[i * cols + j];
+            result = graph_hungarian(transposed, cols, rows, row);
+        }
+        if (result == 0)
+            for (size_t j = 0; j < cols; j++)
+                column[row[j]] = j;
+        free(transposed);
+        free(row);
+    }
+
+    if (result == 0 && total_cost) {
+        double total = 0.0;
+        for (size_t i = 0; i < rows; i++)
+            if (column[i] != FOSSIL_GRAPH_NO_NODE)
+                total += cost[i * cols + column[i]];
+        *total_cost = total;
+    }
+    if (!assignment)
+        free(column);
+    return result;
+}
+
+// ======================================================
+// Betweenness Centrality
+// ======================================================
+
+/*
+ * Brandes: a single-source search per source counts shortest paths
+ * (sigma), then dependencies flow back in reverse settle order. BFS
+ * serves unweighted graphs and the indexed heap weighted ones. The
+ * backward pass rescans out-arcs and keeps those on a shortest path,
+ * so no predecessor lists are stored. Once a node's dependency is
+ * final its sigma slot holds (1 + delta) / sigma, which is all its
+ * predecessors need: the hot per-node record stays at 16 bytes.
+ * Sources are claimed in chunks and every thread accumulates into its
+ * own array; the arrays are summed once at the end.
+ */
+#define GRAPH_BC_CHUNK 4
+#define GRAPH_BC_AHEAD 8    // node records prefetched ahead of the arc scan
+
+typedef struct graph_bc_ctx {
+    const fossil_graph_adj_t *out;
+    size_t          node_count;
+    const uint64_t *sources;        // NULL for every node
+    size_t          source_count;
+    double        **partial;        // per thread, node_count entries
+    uint64_t        cursor;
+    uint64_t        failed;
+} graph_bc_ctx_t;
+
+typedef struct graph_bc_node {
+    double dist;                    // DBL_MAX until reached
+    double sigma;                   // path count, then the predecessor share
+} graph_bc_node_t;
+
+typedef struct graph_bc_state {
+    graph_bc_node_t *node;
+    uint64_t        *order;
+    uint64_t        *settled;       // weighted only: settle index, for zero-length ties
+    graph_heap_t     heap;
+} graph_bc_state_t;
+
+static uint64_t graph_bc_forward(const graph_bc_ctx_t *ctx, graph_bc_state_t *st, uint64_t source)
+{
+    const fossil_graph_adj_t *out = ctx->out;
+    graph_bc_node_t *node = st->node;
+    size_t count = 0;
+    node[source].dist = 0.0;
+    node[source].sigma = 1.0;
+
+    if (!st->settled) {
+        st->order[count++] = source;
+        for (size_t head = 0; head < count; head++) {
+            uint64_t v = st->order[head], begin, end;
+            double level = node[v].dist + 1.0, sigma = node[v].sigma;
+            graph_adj_range(out, v, &begin, &end);
+            for (uint64_t e = begin; e < end; e++) {
+                if (e + GRAPH_BC_AHEAD < end)
+                    graph_prefetch(&node[out->targets[e + GRAPH_BC_AHEAD]]);
+                graph_bc_node_t *w = &node[out->targets[e]];
+                if (w->dist == DBL_MAX) {
+                    w->dist = level;
+                    st->order[count++] = out->targets[e];
+                }
+                if (w->dist == level)
+                    w->sigma += sigma;
+            }
+        }
+        return count;
+    }
+
+    graph_heap_push(&st->heap, source, 0.0);
+    while (st->heap.size > 0) {
+        double d;
+        uint64_t v = graph_heap_pop(&st->heap, &d), begin, end;
+        double sigma = node[v].sigma;
+        st->settled[v] = count;
+        st->order[count++] = v;
+        graph_adj_range(out, v, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t t = out->targets[e];
+            graph_bc_node_t *w = &node[t];
+            double next = d + out->weights[e];
+            // A settled w can only tie, through a zero-length arc
+            if (next < w->dist) {
+                w->dist = next;
+                w->sigma = sigma;
+                graph_heap_push(&st->heap, t, next);
+            } else if (next == w->dist && st->settled[t] == GRAPH_HEAP_NONE) {
+                w->sigma += sigma;
+            }
+        }
+    }
+    return count;
+}
+
+// Accumulates the dependencies of one source and resets what it touched.
+static void graph_bc_backward(const graph_bc_ctx_t *ctx, graph_bc_state_t *st, size_t count,
+                              double *acc)
+{
+    const fossil_graph_adj_t *out = ctx->out;
+    graph_bc_node_t *node = st->node;
+    for (size_t i = count; i-- > 0;) {
+        uint64_t v = st->order[i], begin, end;
+        double share = 0.0, dist = node[v].dist;
+        graph_adj_range(out, v, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            if (e + GRAPH_BC_AHEAD < end)
+                graph_prefetch(&node[out->targets[e + GRAPH_BC_AHEAD]]);
+            uint64_t t = out->targets[e];
+            double length = out->weights ? out->weights[e] : 1.0;
+            // Successors settle later; only zero-length arcs need the index
+            if (dist + length == node[t].dist && (length > 0.0 || st->settled[t] > i))
+                share += node[t].sigma;
+        }
+        double delta = node[v].sigma * share;
+        if (i > 0)
+            acc[v] += delta;
+        node[v].sigma = (1.0 + delta) / node[v].sigma;
+    }
+    for (size_t i = 0; i < count; i++) {
+        uint64_t v = st->order[i];
+        node[v].dist = DBL_MAX;
+        node[v].sigma = 0.0;
+        if (st->settled)
+            st->settled[v] = GRAPH_HEAP_NONE;
+    }
+}
+
+static void graph_bc_task(void *arg, size_t tid, size_t threads)
+{
+    graph_bc_ctx_t *ctx = arg;
+    size_t n = ctx->node_count;
+    (void)threads;
+
+    graph_bc_state_t st;
+    memset(&st, 0, sizeof(st));
+    st.node = malloc(n * sizeof(*st.node));
+    st.order = malloc(n * sizeof(uint64_t));
+    bool weighted = ctx->out && ctx->out->weights;
+    bool heap = !weighted || graph_heap_init(&st.heap, n);
+    if (weighted)
+        st.settled = malloc(n * sizeof(uint64_t));
+    if (!st.node || !st.order || !heap || (weighted && !st.settled)) {
+        graph_atomic_store(&ctx->failed, 1);
+    } else {
+        for (size_t v = 0; v < n; v++) {
+            st.node[v].dist = DBL_MAX;
+            st.node[v].sigma = 0.0;
+            if (st.settled)
+                st.settled[v] = GRAPH_HEAP_NONE;
+        }
+        uint64_t first, last;
+        while (graph_claim(&ctx->cursor, ctx->source_count, GRAPH_BC_CHUNK, &first, &last)) {
+            for (uint64_t i = first; i < last; i++) {
+                uint64_t source = ctx->sources ? ctx->sources[i] : i;
+                size_t count = graph_bc_forward(ctx, &st, source);
+                graph_bc_backward(ctx, &st, count, ctx->partial[tid]);
+            }
+        }
+    }
+
+    if (weighted && heap)
+        graph_heap_free(&st.heap);
+    free(st.node);
+    free(st.order);
+    free(st.settled);
+}
+
+static inline uint64_t graph_splitmix(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/*
+ * Exact with pivots == 0 or >= node_count. Otherwise pivots distinct
+ * sources are drawn with a seeded partial Fisher-Yates shuffle and the
+ * sums are scaled by node_count / pivots, an unbiased estimate.
+ */
+static int graph_betweenness(fossil_graph_t *graph, size_t pivots, uint64_t seed, double *centrality)
+{
+    size_t n = graph->node_count;
+    graph_bc_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.out = graph_out(graph);
+    ctx.node_count = n;
+    ctx.source_count = n;
+
+    uint64_t *sources = NULL;
+    if (pivots > 0 && pivots < n) {
+        sources = malloc(n * sizeof(uint64_t));
+        if (!sources)
+            return -1;
+        for (uint64_t v = 0; v < n; v++)
+            sources[v] = v;
+        for (size_t i = 0; i < pivots; i++) {
+            size_t j = i + (size_t)(graph_splitmix(&seed) % (n - i));
+            uint64_t swap = sources[i];
+            sources[i] = sources[j];
+            sources[j] = swap;
+        }
+        ctx.sources = sources;
+        ctx.source_count = pivots;
+    }
+
+    graph_pool_t *pool = graph_pool_create(graph_thread_count());
+    size_t threads = graph_pool_threads(pool);
+    ctx.partial = calloc(threads, sizeof(double *));
+    bool ok = ctx.partial != NULL;
+    for (size_t t = 0; ok && t < threads; t++) {
+        ctx.partial[t] = calloc(n, sizeof(double));
+        ok = ctx.partial[t] != NULL;
+    }
+    if (ok) {
+        graph_pool_run(pool, graph_bc_task, &ctx);
+        ok = !ctx.failed;
+    }
+    graph_pool_destroy(pool);
+
+    if (ok) {
+        // Undirected paths are found from both ends
+        double scale = (double)n / (double)ctx.source_count;
+        if (!graph->directed)
+            scale *= 0.5;
+        for (size_t v = 0; v < n; v++) {
+            double sum = 0.0;
+            for (size_t t = 0; t < threads; t++)
+                sum += ctx.partial[t][v];
+            centrality[v] = sum * scale;
+        }
+    }
+
+    for (size_t t = 0; ctx.partial && t < threads; t++)
+        free(ctx.partial[t]);
+    free(ctx.partial);
+    free(sources);
+    return ok ? 0 : -1;
+}
+
+// Exec reports every node by descending exact centrality, ties by id.
+static int graph_exec_betweenness(fossil_graph_t *graph, fossil_graph_visit_fn visit, void *user)
+{
+    size_t n = graph->node_count;
+    double *centrality = malloc(n * sizeof(double));
+    graph_pr_order_t *order = malloc(n * sizeof(*order));
+    int result = centrality && order ? graph_betweenness(graph, 0, 0, centrality) : -1;
+    if (result == 0) {
+        for (uint64_t v = 0; v < n; v++) {
+            order[v].rank = centrality[v];
+            order[v].node = v;
+        }
+        qsort(order, n, sizeof(*order), graph_pr_order_compare);
+        for (size_t i = 0; visit && i < n; i++)
+            if (!visit(order[i].node, user))
+                break;
+    }
+    free(centrality);
+    free(order);
+    return result;
+}
+
+// ======================================================
+// Public Exec Interface
+// ======================================================
+
+int
+fossil_algorithm_graph_exec(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t start_node,
+    uint64_t target_node,
+    fossil_graph_visit_fn visit,
+    void *user
+) {
+    if (!graph || !algorithm_id)
+        return -2;
+
+    // Check for supported algorithms
+    if (!fossil_algorithm_graph_supported(algorithm_id))
+        return -3;
+
+    // Check for node id validity and empty graph
+    if (graph->node_count == 0)
+        return -2;
+
+    if (algorithm_equals(algorithm_id, "bfs") || algorithm_equals(algorithm_id, "dfs")) {
+        if (start_node >= graph->node_count)
+            return -2;
+        if (algorithm_equals(algorithm_id, "bfs"))
+            return graph_bfs((struct fossil_graph *)graph, start_node, visit, user);
+        else
+            return graph_dfs((struct fossil_graph *)graph, start_node, visit, user);
+    }
+
+    if (fossil_algorithm_graph_requires_weights(algorithm_id) && !graph->weighted)
+        return -4;
+
+    // Compressed graphs support traversals and weak components only
+    if (graph_packed(graph) && !algorithm_equals(algorithm_id, "cc"))
+        return -4;
+
+    if (graph_toposort_select(algorithm_id))
+        return graph_exec_toposort(graph, algorithm_id, visit, user);
+
+    if (graph_mst_select(algorithm_id)) {
+        if (start_node >= graph->node_count)
+            return -2;
+        return graph_exec_mst(graph, algorithm_id, start_node, visit, user);
+    }
+
+    // Component algorithms report the nodes of start's component
+    if (graph_components_select(algorithm_id)) {
+        if (start_node >= graph->node_count)
+            return -2;
+        return graph_exec_components(graph, algorithm_id, start_node, visit, user);
+    }
+
+    // Ranking algorithms report every node by descending rank
+    if (algorithm_equals(algorithm_id, "pagerank") || algorithm_equals(algorithm_id, "ppr")) {
+        if (algorithm_equals(algorithm_id, "ppr") && start_node >= graph->node_count)
+            return -2;
+        return graph_exec_pagerank(graph, algorithm_id, start_node, visit, user);
+    }
+
+    if (algorithm_equals(algorithm_id, "triangles"))
+        return graph_exec_triangles(graph, visit, user);
+    if (algorithm_equals(algorithm_id, "kcore") || algorithm_equals(algorithm_id, "kcore-parallel"))
+        return graph_exec_kcore(graph, algorithm_id, visit, user);
+
+    // Flow algorithms report the source side of the minimum cut
+    if (algorithm_equals(algorithm_id, "dinic") || algorithm_equals(algorithm_id, "push-relabel")) {
+        if (start_node >= graph->node_count || target_node >= graph->node_count ||
+            start_node == target_node)
+            return -2;
+        if (graph->csr && graph->csr->negative)
+            return -4;
+        return graph_exec_max_flow(graph, algorithm_id, start_node, target_node, visit, user);
+    }
+
+    if (algorithm_equals(algorithm_id, "hopcroft-karp"))
+        return graph_exec_matching(graph, visit, user);
+    if (algorithm_equals(algorithm_id, "betweenness")) {
+        if (graph->csr && graph->csr->negative)
+            return -4;
+        return graph_exec_betweenness(graph, visit, user);
+    }
+
+    // Shortest-path algorithms report the path start -> target to visit
+    if (start_node >= graph->node_count || target_node >= graph->node_count)
+        return -2;
+
+    if (algorithm_equals(algorithm_id, "floyd-warshall"))
+        return graph_exec_floyd_warshall(graph, start_node, target_node, visit, user);
+    if (graph_route_select(algorithm_id))
+        return graph_exec_route(graph, algorithm_id, start_node, target_node, visit, user);
+
+    double *dist = malloc(graph->node_count * sizeof(double));
+    uint64_t *pred = malloc(graph->node_count * sizeof(uint64_t));
+    if (!dist || !pred) {
+        free(dist);
+        free(pred);
+        return -1;
+    }
+
+    int result = fossil_algorithm_graph_shortest_path(
+        graph, algorithm_id, start_node, target_node, dist, pred);
+    if (result == 0 && visit)
+        result = graph_visit_path(pred, start_node, target_node, visit, user);
+
+    free(dist);
+    free(pred);
+    return result;
+}
+
+typedef int (*graph_sssp_fn)(
+    fossil_graph_t *graph,
+    uint64_t start,
+    uint64_t target,
+    double *dist,
+    uint64_t *pred
+);
+
+static graph_sssp_fn graph_sssp_select(const char *algorithm_id)
+{
+    if (algorithm_equals(algorithm_id, "dijkstra"))
+        return graph_dijkstra;
+    if (algorithm_equals(algorithm_id, "dijkstra-radix"))
+        return graph_dijkstra_radix;
+    if (algorithm_equals(algorithm_id, "bellman-ford"))
+        return graph_bellman_ford;
+    if (algorithm_equals(algorithm_id, "bellman-ford-parallel"))
+        return graph_bellman_ford_parallel;
+    if (algorithm_equals(algorithm_id, "spfa"))
+        return graph_spfa;
+    if (algorithm_equals(algorithm_id, "delta-stepping"))
+        return graph_delta_stepping;
+    return NULL;
+}
+
+int
+fossil_algorithm_graph_shortest_path(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t start_node,
+    uint64_t target_node,
+    double *dist,
+    uint64_t *pred
+) {
+    if (!graph || !algorithm_id)
+        return -2;
+
+    graph_sssp_fn run = graph_sssp_select(algorithm_id);
+    if (!run)
+        return -3;
+
+    if (!graph->weighted || graph_packed(graph))
+        return -4;
+    if (graph->node_count == 0 || start_node >= graph->node_count)
+        return -2;
+    if (target_node != FOSSIL_GRAPH_NO_NODE && target_node >= graph->node_count)
+        return -2;
+
+    // Dijkstra and delta-stepping are only exact for non-negative weights
+    if (graph->csr && (run == graph_dijkstra || run == graph_dijkstra_radix ||
+                       run == graph_delta_stepping)) {
+        if (graph->csr->negative || (run == graph_dijkstra_radix && !graph->csr->integral))
+            return -4;
+    }
+
+    double *dist_buf = dist ? dist : malloc(graph->node_count * sizeof(double));
+    uint64_t *pred_buf = pred ? pred : malloc(graph->node_count * sizeof(uint64_t));
+    int result = -1;
+    if (dist_buf && pred_buf)
+        result = run(graph, start_node, target_node, dist_buf, pred_buf);
+
+    if (!dist) free(dist_buf);
+    if (!pred) free(pred_buf);
+    return result;
+}
+
+int
+fossil_algorithm_graph_shortest_path_update(
+    fossil_graph_t *graph,
+    uint64_t start_node,
+    const fossil_graph_edge_t *inserts,
+    size_t insert_count,
+    const fossil_graph_edge_t *deletes,
+    size_t delete_count,
+    double *dist,
+    uint64_t *pred
+) {
+    if (!graph || !dist || !pred || (insert_count && !inserts) || (delete_count && !deletes))
+        return -2;
+    if (!graph->weighted || graph_packed(graph) || (graph->csr && graph->csr->negative))
+        return -4;
+
+    size_t n = graph->node_count;
+    if (start_node >= n || dist[start_node] != 0.0)
+        return -2;
+    for (size_t i = 0; i < insert_count; i++)
+        if (inserts[i].from >= n || inserts[i].to >= n)
+            return -2;
+    for (size_t i = 0; i < delete_count; i++)
+        if (deletes[i].from >= n || deletes[i].to >= n)
+            return -2;
+    if (insert_count + delete_count == 0 || !graph->csr)
+        return 0;
+
+    return graph_sssp_repair(graph, inserts, insert_count, deletes, delete_count, dist, pred);
+}
+
+int
+fossil_algorithm_graph_floyd_warshall_matrix(
+    void *dist,
+    size_t node_count,
+    const char *type_id,
+    uint64_t *next
+) {
+    if (!dist || !type_id || node_count == 0)
+        return -2;
+    if (node_count > SIZE_MAX / node_count / sizeof(double))
+        return -2;
+
+    bool f32;
+    if (graph_fw_type(type_id, &f32) != 0)
+        return -3;
+
+    if (next)
+        graph_fw_init_next(dist, node_count, f32, next);
+    return graph_floyd_warshall(dist, node_count, f32, next);
+}
+
+int
+fossil_algorithm_graph_floyd_warshall(
+    fossil_graph_t *graph,
+    const char *type_id,
+    void *dist,
+    uint64_t *next
+) {
+    if (!graph || !dist || !type_id)
+        return -2;
+
+    bool f32;
+    if (graph_fw_type(type_id, &f32) != 0)
+        return -3;
+    if (!graph->weighted || graph_packed(graph))
+        return -4;
+
+    size_t n = graph->node_count;
+    if (n == 0 || n > SIZE_MAX / n / sizeof(double))
+        return -2;
+
+    // Direct edges; parallel edges keep the lightest weight
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            if (f32)
+                ((float *)dist)[i * n + j] = i == j ? 0.0f : FLT_MAX;
+            else
+                ((double *)dist)[i * n + j] = i == j ? 0.0 : DBL_MAX;
+        }
+    }
+    for (uint64_t u = 0; u < n; u++) {
+        uint64_t begin, end;
+        graph_edge_range(graph, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            size_t slot = u * n + graph->csr->out.targets[e];
+            double w = graph->csr->out.weights[e];
+            if (f32) {
+                if ((float)w < ((float *)dist)[slot])
+                    ((float *)dist)[slot] = (float)w;
+            } else if (w < ((double *)dist)[slot]) {
+                ((double *)dist)[slot] = w;
+            }
+        }
+    }
+
+    if (next)
+        graph_fw_init_next(dist, n, f32, next);
+    return graph_floyd_warshall(dist, n, f32, next);
+}
+
+int
+fossil_algorithm_graph_route(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t start_node,
+    uint64_t target_node,
+    fossil_graph_heuristic_fn heuristic,
+    void *user,
+    uint64_t *path,
+    size_t *path_length,
+    double *cost
+) {
+    if (!graph || !algorithm_id)
+        return -2;
+
+    graph_route_fn run = graph_route_select(algorithm_id);
+    if (!run)
+        return -3;
+    if (fossil_algorithm_graph_requires_weights(algorithm_id) &&
+        (!graph->weighted || (graph->csr && graph->csr->negative)))
+        return -4;
+    if (graph_packed(graph))
+        return -4;
+    if (start_node >= graph->node_count || target_node >= graph->node_count)
+        return -2;
+
+    return run(graph, start_node, target_node, heuristic, user, path, path_length, cost);
+}
+
+int
+fossil_algorithm_graph_ch_build(fossil_graph_t *graph, fossil_graph_ch_t **ch)
+{
+    if (!graph || !ch)
+        return -2;
+    if (!graph->weighted || graph_packed(graph) || (graph->csr && graph->csr->negative))
+        return -4;
+
+    return graph_ch_build(graph, ch);
+}
+
+int
+fossil_algorithm_graph_ch_route(
+    const fossil_graph_ch_t *ch,
+    uint64_t start_node,
+    uint64_t target_node,
+    uint64_t *path,
+    size_t *path_length,
+    double *cost
+) {
+    if (!ch || start_node >= ch->node_count || target_node >= ch->node_count)
+        return -2;
+
+    return graph_ch_query(ch, start_node, target_node, path, path_length, cost);
+}
+
+int
+fossil_algorithm_graph_ch_save(const fossil_graph_ch_t *ch, const char *file_path)
+{
+    if (!ch || !file_path)
+        return -2;
+
+    return graph_ch_save(ch, file_path);
+}
+
+int
+fossil_algorithm_graph_ch_load(const char *file_path, fossil_graph_ch_t **ch)
+{
+    if (!file_path || !ch)
+        return -2;
+
+    return graph_ch_load(file_path, ch);
+}
+
+void
+fossil_algorithm_graph_ch_destroy(fossil_graph_ch_t *ch)
+{
+    graph_ch_free(ch);
+}
+
+int
+fossil_algorithm_graph_negative_cycle(
+    fossil_graph_t *graph,
+    uint64_t start_node,
+    uint64_t *cycle,
+    size_t *cycle_length
+) {
+    if (!graph || !cycle || !cycle_length)
+        return -2;
+    if (!graph->weighted || graph_packed(graph))
+        return -4;
+    if (graph->node_count == 0)
+        return -2;
+    if (start_node != FOSSIL_GRAPH_NO_NODE && start_node >= graph->node_count)
+        return -2;
+
+    return graph_find_negative_cycle(graph, start_node, cycle, cycle_length);
+}
+
+int
+fossil_algorithm_graph_toposort(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t *order,
+    uint64_t *level,
+    size_t *count
+) {
+    if (!graph || !algorithm_id || !order)
+        return -2;
+
+    graph_toposort_fn run = graph_toposort_select(algorithm_id);
+    if (!run)
+        return -3;
+    if (!graph->directed || graph_packed(graph))
+        return -4;
+
+    size_t n = graph->node_count;
+    uint64_t *indeg = malloc((n ? n : 1) * sizeof(uint64_t));
+    if (!indeg)
+        return -1;
+
+    size_t sorted;
+    run(graph, order, level, indeg, &sorted);
+
+    // Nodes that could not be ordered go after the sorted prefix
+    size_t tail = sorted;
+    for (uint64_t v = 0; v < n && tail < n; v++) {
+        if (indeg[v] == 0)
+            continue;
+        order[tail++] = v;
+        if (level)
+            level[v] = 0;
+    }
+    free(indeg);
+
+    if (count)
+        *count = sorted;
+    return sorted == n ? 0 : -1;
+}
+
+int
+fossil_algorithm_graph_find_cycle(
+    fossil_graph_t *graph,
+    uint64_t *cycle,
+    size_t *cycle_length
+) {
+    if (!graph || !cycle || !cycle_length)
+        return -2;
+    if (!graph->directed || graph_packed(graph))
+        return -4;
+    if (graph->node_count == 0) {
+        *cycle_length = 0;
+        return 0;
+    }
+    return graph_find_cycle(graph, cycle, cycle_length);
+}
+
+int
+fossil_algorithm_graph_dag_path(
+    fossil_graph_t *graph,
+    const char *mode,
+    uint64_t start_node,
+    double *dist,
+    uint64_t *pred
+) {
+    if (!graph || !mode || !dist || !pred)
+        return -2;
+
+    bool longest;
+    if (algorithm_equals(mode, "shortest"))
+        longest = false;
+    else if (algorithm_equals(mode, "longest"))
+        longest = true;
+    else
+        return -3;
+
+    if (!graph->directed || graph_packed(graph))
+        return -4;
+    if (graph->node_count == 0)
+        return -2;
+    if (start_node != FOSSIL_GRAPH_NO_NODE && start_node >= graph->node_count)
+        return -2;
+
+    return graph_dag_path(graph, longest, start_node, dist, pred);
+}
+
+int
+fossil_algorithm_graph_mst(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    fossil_graph_edge_t *edges,
+    size_t *edge_count,
+    double *total_weight
+) {
+    if (!graph || !algorithm_id)
+        return -2;
+
+    graph_mst_fn run = graph_mst_select(algorithm_id);
+    if (!run)
+        return -3;
+    if (graph->directed || !graph->weighted || graph_packed(graph))
+        return -4;
+
+    graph_mst_out_t out = {edges, 0, 0.0};
+    int result = graph->node_count ? run(graph, &out) : 0;
+    if (result != 0)
+        return result;
+
+    if (edge_count)
+        *edge_count = out.count;
+    if (total_weight)
+        *total_weight = out.total;
+    return 0;
+}
+
+int
+fossil_algorithm_graph_pagerank(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    const char *type_id,
+    const uint64_t *seeds,
+    size_t seed_count,
+    double damping,
+    double tolerance,
+    size_t max_iterations,
+    void *rank,
+    size_t *iterations,
+    fossil_graph_metric_fn metric,
+    void *user
+) {
+    if (!graph || !algorithm_id || !type_id || !rank)
+        return -2;
+
+    bool personal = algorithm_equals(algorithm_id, "ppr");
+    if (!personal && !algorithm_equals(algorithm_id, "pagerank"))
+        return -3;
+    bool f32;
+    if (graph_fw_type(type_id, &f32) != 0)
+        return -3;
+    if (graph_packed(graph))
+        return -4;
+
+    if (graph->node_count == 0 || max_iterations == 0 || !(damping >= 0.0 && damping < 1.0))
+        return -2;
+    if (personal) {
+        if (!seeds || seed_count == 0)
+            return -2;
+        for (size_t i = 0; i < seed_count; i++)
+            if (seeds[i] >= graph->node_count)
+                return -2;
+    }
+
+    return graph_pagerank(graph, f32, personal ? seeds : NULL, personal ? seed_count : 0,
+                          damping, tolerance, max_iterations, rank, iterations, metric, user);
+}
+
+int
+fossil_algorithm_graph_betweenness(
+    fossil_graph_t *graph,
+    size_t pivots,
+    uint64_t seed,
+    double *centrality
+) {
+    if (!graph || !centrality)
+        return -2;
+    if (graph_packed(graph) || (graph->csr && graph->csr->negative))
+        return -4;
+    if (graph->node_count == 0)
+        return 0;
+    return graph_betweenness(graph, pivots, seed, centrality);
+}
+
+int
+fossil_algorithm_graph_components(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t *component,
+    uint64_t *sizes,
+    size_t *component_count
+) {
+    if (!graph || !algorithm_id || !component)
+        return -2;
+
+    graph_components_fn run = graph_components_select(algorithm_id);
+    if (!run)
+        return -3;
+    if (graph_packed(graph) && run != graph_connected_components)
+        return -4;
+    if (graph->node_count == 0) {
+        if (component_count)
+            *component_count = 0;
+        return 0;
+    }
+
+    size_t count = 0;
+    int result = run(graph, component, sizes, &count);
+    if (result == 0 && sizes)
+        memset(sizes + count, 0, (graph->node_count - count) * sizeof(uint64_t));
+    if (component_count)
+        *component_count = count;
+    return result;
+}
+
+int
+fossil_algorithm_graph_components_update(
+    fossil_graph_t *graph,
+    const fossil_graph_edge_t *inserts,
+    size_t insert_count,
+    const fossil_graph_edge_t *deletes,
+    size_t delete_count,
+    uint64_t *component,
+    uint64_t *sizes,
+    size_t *component_count
+) {
+    if (!graph || !component || !sizes || !component_count ||
+        (insert_count && !inserts) || (delete_count && !deletes))
+        return -2;
+    if (graph_packed(graph))
+        return -4;
+
+    size_t n = graph->node_count;
+    for (size_t i = 0; i < insert_count; i++)
+        if (inserts[i].from >= n || inserts[i].to >= n)
+            return -2;
+    for (size_t i = 0; i < delete_count; i++)
+        if (deletes[i].from >= n || deletes[i].to >= n)
+            return -2;
+    if (insert_count + delete_count == 0)
+        return 0;
 
-struct fossil_graph {
-    size_t node_count;
-    bool directed;
-    bool weighted;
-    fossil_graph_edge_node_t **adj;
-};
+    return graph_components_repair(graph, inserts, insert_count, deletes, delete_count,
+                                   component, sizes, component_count);
+}
 
-// ======================================================
-// Internal Utilities
-// ======================================================
+int
+fossil_algorithm_graph_triangles(
+    fossil_graph_t *graph,
+    uint64_t *triangle_count,
+    uint64_t *per_node,
+    double *clustering
+) {
+    if (!graph)
+        return -2;
+    if (graph_packed(graph))
+        return -4;
+    if (graph->node_count == 0) {
+        if (triangle_count)
+            *triangle_count = 0;
+        return 0;
+    }
+    return graph_triangles(graph, triangle_count, per_node, clustering);
+}
 
-static bool algorithm_equals(const char *a, const char *b)
-{
-    return a && b && strcmp(a, b) == 0;
+int
+fossil_algorithm_graph_kcore(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t *core,
+    uint64_t *order,
+    uint64_t *degeneracy
+) {
+    if (!graph || !algorithm_id)
+        return -2;
+    if (!algorithm_equals(algorithm_id, "kcore") &&
+        !algorithm_equals(algorithm_id, "kcore-parallel"))
+        return -3;
+    if (graph_packed(graph))
+        return -4;
+    if (graph->node_count == 0) {
+        if (degeneracy)
+            *degeneracy = 0;
+        return 0;
+    }
+    return graph_kcore(graph, algorithm_equals(algorithm_id, "kcore-parallel"),
+                       core, order, degeneracy);
 }
 
-// ======================================================
-// BFS
-// ======================================================
+int
+fossil_algorithm_graph_max_flow(
+    fossil_graph_t *graph,
+    const char *algorithm_id,
+    uint64_t source,
+    uint64_t sink,
+    double *flow_value,
+    fossil_graph_edge_t *flows,
+    size_t *flow_count,
+    bool *source_side
+) {
+    if (!graph || !algorithm_id)
+        return -2;
+    if (!algorithm_equals(algorithm_id, "dinic") &&
+        !algorithm_equals(algorithm_id, "push-relabel"))
+        return -3;
+    if (graph_packed(graph) || (graph->csr && graph->csr->negative))
+        return -4;
+    if (source >= graph->node_count || sink >= graph->node_count || source == sink)
+        return -2;
 
-static int
-graph_bfs(
+    return graph_max_flow(graph, algorithm_equals(algorithm_id, "dinic"), source, sink,
+                          flow_value, flows, flow_count, source_side);
+}
+
+int
+fossil_algorithm_graph_matching(
     fossil_graph_t *graph,
-    uint64_t start,
-    fossil_graph_visit_fn visit,
-    void *user
+    const bool *left,
+    uint64_t *mate,
+    size_t *matching_size
 ) {
-    if (!graph || start >= graph->node_count)
+    if (!graph)
         return -2;
+    if (graph_packed(graph))
+        return -4;
+    if (graph->node_count == 0) {
+        if (matching_size)
+            *matching_size = 0;
+        return 0;
+    }
+    return graph_matching(graph, left, mate, matching_size);
+}
 
-    if (graph->node_count == 0)
+int
+fossil_algorithm_graph_assignment(
+    const double *cost,
+    size_t rows,
+    size_t cols,
+    uint64_t *assignment,
+    double *total_cost
+) {
+    if (rows == 0 || cols == 0) {
+        for (size_t i = 0; assignment && i < rows; i++)
+            assignment[i] = FOSSIL_GRAPH_NO_NODE;
+        if (total_cost)
+            *total_cost = 0.0;
+        return 0;
+    }
+    if (!cost || cols > SIZE_MAX / sizeof(double) / rows)
         return -2;
+    // Rejects NaN and infinities
+    for (size_t k = 0; k < rows * cols; k++)
+        if (!(cost[k] >= -DBL_MAX && cost[k] <= DBL_MAX))
+            return -2;
 
-    bool *visited = calloc(graph->node_count, sizeof(bool));
-    if (!visited)
-        return -1;
+    return graph_assignment(cost, rows, cols, assignment, total_cost);
+}
 
-    uint64_t *queue = malloc(graph->node_count * sizeof(uint64_t));
-    if (!queue) {
-        free(visited);
-        return -1;
-    }
+// Orders edges by (from, to, weight) so duplicates keep the lightest.
+static int graph_edge_compare(const void *a, const void *b)
+{
+    const fossil_graph_edge_t *x = a, *y = b;
+    if (x->from != y->from)
+        return x->from < y->from ? -1 : 1;
+    if (x->to != y->to)
+        return x->to < y->to ? -1 : 1;
+    return (x->weight > y->weight) - (x->weight < y->weight);
+}
 
-    size_t head = 0, tail = 0;
-    visited[start] = true;
-    queue[tail++] = start;
+// Undirected arcs are stored twice; keep one orientation of each.
+static inline bool
+graph_condensed_arc(
+    const fossil_graph_t *graph,
+    const uint64_t *component,
+    uint64_t u,
+    uint64_t v
+) {
+    if (graph->directed)
+        return component[u] != component[v];
+    return component[u] < component[v];
+}
 
-    while (head < tail) {
-        uint64_t v = queue[head++];
+int
+fossil_algorithm_graph_condensation(
+    fossil_graph_t *graph,
+    const uint64_t *component,
+    size_t component_count,
+    fossil_graph_t **dag
+) {
+    if (!graph || !component || !dag)
+        return -2;
+    *dag = NULL;
+    if (graph_packed(graph))
+        return -4;
 
-        if (visit && !visit(v, user))
-            break;
+    size_t n = graph->node_count;
+    for (size_t v = 0; v < n; v++) {
+        if (component[v] >= component_count)
+            return -2;
+    }
 
-        // Defensive: adj may be NULL in stub/test graphs
-        fossil_graph_edge_node_t **adj_list = (fossil_graph_edge_node_t **)graph->adj;
-        fossil_graph_edge_node_t *edges = NULL;
-        if (adj_list)
-            edges = adj_list[v];
+    // Edges between different components, sorted and deduplicated
+    size_t cross = 0;
+    for (uint64_t u = 0; u < n; u++) {
+        uint64_t begin, end;
+        graph_edge_range(graph, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++)
+            cross += graph_condensed_arc(graph, component, u, graph->csr->out.targets[e]);
+    }
 
-        for (fossil_graph_edge_node_t *e = edges; e; e = e->next) {
-            if (!visited[e->to]) {
-                visited[e->to] = true;
-                queue[tail++] = e->to;
-            }
+    fossil_graph_edge_t *edges = malloc((cross ? cross : 1) * sizeof(fossil_graph_edge_t));
+    if (!edges)
+        return -1;
+
+    size_t m = 0;
+    for (uint64_t u = 0; u < n; u++) {
+        uint64_t begin, end;
+        graph_edge_range(graph, u, &begin, &end);
+        for (uint64_t e = begin; e < end; e++) {
+            uint64_t v = graph->csr->out.targets[e];
+            if (!graph_condensed_arc(graph, component, u, v))
+                continue;
+            edges[m].from = component[u];
+            edges[m].to = component[v];
+            edges[m].weight = graph->csr->out.weights ? graph->csr->out.weights[e] : 0.0;
+            m++;
         }
     }
+    qsort(edges, m, sizeof(fossil_graph_edge_t), graph_edge_compare);
 
-    free(queue);
-    free(visited);
+    size_t unique = 0;
+    for (size_t i = 0; i < m; i++) {
+        if (unique > 0 && edges[unique - 1].from == edges[i].from && edges[unique - 1].to == edges[i].to)
+            continue;
+        edges[unique++] = edges[i];
+    }
+
+    fossil_graph_t *result = fossil_algorithm_graph_create(component_count, graph->directed, graph->weighted);
+    if (!result || fossil_algorithm_graph_build(result, edges, unique) != 0) {
+        fossil_algorithm_graph_destroy(result);
+        free(edges);
+        return -1;
+    }
+
+    free(edges);
+    *dag = result;
     return 0;
 }
 
-// ======================================================
-// DFS
-// ======================================================
-
-static bool
-dfs_visit(
+int
+fossil_algorithm_graph_reorder(
     fossil_graph_t *graph,
-    uint64_t v,
-    bool *visited,
-    fossil_graph_visit_fn visit,
-    void *user
+    const char *algorithm_id,
+    uint64_t *perm
 ) {
-    visited[v] = true;
+    if (!graph || !algorithm_id || !perm)
+        return -2;
+    if (!algorithm_equals(algorithm_id, "rcm") &&
+        !algorithm_equals(algorithm_id, "degree") &&
+        !algorithm_equals(algorithm_id, "bfs") &&
+        !algorithm_equals(algorithm_id, "kcore"))
+        return -3;
+    if (graph_packed(graph))
+        return -4;
+    if (graph->node_count == 0)
+        return 0;
+    return graph_reorder(graph, algorithm_id, perm);
+}
 
-    if (visit && !visit(v, user))
-        return false;
+int
+fossil_algorithm_graph_relabel(
+    fossil_graph_t *graph,
+    const uint64_t *perm,
+    fossil_graph_t **relabeled
+) {
+    if (!graph || !perm || !relabeled)
+        return -2;
+    *relabeled = NULL;
+    if (graph_packed(graph))
+        return -4;
 
-    // Defensive: adj may be NULL in stub/test graphs
-    fossil_graph_edge_node_t **adj_list = (fossil_graph_edge_node_t **)graph->adj;
-    fossil_graph_edge_node_t *edges = NULL;
-    if (adj_list)
-        edges = adj_list[v];
+    // perm must hit every id in [0, node_count) exactly once
+    size_t n = graph->node_count;
+    uint64_t *hit = calloc(graph_bit_words(n) + 1, sizeof(uint64_t));
+    if (!hit)
+        return -1;
+    bool valid = true;
+    for (size_t v = 0; valid && v < n; v++) {
+        valid = perm[v] < n && !graph_bit_test(hit, perm[v]);
+        if (valid)
+            graph_bit_set(hit, perm[v]);
+    }
+    free(hit);
+    if (!valid)
+        return -2;
 
-    for (fossil_graph_edge_node_t *e = edges; e; e = e->next) {
-        if (!visited[e->to]) {
-            if (!dfs_visit(graph, e->to, visited, visit, user))
-                return false;
-        }
+    fossil_graph_t *result = fossil_algorithm_graph_create(n, graph->directed, graph->weighted);
+    if (!result || graph_relabel(graph, perm, result) != 0) {
+        fossil_algorithm_graph_destroy(result);
+        return -1;
     }
-    return true;
+    *relabeled = result;
+    return 0;
 }
 
-static int
-graph_dfs(
+int
+fossil_algorithm_graph_bfs(
     fossil_graph_t *graph,
-    uint64_t start,
-    fossil_graph_visit_fn visit,
-    void *user
+    uint64_t start_node,
+    uint64_t *level,
+    uint64_t *parent
 ) {
-    if (!graph || start >= graph->node_count)
-        return -2;
-
-    if (graph->node_count == 0)
+    if (!graph || graph->node_count == 0 || start_node >= graph->node_count)
         return -2;
 
-    bool *visited = calloc(graph->node_count, sizeof(bool));
-    if (!visited)
+    uint64_t *parent_buf = parent ? parent : malloc(graph->node_count * sizeof(uint64_t));
+    if (!parent_buf)
         return -1;
 
-    dfs_visit(graph, start, visited, visit, user);
-    free(visited);
-    return 0;
+    int result = graph_bfs_direction_optimizing(graph, start_node, level, parent_buf);
+
+    if (!parent)
+        free(parent_buf);
+    return result;
+}
+
+int
+fossil_algorithm_graph_dfs(
+    fossil_graph_t *graph,
+    uint64_t start_node,
+    fossil_graph_visit_fn pre,
+    fossil_graph_visit_fn post,
+    void *user,
+    uint64_t *discovery,
+    uint64_t *finish
+) {
+    if (!graph || graph->node_count == 0)
+        return -2;
+    if (start_node != FOSSIL_GRAPH_NO_NODE && start_node >= graph->node_count)
+        return -2;
+
+    return graph_dfs_run(graph, start_node, pre, post, user, discovery, finish);
 }
 
 // ======================================================
-// Dijkstra
+// Lifecycle
 // ======================================================
 
-static int
-graph_dijkstra(
+fossil_graph_t *
+fossil_algorithm_graph_create(size_t node_count, bool directed, bool weighted)
+{
+    fossil_graph_t *graph = calloc(1, sizeof(*graph));
+    if (!graph)
+        return NULL;
+
+    graph->node_count = node_count;
+    graph->directed = directed;
+    graph->weighted = weighted;
+    graph->csr = NULL;
+    return graph;
+}
+
+void
+fossil_algorithm_graph_destroy(fossil_graph_t *graph)
+{
+    if (!graph) return;
+    csr_free(graph->csr);
+    free(graph);
+}
+
+int
+fossil_algorithm_graph_build(
     fossil_graph_t *graph,
-    uint64_t start,
-    uint64_t target
+    const fossil_graph_edge_t *edges,
+    size_t edge_count
 ) {
-    if (!graph || !graph->weighted)
-        return -4;
-    if (start >= graph->node_count || target >= graph->node_count)
-        return -2;
-    if (graph->node_count == 0)
+    if (!graph || (!edges && edge_count > 0))
         return -2;
 
-    double *dist = malloc(graph->node_count * sizeof(double));
-    bool *used = calloc(graph->node_count, sizeof(bool));
-    if (!dist || !used) {
-        free(dist);
-        free(used);
+    size_t n = graph->node_count;
+    for (size_t i = 0; i < edge_count; i++)
+        if (edges[i].from >= n || edges[i].to >= n)
+            return -2;
+
+    fossil_graph_csr_t *csr = calloc(1, sizeof(*csr));
+    if (!csr)
         return -1;
-    }
 
-    for (size_t i = 0; i < graph->node_count; i++)
-        dist[i] = DBL_MAX;
-    dist[start] = 0.0;
+    // Counting pass: out-degree per source, mirrored for undirected edges
+    csr->out.offsets = calloc(n + 1, sizeof(uint64_t));
+    if (!csr->out.offsets) {
+        csr_free(csr);
+        return -1;
+    }
 
-    for (;;) {
-        uint64_t v = UINT64_MAX;
-        for (size_t i = 0; i < graph->node_count; i++)
-            if (!used[i] && (v == UINT64_MAX || dist[i] < dist[v]))
-                v = i;
+    size_t arcs = 0;
+    for (size_t i = 0; i < edge_count; i++) {
+        csr->out.offsets[edges[i].from + 1]++;
+        arcs++;
+        if (!graph->directed && edges[i].from != edges[i].to) {
+            csr->out.offsets[edges[i].to + 1]++;
+            arcs++;
+        }
+    }
+    for (size_t v = 0; v < n; v++)
+        csr->out.offsets[v + 1] += csr->out.offsets[v];
 
-        if (v == UINT64_MAX || dist[v] == DBL_MAX)
-            break;
+    csr->edge_count = arcs;
+    csr->out.targets = malloc((arcs ? arcs : 1) * sizeof(uint64_t));
+    if (graph->weighted)
+        csr->out.weights = malloc((arcs ? arcs : 1) * sizeof(double));
 
-        used[v] = true;
+    uint64_t *cursor = malloc((n ? n : 1) * sizeof(uint64_t));
+    if (!csr->out.targets || (graph->weighted && !csr->out.weights) || !cursor) {
+        free(cursor);
+        csr_free(csr);
+        return -1;
+    }
+    if (n)
+        memcpy(cursor, csr->out.offsets, n * sizeof(uint64_t));
 
-        // Defensive: adj may be NULL in stub/test graphs
-        fossil_graph_edge_node_t **adj_list = (fossil_graph_edge_node_t **)graph->adj;
-        fossil_graph_edge_node_t *edges = NULL;
-        if (adj_list)
-            edges = adj_list[v];
+    // Scatter pass: stable, so each node keeps its input edge order
+    for (size_t i = 0; i < edge_count; i++) {
+        uint64_t u = edges[i].from, v = edges[i].to;
+        uint64_t slot = cursor[u]++;
+        csr->out.targets[slot] = v;
+        if (csr->out.weights)
+            csr->out.weights[slot] = edges[i].weight;
 
-        for (fossil_graph_edge_node_t *e = edges; e; e = e->next) {
-            double alt = dist[v] + e->weight;
-            if (alt < dist[e->to])
-                dist[e->to] = alt;
+        if (!graph->directed && u != v) {
+            slot = cursor[v]++;
+            csr->out.targets[slot] = u;
+            if (csr->out.weights)
+                csr->out.weights[slot] = edges[i].weight;
         }
     }
+    free(cursor);
 
-    int result = (dist[target] == DBL_MAX) ? -1 : 0;
+    csr->integral = true;
+    for (size_t e = 0; csr->out.weights && e < arcs; e++) {
+        double w = csr->out.weights[e];
+        if (w < 0.0)
+            csr->negative = true;
+        if (!graph_weight_integral(w))
+            csr->integral = false;
+    }
 
-    free(dist);
-    free(used);
-    return result;
+    csr_free(graph->csr);
+    graph->csr = csr;
+    return 0;
 }
 
-// ======================================================
-// Public Exec Interface
-// ======================================================
-
 int
-fossil_algorithm_graph_exec(
+fossil_algorithm_graph_update(
     fossil_graph_t *graph,
-    const char *algorithm_id,
-    uint64_t start_node,
-    uint64_t target_node,
-    fossil_graph_visit_fn visit,
-    void *user
+    const fossil_graph_edge_t *inserts,
+    size_t insert_count,
+    const fossil_graph_edge_t *deletes,
+    size_t delete_count
 ) {
-    if (!graph || !algorithm_id)
+    if (!graph || (insert_count && !inserts) || (delete_count && !deletes))
         return -2;
+    if (graph_packed(graph))
+        return -4;
 
-    // Check for supported algorithms
-    if (!fossil_algorithm_graph_supported(algorithm_id))
-        return -3;
+    size_t n = graph->node_count;
+    for (size_t i = 0; i < insert_count; i++)
+        if (inserts[i].from >= n || inserts[i].to >= n)
+            return -2;
+    for (size_t i = 0; i < delete_count; i++)
+        if (deletes[i].from >= n || deletes[i].to >= n)
+            return -2;
+    if (insert_count + delete_count == 0)
+        return 0;
 
-    // Check for node id validity and empty graph
-    if (graph->node_count == 0)
+    if (!graph->csr) {
+        int result = fossil_algorithm_graph_build(graph, NULL, 0);
+        if (result != 0)
+            return result;
+    }
+    return graph_update(graph, inserts, insert_count, deletes, delete_count);
+}
+
+size_t
+fossil_algorithm_graph_node_count(const fossil_graph_t *graph)
+{
+    return graph ? graph->node_count : 0;
+}
+
+size_t
+fossil_algorithm_graph_edge_count(const fossil_graph_t *graph)
+{
+    return (graph && graph->csr) ? graph->csr->edge_count : 0;
+}
+
+int
+fossil_algorithm_graph_compress(fossil_graph_t *graph)
+{
+    if (!graph)
         return -2;
+    if (graph->weighted)
+        return -4;
+    if (!graph->csr || graph_packed(graph))
+        return 0;
 
-    if (algorithm_equals(algorithm_id, "bfs") || algorithm_equals(algorithm_id, "dfs")) {
-        if (start_node >= graph->node_count)
-            return -2;
-        if (algorithm_equals(algorithm_id, "bfs"))
-            return graph_bfs((struct fossil_graph *)graph, start_node, visit, user);
-        else
-            return graph_dfs((struct fossil_graph *)graph, start_node, visit, user);
-    }
+    return graph_compress(graph);
+}
 
-    if (algorithm_equals(algorithm_id, "dijkstra")) {
-        if (!graph->weighted)
-            return -4;
-        if (start_node >= graph->node_count || target_node >= graph->node_count)
-            return -2;
-        return graph_dijkstra((struct fossil_graph *)graph, start_node, target_node);
-    }
+int
+fossil_algorithm_graph_save(fossil_graph_t *graph, const char *file_path, bool reverse)
+{
+    if (!graph || !file_path)
+        return -2;
+    if (graph_packed(graph))
+        return -4;
 
-    return -3;
+    // Updated graphs are written as plain CSR, which drops their slack
+    if (graph->csr && graph->csr->out.ends && !graph_slack_layout(graph, NULL, NULL, NULL, false))
+        return -1;
+
+    return graph_file_save(graph, file_path, reverse);
+}
+
+int
+fossil_algorithm_graph_load(const char *file_path, fossil_graph_t **graph)
+{
+    if (!file_path || !graph)
+        return -2;
+    *graph = NULL;
+
+    return graph_file_load(file_path, graph);
 }
 
 // ======================================================
 // Utility API
 // ======================================================
 
+void
+fossil_algorithm_graph_set_threads(size_t threads)
+{
+    graph_thread_setting = threads;
+}
+
+size_t
+fossil_algorithm_graph_get_threads(void)
+{
+    return graph_thread_count();
+}
+
+void
+fossil_algorithm_graph_set_delta(double delta)
+{
+    graph_delta_setting = delta;
+}
+
+double
+fossil_algorithm_graph_get_delta(void)
+{
+    return graph_delta_setting;
+}
+
 bool
 fossil_algorithm_graph_supported(const char *algorithm_id)
 {
@@ -278,7 +9600,33 @@ fossil_algorithm_graph_supported(const char *algorithm_id)
 
     return algorithm_equals(algorithm_id, "bfs") ||
            algorithm_equals(algorithm_id, "dfs") ||
-           algorithm_equals(algorithm_id, "dijkstra");
+           algorithm_equals(algorithm_id, "dijkstra") ||
+           algorithm_equals(algorithm_id, "dijkstra-radix") ||
+           algorithm_equals(algorithm_id, "bellman-ford") ||
+           algorithm_equals(algorithm_id, "bellman-ford-parallel") ||
+           algorithm_equals(algorithm_id, "spfa") ||
+           algorithm_equals(algorithm_id, "delta-stepping") ||
+           algorithm_equals(algorithm_id, "floyd-warshall") ||
+           algorithm_equals(algorithm_id, "cc") ||
+           algorithm_equals(algorithm_id, "scc") ||
+           algorithm_equals(algorithm_id, "scc-parallel") ||
+           algorithm_equals(algorithm_id, "toposort") ||
+           algorithm_equals(algorithm_id, "toposort-parallel") ||
+           algorithm_equals(algorithm_id, "mst-kruskal") ||
+           algorithm_equals(algorithm_id, "mst-prim") ||
+           algorithm_equals(algorithm_id, "mst-boruvka") ||
+           algorithm_equals(algorithm_id, "astar") ||
+           algorithm_equals(algorithm_id, "bidirectional-dijkstra") ||
+           algorithm_equals(algorithm_id, "bidirectional-bfs") ||
+           algorithm_equals(algorithm_id, "pagerank") ||
+           algorithm_equals(algorithm_id, "ppr") ||
+           algorithm_equals(algorithm_id, "triangles") ||
+           algorithm_equals(algorithm_id, "kcore") ||
+           algorithm_equals(algorithm_id, "kcore-parallel") ||
+           algorithm_equals(algorithm_id, "dinic") ||
+           algorithm_equals(algorithm_id, "push-relabel") ||
+           algorithm_equals(algorithm_id, "hopcroft-karp") ||
+           algorithm_equals(algorithm_id, "betweenness");
 }
 
 bool
@@ -287,6 +9635,13 @@ fossil_algorithm_graph_requires_weights(const char *algorithm_id)
     if (!algorithm_id) return false;
 
     return algorithm_equals(algorithm_id, "dijkstra") ||
+           algorithm_equals(algorithm_id, "dijkstra-radix") ||
            algorithm_equals(algorithm_id, "bellman-ford") ||
-           algorithm_equals(algorithm_id, "floyd-warshall");
+           algorithm_equals(algorithm_id, "bellman-ford-parallel") ||
+           algorithm_equals(algorithm_id, "spfa") ||
+           algorithm_equals(algorithm_id, "delta-stepping") ||
+           algorithm_equals(algorithm_id, "floyd-warshall") ||
+           algorithm_equals(algorithm_id, "astar") ||
+           algorithm_equals(algorithm_id, "bidirectional-dijkstra") ||
+           graph_mst_select(algorithm_id) != NULL;
 }
@@ -25,6 +25,9 @@
 #include <fossil/pizza/framework.h>
 
 #include "fossil/algorithm/framework.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <float.h>
 
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Utilities
@@ -63,11 +66,26 @@ static bool test_visitor(uint64_t node_id, void *user) {
     return true;
 }
 
+// Visitor that records the visit order
+typedef struct {
+    uint64_t order[16];
+    size_t count;
+} test_trace_t;
+
+static bool test_trace_visitor(uint64_t node_id, void *user) {
+    test_trace_t *trace = (test_trace_t *)user;
+    if (trace->count < 16)
+        trace->order[trace->count] = node_id;
+    trace->count++;
+    return true;
+}
+
 FOSSIL_TEST(c_test_graph_supported_algorithms) {
     ASSUME_ITS_TRUE(fossil_algorithm_graph_supported("bfs"));
     ASSUME_ITS_TRUE(fossil_algorithm_graph_supported("dfs"));
     ASSUME_ITS_TRUE(fossil_algorithm_graph_supported("dijkstra"));
-    ASSUME_ITS_FALSE(fossil_algorithm_graph_supported("mst-kruskal"));
+    ASSUME_ITS_TRUE(fossil_algorithm_graph_supported("mst-kruskal"));
+    ASSUME_ITS_FALSE(fossil_algorithm_graph_supported("hamiltonian-path"));
     ASSUME_ITS_FALSE(fossil_algorithm_graph_supported(NULL));
 }
 
@@ -93,7 +111,7 @@ FOSSIL_TEST(c_test_graph_exec_invalid_inputs) {
 
 FOSSIL_TEST(c_test_graph_exec_unsupported_algorithm) {
     fossil_graph_t dummy = {.node_count = 0, .directed = false, .weighted = false, .adj = NULL};
-    int rc = fossil_algorithm_graph_exec(&dummy, "mst-kruskal", 0, 0, NULL, NULL);
+    int rc = fossil_algorithm_graph_exec(&dummy, "hamiltonian-path", 0, 0, NULL, NULL);
     ASSUME_ITS_EQUAL_I32(rc, -3);
 }
 
@@ -140,6 +158,1485 @@ FOSSIL_TEST(c_test_graph_exec_bfs_and_dfs_with_visitor) {
     ASSUME_ITS_EQUAL_I32(count, 1);
 }
 
+FOSSIL_TEST(c_test_graph_build_csr_traversal) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 1.0}, {0, 2, 1.0}, {1, 3, 1.0}, {2, 3, 1.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(5, true, false);
+    ASSUME_ITS_TRUE(g != NULL);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 4), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_node_count(g), 5);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_edge_count(g), 4);
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "bfs", 0, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 4);
+    ASSUME_ITS_EQUAL_I32(trace.order[1], 1);
+    ASSUME_ITS_EQUAL_I32(trace.order[2], 2);
+    ASSUME_ITS_EQUAL_I32(trace.order[3], 3);
+
+    trace.count = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "dfs", 0, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 4);
+    ASSUME_ITS_EQUAL_I32(trace.order[1], 1);
+    ASSUME_ITS_EQUAL_I32(trace.order[2], 3);
+    ASSUME_ITS_EQUAL_I32(trace.order[3], 2);
+
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_build_undirected_dijkstra) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 4.0}, {1, 2, 1.0}, {0, 2, 7.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(4, false, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 3), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_edge_count(g), 6);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "dijkstra", 2, 0, NULL, NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "dijkstra", 0, 3, NULL, NULL), -1);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_build_invalid_edges) {
+    fossil_graph_edge_t bad[] = {{0, 9, 1.0}};
+    fossil_graph_t *g = fossil_algorithm_graph_create(3, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, bad, 1), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(NULL, bad, 1), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, NULL, 1), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_edge_count(g), 0);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_shortest_path_dist_pred) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 4.0}, {0, 2, 1.0}, {2, 1, 2.0}, {1, 3, 1.0}, {2, 3, 5.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(5, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 5), 0);
+
+    const char *algos[] = {"dijkstra", "dijkstra-radix"};
+    for (size_t a = 0; a < 2; a++) {
+        double dist[5];
+        uint64_t pred[5];
+        int rc = fossil_algorithm_graph_shortest_path(g, algos[a], 0, FOSSIL_GRAPH_NO_NODE, dist, pred);
+        ASSUME_ITS_EQUAL_I32(rc, 0);
+        ASSUME_ITS_TRUE(dist[1] == 3.0);
+        ASSUME_ITS_TRUE(dist[3] == 4.0);
+        ASSUME_ITS_TRUE(pred[3] == 1 && pred[1] == 2 && pred[2] == 0);
+        ASSUME_ITS_TRUE(pred[0] == FOSSIL_GRAPH_NO_NODE);
+        ASSUME_ITS_TRUE(pred[4] == FOSSIL_GRAPH_NO_NODE);
+        rc = fossil_algorithm_graph_shortest_path(g, algos[a], 0, 4, dist, pred);
+        ASSUME_ITS_EQUAL_I32(rc, -1);
+    }
+
+    // The exec interface reports the path 0 -> 2 -> 1 -> 3
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "dijkstra", 0, 3, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 4);
+    ASSUME_ITS_EQUAL_I32(trace.order[1], 2);
+    ASSUME_ITS_EQUAL_I32(trace.order[2], 1);
+    ASSUME_ITS_EQUAL_I32(trace.order[3], 3);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_shortest_path_rejects_bad_weights) {
+    fossil_graph_edge_t edges[] = {{0, 1, 1.5}, {1, 2, -1.0}};
+    fossil_graph_t *g = fossil_algorithm_graph_create(3, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 1), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra-radix", 0, 1, NULL, NULL), -4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 0, 1, NULL, NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 2), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 0, 2, NULL, NULL), -4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "notalgo", 0, 2, NULL, NULL), -3);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_dfs_deep_chain) {
+    const size_t n = 200000;
+    fossil_graph_edge_t *edges = malloc((n - 1) * sizeof(*edges));
+    ASSUME_ITS_TRUE(edges != NULL);
+    for (size_t i = 0; i + 1 < n; i++) {
+        edges[i].from = i;
+        edges[i].to = i + 1;
+        edges[i].weight = 1.0;
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(n, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, n - 1), 0);
+
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "dfs", 0, 0, test_visitor, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, n);
+    fossil_algorithm_graph_destroy(g);
+    free(edges);
+}
+
+FOSSIL_TEST(c_test_graph_dfs_pre_post_times) {
+    fossil_graph_edge_t edges[] = {{0, 1, 1.0}, {1, 2, 1.0}, {0, 3, 1.0}};
+    fossil_graph_t *g = fossil_algorithm_graph_create(5, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 3), 0);
+
+    test_trace_t pre = {{0}, 0};
+    uint64_t disc[5], fin[5];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_dfs(g, 0, test_trace_visitor, NULL, &pre, disc, fin), 0);
+    ASSUME_ITS_EQUAL_I32(pre.count, 4);
+    ASSUME_ITS_EQUAL_I32(disc[0], 0);
+    ASSUME_ITS_EQUAL_I32(disc[1], 1);
+    ASSUME_ITS_EQUAL_I32(disc[2], 2);
+    ASSUME_ITS_EQUAL_I32(fin[2], 3);
+    ASSUME_ITS_EQUAL_I32(fin[1], 4);
+    ASSUME_ITS_EQUAL_I32(disc[3], 5);
+    ASSUME_ITS_EQUAL_I32(fin[0], 7);
+    ASSUME_ITS_TRUE(disc[4] == FOSSIL_GRAPH_NO_NODE);
+
+    // Post-order over the whole forest
+    test_trace_t post = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_dfs(g, FOSSIL_GRAPH_NO_NODE, NULL, test_trace_visitor, &post, NULL, NULL), 0);
+    ASSUME_ITS_EQUAL_I32(post.count, 5);
+    ASSUME_ITS_EQUAL_I32(post.order[0], 2);
+    ASSUME_ITS_EQUAL_I32(post.order[3], 0);
+    ASSUME_ITS_EQUAL_I32(post.order[4], 4);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_bfs_levels_parallel) {
+    // Binary tree of 1023 nodes, directed parent -> child
+    const size_t n = 1023;
+    fossil_graph_edge_t *edges = malloc((n - 1) * sizeof(*edges));
+    ASSUME_ITS_TRUE(edges != NULL);
+    for (size_t i = 1; i < n; i++) {
+        edges[i - 1].from = (i - 1) / 2;
+        edges[i - 1].to = i;
+        edges[i - 1].weight = 1.0;
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(n + 1, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, n - 1), 0);
+
+    uint64_t *level = malloc((n + 1) * sizeof(uint64_t));
+    uint64_t *parent = malloc((n + 1) * sizeof(uint64_t));
+    fossil_algorithm_graph_set_threads(4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_bfs(g, 0, level, parent), 0);
+    fossil_algorithm_graph_set_threads(0);
+
+    ASSUME_ITS_EQUAL_I32(level[0], 0);
+    ASSUME_ITS_EQUAL_I32(level[1022], 9);
+    ASSUME_ITS_EQUAL_I32(parent[1022], 510);
+    ASSUME_ITS_TRUE(parent[0] == FOSSIL_GRAPH_NO_NODE);
+    ASSUME_ITS_TRUE(level[n] == FOSSIL_GRAPH_NO_NODE);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_bfs(g, n + 5, level, parent), -2);
+
+    free(level);
+    free(parent);
+    free(edges);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_bellman_ford_negative_edges) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 4.0}, {0, 2, 5.0}, {2, 1, -3.0}, {1, 3, 2.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(4, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 4), 0);
+    ASSUME_ITS_TRUE(fossil_algorithm_graph_supported("bellman-ford"));
+
+    const char *algos[] = {"bellman-ford", "spfa", "bellman-ford-parallel"};
+    for (size_t a = 0; a < 3; a++) {
+        double dist[4];
+        uint64_t pred[4];
+        int rc = fossil_algorithm_graph_shortest_path(g, algos[a], 0, 3, dist, pred);
+        ASSUME_ITS_EQUAL_I32(rc, 0);
+        ASSUME_ITS_TRUE(dist[1] == 2.0);
+        ASSUME_ITS_TRUE(dist[3] == 4.0);
+        ASSUME_ITS_TRUE(pred[1] == 2);
+    }
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 0, 3, NULL, NULL), -4);
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "bellman-ford", 0, 3, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 4);
+    ASSUME_ITS_EQUAL_I32(trace.order[1], 2);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_negative_cycle_nodes) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 1.0}, {1, 2, 1.0}, {2, 3, -2.0}, {3, 1, -1.0}, {4, 0, 1.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(5, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 5), 0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "bellman-ford", 0, 3, NULL, NULL), -5);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "spfa", 0, 3, NULL, NULL), -5);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "bellman-ford-parallel", 0, 3, NULL, NULL), -5);
+
+    uint64_t cycle[5];
+    size_t length = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_negative_cycle(g, FOSSIL_GRAPH_NO_NODE, cycle, &length), 0);
+    ASSUME_ITS_EQUAL_I32(length, 3);
+    // The cycle is 1 -> 2 -> 3 -> 1, reported from any rotation
+    for (size_t i = 0; i < length; i++) {
+        uint64_t next = cycle[(i + 1) % length];
+        ASSUME_ITS_EQUAL_I32(next, cycle[i] == 3 ? 1 : cycle[i] + 1);
+    }
+
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 2), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_negative_cycle(g, 0, cycle, &length), 0);
+    ASSUME_ITS_EQUAL_I32(length, 0);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_floyd_warshall_blocked) {
+    // 100 nodes spans two tiles: a ring 0 -> 1 -> ... -> 99 -> 0 plus a shortcut
+    enum { N = 100 };
+    fossil_graph_edge_t edges[N + 1];
+    for (uint64_t i = 0; i < N; i++) {
+        edges[i].from = i;
+        edges[i].to = (i + 1) % N;
+        edges[i].weight = 1.0;
+    }
+    edges[N].from = 10;
+    edges[N].to = 80;
+    edges[N].weight = 5.0;
+    fossil_graph_t *g = fossil_algorithm_graph_create(N, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, N + 1), 0);
+
+    double *dist = malloc(N * N * sizeof(double));
+    float *dist32 = malloc(N * N * sizeof(float));
+    uint64_t *next = malloc(N * N * sizeof(uint64_t));
+    double row[N];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_floyd_warshall(g, "f64", dist, NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_floyd_warshall(g, "f32", dist32, next), 0);
+    for (uint64_t s = 0; s < N; s += 7) {
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", s, FOSSIL_GRAPH_NO_NODE, row, NULL), 0);
+        for (uint64_t t = 0; t < N; t++) {
+            ASSUME_ITS_TRUE(dist[s * N + t] == row[t]);
+            ASSUME_ITS_TRUE(dist32[s * N + t] == (float)row[t]);
+        }
+    }
+    ASSUME_ITS_TRUE(dist[5 * N + 85] == 15.0);
+    ASSUME_ITS_EQUAL_I32(next[5 * N + 85], 6);
+    ASSUME_ITS_EQUAL_I32(next[10 * N + 85], 80);
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "floyd-warshall", 9, 82, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 5);
+    ASSUME_ITS_EQUAL_I32(trace.order[1], 10);
+    ASSUME_ITS_EQUAL_I32(trace.order[2], 80);
+
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_floyd_warshall(g, "f16", dist, NULL), -3);
+    edges[N].weight = -200.0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, N + 1), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_floyd_warshall(g, "f64", dist, NULL), -5);
+
+    free(dist);
+    free(dist32);
+    free(next);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_components_cc) {
+    // Components {0, 3, 5} and {1, 2}; node 4 is isolated. Direction is ignored.
+    fossil_graph_edge_t edges[] = {{5, 3, 0.0}, {3, 0, 0.0}, {2, 1, 0.0}, {1, 2, 0.0}};
+    fossil_graph_t *g = fossil_algorithm_graph_create(6, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 4), 0);
+    ASSUME_ITS_TRUE(fossil_algorithm_graph_supported("cc"));
+
+    uint64_t component[6];
+    uint64_t sizes[6];
+    size_t count = 0;
+    fossil_algorithm_graph_set_threads(4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(g, "cc", component, sizes, &count), 0);
+    fossil_algorithm_graph_set_threads(0);
+    ASSUME_ITS_EQUAL_I32(count, 3);
+    ASSUME_ITS_EQUAL_I32(component[0], 0);
+    ASSUME_ITS_EQUAL_I32(component[3], 0);
+    ASSUME_ITS_EQUAL_I32(component[5], 0);
+    ASSUME_ITS_EQUAL_I32(component[1], 1);
+    ASSUME_ITS_EQUAL_I32(component[2], 1);
+    ASSUME_ITS_EQUAL_I32(component[4], 2);
+    ASSUME_ITS_EQUAL_I32(sizes[0], 3);
+    ASSUME_ITS_EQUAL_I32(sizes[1], 2);
+    ASSUME_ITS_EQUAL_I32(sizes[2], 1);
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "cc", 5, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 3);
+    ASSUME_ITS_EQUAL_I32(trace.order[0], 0);
+    ASSUME_ITS_EQUAL_I32(trace.order[1], 3);
+    ASSUME_ITS_EQUAL_I32(trace.order[2], 5);
+
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(g, "wcc", component, NULL, NULL), -3);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_components_large_undirected) {
+    // 64 disjoint paths of 1000 nodes exercise the sampled-component skip
+    enum { PATHS = 64, LENGTH = 1000, N = PATHS * LENGTH };
+    fossil_graph_edge_t *edges = malloc((N - PATHS) * sizeof(fossil_graph_edge_t));
+    size_t m = 0;
+    for (uint64_t p = 0; p < PATHS; p++) {
+        for (uint64_t i = 1; i < LENGTH; i++) {
+            edges[m].from = p * LENGTH + i;
+            edges[m].to = p * LENGTH + i - 1;
+            edges[m].weight = 0.0;
+            m++;
+        }
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(N, false, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, m), 0);
+
+    uint64_t *component = malloc(N * sizeof(uint64_t));
+    uint64_t *sizes = malloc(N * sizeof(uint64_t));
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(g, "cc", component, sizes, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, PATHS);
+    bool labels_ok = true;
+    for (uint64_t v = 0; v < N; v++)
+        labels_ok = labels_ok && component[v] == v / LENGTH;
+    ASSUME_ITS_TRUE(labels_ok);
+    ASSUME_ITS_EQUAL_I32(sizes[PATHS - 1], LENGTH);
+
+    free(edges);
+    free(component);
+    free(sizes);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_scc_condensation) {
+    // SCCs {0, 1, 2} and {3, 4}; node 5 hangs off the second one
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 1.0}, {1, 2, 1.0}, {2, 0, 1.0}, {2, 3, 4.0},
+        {1, 4, 2.0}, {3, 4, 1.0}, {4, 3, 1.0}, {4, 5, 1.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(6, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 8), 0);
+
+    const char *ids[] = {"scc", "scc-parallel"};
+    for (size_t i = 0; i < 2; i++) {
+        uint64_t component[6];
+        uint64_t sizes[6];
+        size_t count = 0;
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(g, ids[i], component, sizes, &count), 0);
+        ASSUME_ITS_EQUAL_I32(count, 3);
+        ASSUME_ITS_EQUAL_I32(component[2], 0);
+        ASSUME_ITS_EQUAL_I32(component[3], 1);
+        ASSUME_ITS_EQUAL_I32(component[4], 1);
+        ASSUME_ITS_EQUAL_I32(component[5], 2);
+        ASSUME_ITS_EQUAL_I32(sizes[0], 3);
+
+        fossil_graph_t *dag = NULL;
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_condensation(g, component, count, &dag), 0);
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_node_count(dag), 3);
+        // 0 -> 1 is merged from two edges and keeps the lighter weight
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_edge_count(dag), 2);
+        double dist[3];
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(dag, "dijkstra", 0, 2, dist, NULL), 0);
+        ASSUME_ITS_TRUE(dist[1] == 2.0);
+        fossil_algorithm_graph_destroy(dag);
+    }
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "scc", 4, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 2);
+    ASSUME_ITS_EQUAL_I32(trace.order[0], 3);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_scc_deep_cycle) {
+    // A 200000-node cycle would overflow a recursive Tarjan
+    enum { N = 200000 };
+    fossil_graph_edge_t *edges = malloc(N * sizeof(fossil_graph_edge_t));
+    for (uint64_t i = 0; i < N; i++) {
+        edges[i].from = i;
+        edges[i].to = (i + 1) % N;
+        edges[i].weight = 0.0;
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(N, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, N), 0);
+
+    uint64_t *component = malloc(N * sizeof(uint64_t));
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(g, "scc", component, NULL, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 1);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(g, "scc-parallel", component, NULL, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 1);
+
+    // Without the closing edge every node is its own SCC
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, N - 1), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(g, "scc", component, NULL, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, N);
+
+    free(edges);
+    free(component);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_toposort_levels) {
+    // Diamond 0 -> {1, 2} -> 3 plus a chain 3 -> 4
+    fossil_graph_edge_t edges[] = {
+        {0, 2, 1.0}, {0, 1, 1.0}, {1, 3, 1.0}, {2, 3, 1.0}, {3, 4, 1.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(5, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 5), 0);
+
+    uint64_t order[5];
+    uint64_t level[5];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_toposort(g, "toposort", order, level, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 5);
+    ASSUME_ITS_EQUAL_I32(order[0], 0);
+    ASSUME_ITS_EQUAL_I32(order[3], 3);
+    ASSUME_ITS_EQUAL_I32(level[4], 3);
+
+    // Waves are emitted in node order: {0}, {1, 2}, {3}, {4}
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_toposort(g, "toposort-parallel", order, level, &count), 0);
+    ASSUME_ITS_EQUAL_I32(order[1], 1);
+    ASSUME_ITS_EQUAL_I32(order[2], 2);
+    ASSUME_ITS_EQUAL_I32(level[1], 1);
+    ASSUME_ITS_EQUAL_I32(level[2], 1);
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "toposort", 0, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 5);
+    ASSUME_ITS_EQUAL_I32(trace.order[4], 4);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_toposort_reports_cycle) {
+    // 1 -> 2 -> 3 -> 1 is a cycle; 4 only hangs off it, 0 is fine
+    fossil_graph_edge_t edges[] = {{0, 1, 1.0}, {1, 2, 1.0}, {2, 3, 1.0}, {3, 1, 1.0}, {3, 4, 1.0}};
+    fossil_graph_t *g = fossil_algorithm_graph_create(5, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 5), 0);
+
+    uint64_t order[5];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_toposort(g, "toposort", order, NULL, &count), -1);
+    ASSUME_ITS_EQUAL_I32(count, 1);
+    ASSUME_ITS_EQUAL_I32(order[0], 0);
+    ASSUME_ITS_EQUAL_I32(order[1], 1);
+    ASSUME_ITS_EQUAL_I32(order[4], 4);
+
+    uint64_t cycle[5];
+    size_t length = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_find_cycle(g, cycle, &length), 0);
+    ASSUME_ITS_EQUAL_I32(length, 3);
+    for (size_t i = 0; i < length; i++) {
+        uint64_t next = cycle[(i + 1) % length];
+        ASSUME_ITS_EQUAL_I32(next, cycle[i] == 3 ? 1 : cycle[i] + 1);
+    }
+
+    double dist[5];
+    uint64_t pred[5];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_dag_path(g, "longest", 0, dist, pred), -4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "toposort-parallel", 0, 0, NULL, NULL), -1);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_dag_critical_path) {
+    // Tasks with durations on the edges; the critical path is 0 -> 2 -> 3 -> 4
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 2.0}, {0, 2, 3.0}, {1, 3, 1.0}, {2, 3, 4.0}, {3, 4, 2.0}, {1, 4, -1.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(5, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 6), 0);
+
+    double dist[5];
+    uint64_t pred[5];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_dag_path(g, "longest", FOSSIL_GRAPH_NO_NODE, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[4] == 9.0);
+    ASSUME_ITS_EQUAL_I32(pred[4], 3);
+    ASSUME_ITS_EQUAL_I32(pred[3], 2);
+    ASSUME_ITS_EQUAL_I32(pred[2], 0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_dag_path(g, "shortest", 0, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[4] == 1.0);
+    ASSUME_ITS_EQUAL_I32(pred[4], 1);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_dag_path(g, "shortest", 2, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[1] == DBL_MAX);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_dag_path(g, "widest", 0, dist, pred), -3);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_mst_algorithms_agree) {
+    // Two components: a weighted square with a diagonal, and the edge 4 - 5
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 4.0}, {1, 2, 1.0}, {2, 3, 3.0}, {3, 0, 2.0},
+        {0, 2, 5.0}, {4, 5, -1.0}, {5, 4, 7.0}, {1, 1, -9.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(6, false, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 8), 0);
+
+    const char *ids[] = {"mst-kruskal", "mst-prim", "mst-boruvka"};
+    for (size_t i = 0; i < 3; i++) {
+        fossil_graph_edge_t tree[5];
+        size_t count = 0;
+        double total = 0.0;
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_mst(g, ids[i], tree, &count, &total), 0);
+        ASSUME_ITS_EQUAL_I32(count, 4);
+        ASSUME_ITS_TRUE(total == 5.0);
+        for (size_t k = 0; k < count; k++)
+            ASSUME_ITS_TRUE(tree[k].from < tree[k].to);
+    }
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "mst-prim", 3, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 4);
+    ASSUME_ITS_EQUAL_I32(trace.order[0], 3);
+    ASSUME_ITS_EQUAL_I32(trace.order[3], 1);
+    fossil_algorithm_graph_destroy(g);
+
+    fossil_graph_t *directed = fossil_algorithm_graph_create(2, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_mst(directed, "mst-kruskal", NULL, NULL, NULL), -4);
+    fossil_algorithm_graph_destroy(directed);
+}
+
+FOSSIL_TEST(c_test_graph_mst_boruvka_grid) {
+    // 300 x 300 grid with unit weights: every spanning tree weighs N - 1
+    enum { SIDE = 300, N = SIDE * SIDE };
+    fossil_graph_edge_t *edges = malloc(2 * N * sizeof(fossil_graph_edge_t));
+    size_t m = 0;
+    for (uint64_t r = 0; r < SIDE; r++) {
+        for (uint64_t c = 0; c < SIDE; c++) {
+            uint64_t v = r * SIDE + c;
+            if (c + 1 < SIDE) {
+                edges[m].from = v;
+                edges[m].to = v + 1;
+                edges[m].weight = 1.0;
+                m++;
+            }
+            if (r + 1 < SIDE) {
+                edges[m].from = v;
+                edges[m].to = v + SIDE;
+                edges[m].weight = 1.0;
+                m++;
+            }
+        }
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(N, false, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, m), 0);
+
+    size_t count = 0;
+    double total = 0.0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_mst(g, "mst-boruvka", edges, &count, &total), 0);
+    ASSUME_ITS_EQUAL_I32(count, N - 1);
+    ASSUME_ITS_TRUE(total == (double)(N - 1));
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_mst(g, "mst-kruskal", NULL, &count, &total), 0);
+    ASSUME_ITS_EQUAL_I32(count, N - 1);
+
+    free(edges);
+    fossil_algorithm_graph_destroy(g);
+}
+
+typedef struct test_grid {
+    uint64_t width;
+    size_t calls;
+} test_grid_t;
+
+static double test_grid_manhattan(uint64_t node, uint64_t target, void *user) {
+    test_grid_t *grid = (test_grid_t *)user;
+    grid->calls++;
+    uint64_t nx = node % grid->width, ny = node / grid->width;
+    uint64_t tx = target % grid->width, ty = target / grid->width;
+    return (double)((nx > tx ? nx - tx : tx - nx) + (ny > ty ? ny - ty : ty - ny));
+}
+
+FOSSIL_TEST(c_test_graph_astar_grid_path) {
+    // 8 x 8 unit grid with a wall in column 4 except at row 7
+    enum { W = 8, N = W * W };
+    fossil_graph_edge_t edges[2 * N];
+    size_t m = 0;
+    for (uint64_t v = 0; v < N; v++) {
+        bool wall = v % W == 4 && v / W != 7;
+        if (wall)
+            continue;
+        if (v % W + 1 < W && !((v + 1) % W == 4 && (v + 1) / W != 7)) {
+            edges[m].from = v;
+            edges[m].to = v + 1;
+            edges[m].weight = 1.0;
+            m++;
+        }
+        if (v + W < N && !((v + W) % W == 4 && (v + W) / W != 7)) {
+            edges[m].from = v;
+            edges[m].to = v + W;
+            edges[m].weight = 1.0;
+            m++;
+        }
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(N, false, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, m), 0);
+
+    test_grid_t grid = {W, 0};
+    uint64_t path[N];
+    size_t length = 0;
+    double cost = 0.0;
+    // (0, 0) -> (7, 0) has to go around the wall through row 7
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(g, "astar", 0, 7, test_grid_manhattan, &grid, path, &length, &cost), 0);
+    ASSUME_ITS_TRUE(cost == 21.0);
+    ASSUME_ITS_EQUAL_I32(length, 22);
+    ASSUME_ITS_EQUAL_I32(path[0], 0);
+    ASSUME_ITS_EQUAL_I32(path[length - 1], 7);
+    ASSUME_ITS_TRUE(grid.calls > 0);
+
+    double plain = 0.0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(g, "astar", 0, 7, NULL, NULL, NULL, NULL, &plain), 0);
+    ASSUME_ITS_TRUE(plain == cost);
+
+    // Wall nodes are isolated
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(g, "astar", 0, 4, test_grid_manhattan, &grid, path, &length, &cost), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(g, "a-star", 0, 7, NULL, NULL, path, &length, &cost), -3);
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "astar", 0, 3, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 4);
+    ASSUME_ITS_EQUAL_I32(trace.order[3], 3);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_bidirectional_routes) {
+    // Directed: the cheap route 0 -> 1 -> 2 -> 3 -> 5 beats the direct 0 -> 4 -> 5
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 1.0}, {1, 2, 1.0}, {2, 3, 1.0}, {3, 5, 1.0},
+        {0, 4, 3.0}, {4, 5, 3.0}, {5, 0, 1.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(6, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 7), 0);
+
+    uint64_t path[6];
+    size_t length = 0;
+    double cost = 0.0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(g, "bidirectional-dijkstra", 0, 5, NULL, NULL, path, &length, &cost), 0);
+    ASSUME_ITS_TRUE(cost == 4.0);
+    ASSUME_ITS_EQUAL_I32(length, 5);
+    ASSUME_ITS_EQUAL_I32(path[0], 0);
+    ASSUME_ITS_EQUAL_I32(path[2], 2);
+    ASSUME_ITS_EQUAL_I32(path[4], 5);
+
+    // Fewest hops ignores the weights
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(g, "bidirectional-bfs", 0, 5, NULL, NULL, path, &length, &cost), 0);
+    ASSUME_ITS_TRUE(cost == 2.0);
+    ASSUME_ITS_EQUAL_I32(length, 3);
+    ASSUME_ITS_EQUAL_I32(path[1], 4);
+
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(g, "bidirectional-dijkstra", 3, 3, NULL, NULL, path, &length, &cost), 0);
+    ASSUME_ITS_EQUAL_I32(length, 1);
+    ASSUME_ITS_TRUE(cost == 0.0);
+    fossil_algorithm_graph_destroy(g);
+
+    // Unweighted graphs only support the hop-count variant
+    fossil_graph_edge_t chain[] = {{0, 1, 0.0}, {1, 2, 0.0}};
+    fossil_graph_t *u = fossil_algorithm_graph_create(4, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(u, chain, 2), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(u, "bidirectional-bfs", 0, 2, NULL, NULL, NULL, &length, NULL), 0);
+    ASSUME_ITS_EQUAL_I32(length, 3);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(u, "bidirectional-bfs", 2, 0, NULL, NULL, NULL, NULL, NULL), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(u, "bidirectional-bfs", 0, 3, NULL, NULL, NULL, NULL, NULL), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_route(u, "bidirectional-dijkstra", 0, 2, NULL, NULL, NULL, NULL, NULL), -4);
+    fossil_algorithm_graph_destroy(u);
+}
+
+FOSSIL_TEST(c_test_graph_ch_matches_dijkstra) {
+    // 6 x 6 weighted grid, directed both ways with asymmetric weights
+    enum { W = 6, N = W * W };
+    fossil_graph_edge_t edges[4 * N];
+    size_t m = 0;
+    for (uint64_t v = 0; v < N; v++) {
+        for (int dir = 0; dir < 4; dir++) {
+            uint64_t step = dir < 2 ? 1 : W;
+            if (step == 1 ? v % W + 1 >= W : v + W >= N)
+                continue;
+            edges[m].from = dir % 2 ? v + step : v;
+            edges[m].to = dir % 2 ? v : v + step;
+            edges[m].weight = (double)(1 + (v * (3 + 2 * (uint64_t)dir)) % 5);
+            m++;
+        }
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(N, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, m), 0);
+
+    fossil_graph_ch_t *ch = NULL;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_build(g, &ch), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_save(ch, "test_graph_ch.bin"), 0);
+    fossil_graph_ch_t *loaded = NULL;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_load("test_graph_ch.bin", &loaded), 0);
+
+    double dist[N];
+    uint64_t path[N];
+    size_t length = 0;
+    double cost = 0.0;
+    for (uint64_t s = 0; s < N; s += 5) {
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", s, FOSSIL_GRAPH_NO_NODE, dist, NULL), 0);
+        for (uint64_t t = 0; t < N; t++) {
+            ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_route(ch, s, t, path, &length, &cost), 0);
+            ASSUME_ITS_TRUE(cost == dist[t]);
+            ASSUME_ITS_EQUAL_I32(path[0], s);
+            ASSUME_ITS_EQUAL_I32(path[length - 1], t);
+
+            // Unpacked paths only use grid moves
+            for (size_t i = 0; i + 1 < length; i++) {
+                uint64_t a = path[i], b = path[i + 1];
+                ASSUME_ITS_TRUE(a + 1 == b || b + 1 == a || a + W == b || b + W == a);
+            }
+
+            double mapped = 0.0;
+            ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_route(loaded, s, t, NULL, NULL, &mapped), 0);
+            ASSUME_ITS_TRUE(mapped == cost);
+        }
+    }
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_route(ch, 0, N, path, &length, &cost), -2);
+
+    fossil_algorithm_graph_ch_destroy(loaded);
+    fossil_algorithm_graph_ch_destroy(ch);
+    remove("test_graph_ch.bin");
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_ch_rejects_invalid_input) {
+    fossil_graph_edge_t edges[] = {{0, 1, 1.0}, {1, 2, 1.0}};
+    fossil_graph_t *u = fossil_algorithm_graph_create(4, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(u, edges, 2), 0);
+    fossil_graph_ch_t *ch = NULL;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_build(u, &ch), -4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_build(NULL, &ch), -2);
+    fossil_algorithm_graph_destroy(u);
+
+    fossil_graph_t *g = fossil_algorithm_graph_create(4, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 2), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_build(g, &ch), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_route(ch, 2, 0, NULL, NULL, NULL), -1);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_route(ch, 0, 3, NULL, NULL, NULL), -1);
+    fossil_algorithm_graph_ch_destroy(ch);
+    fossil_algorithm_graph_destroy(g);
+
+    FILE *file = fopen("test_graph_ch_bad.bin", "wb");
+    ASSUME_ITS_TRUE(file != NULL);
+    fputs("not a hierarchy file", file);
+    fclose(file);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_ch_load("test_graph_ch_bad.bin", &ch), -2);
+    remove("test_graph_ch_bad.bin");
+}
+
+FOSSIL_TEST(c_test_graph_delta_stepping_matches_dijkstra) {
+    // Ring of 200 nodes with chords; weights 0..9 include zero-weight arcs
+    enum { N = 200 };
+    fossil_graph_edge_t edges[3 * N];
+    size_t m = 0;
+    for (uint64_t v = 0; v < N; v++) {
+        edges[m].from = v;
+        edges[m].to = (v + 1) % N;
+        edges[m].weight = (double)((v * 7) % 10);
+        m++;
+        edges[m].from = v;
+        edges[m].to = (v * 13 + 5) % N;
+        edges[m].weight = (double)((v * 3) % 10);
+        m++;
+        if (v % 9 == 0) {
+            edges[m].from = (v + 1) % N;
+            edges[m].to = v;
+            edges[m].weight = 0.0;
+            m++;
+        }
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(N + 1, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, m), 0);
+
+    double expect[N + 1], dist[N + 1];
+    uint64_t pred[N + 1];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 3, FOSSIL_GRAPH_NO_NODE, expect, NULL), 0);
+
+    const double deltas[] = {0.0, 1.0, 4.0, 50.0};
+    fossil_algorithm_graph_set_threads(4);
+    for (size_t k = 0; k < sizeof(deltas) / sizeof(deltas[0]); k++) {
+        fossil_algorithm_graph_set_delta(deltas[k]);
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "delta-stepping", 3, FOSSIL_GRAPH_NO_NODE, dist, pred), 0);
+        for (uint64_t v = 0; v <= N; v++)
+            ASSUME_ITS_TRUE(dist[v] == expect[v]);
+
+        // Every pred chain is a shortest path back to the start
+        for (uint64_t v = 0; v < N; v++) {
+            uint64_t x = v;
+            size_t steps = 0;
+            while (x != 3 && x != FOSSIL_GRAPH_NO_NODE && steps++ <= N)
+                x = pred[x];
+            ASSUME_ITS_EQUAL_I32(x, 3);
+        }
+        ASSUME_ITS_TRUE(pred[3] == FOSSIL_GRAPH_NO_NODE);
+        ASSUME_ITS_TRUE(pred[N] == FOSSIL_GRAPH_NO_NODE);
+    }
+    fossil_algorithm_graph_set_delta(0.0);
+    fossil_algorithm_graph_set_threads(0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "delta-stepping", 3, 150, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[150] == expect[150]);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "delta-stepping", 3, N, dist, pred), -1);
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "delta-stepping", 3, 4, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.order[0], 3);
+    fossil_algorithm_graph_destroy(g);
+}
+
+typedef struct test_residuals {
+    double last;
+    size_t calls;
+} test_residuals_t;
+
+static bool test_residual_metric(size_t step, double value, void *user) {
+    test_residuals_t *residuals = (test_residuals_t *)user;
+    residuals->last = value;
+    residuals->calls++;
+    return step < 5;
+}
+
+FOSSIL_TEST(c_test_graph_pagerank_star) {
+    // Leaves 1..5 point at hub 0, hub points back at leaf 1; node 6 dangles
+    fossil_graph_edge_t edges[6];
+    for (uint64_t v = 1; v <= 5; v++) {
+        edges[v - 1].from = v;
+        edges[v - 1].to = 0;
+        edges[v - 1].weight = 1.0;
+    }
+    edges[5].from = 0;
+    edges[5].to = 1;
+    edges[5].weight = 1.0;
+    fossil_graph_t *g = fossil_algorithm_graph_create(7, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 6), 0);
+
+    double rank[7];
+    float rank32[7];
+    size_t iterations = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "pagerank", "f64", NULL, 0, 0.85, 1e-12, 500, rank, &iterations, NULL, NULL), 0);
+    ASSUME_ITS_TRUE(iterations > 1 && iterations < 500);
+    double sum = 0.0;
+    for (uint64_t v = 0; v < 7; v++) {
+        sum += rank[v];
+        if (v > 0)
+            ASSUME_ITS_TRUE(rank[0] > rank[v]);
+    }
+    ASSUME_ITS_TRUE(sum > 1.0 - 1e-9 && sum < 1.0 + 1e-9);
+    ASSUME_ITS_TRUE(rank[1] > rank[2]);
+    ASSUME_ITS_TRUE(rank[2] == rank[5]);
+
+    fossil_algorithm_graph_set_threads(4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "pagerank", "f32", NULL, 0, 0.85, 1e-6, 500, rank32, NULL, NULL, NULL), 0);
+    fossil_algorithm_graph_set_threads(0);
+    for (uint64_t v = 0; v < 7; v++)
+        ASSUME_ITS_TRUE(rank32[v] > rank[v] - 1e-4 && rank32[v] < rank[v] + 1e-4);
+
+    // Personalized on the dangling node: its mass never leaves
+    uint64_t seeds[2] = {6, 6};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "ppr", "f64", seeds, 2, 0.85, 1e-12, 500, rank, NULL, NULL, NULL), 0);
+    ASSUME_ITS_TRUE(rank[6] > 1.0 - 1e-9);
+    ASSUME_ITS_TRUE(rank[0] == 0.0);
+
+    // Exec reports nodes by descending rank
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "pagerank", 0, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 7);
+    ASSUME_ITS_EQUAL_I32(trace.order[0], 0);
+    ASSUME_ITS_EQUAL_I32(trace.order[1], 1);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_pagerank_metric_and_errors) {
+    fossil_graph_edge_t edges[3];
+    for (uint64_t v = 0; v < 3; v++) {
+        edges[v].from = v;
+        edges[v].to = (v + 1) % 3;
+        edges[v].weight = 1.0;
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(4, false, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 3), 0);
+
+    double rank[4];
+    size_t iterations = 0;
+    test_residuals_t residuals = {0.0, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "ppr", "f64", &edges[1].from, 1, 0.5, 0.0, 100, rank, &iterations, test_residual_metric, &residuals), 0);
+    ASSUME_ITS_EQUAL_I32(iterations, 5);
+    ASSUME_ITS_EQUAL_I32(residuals.calls, 5);
+    ASSUME_ITS_TRUE(residuals.last > 0.0);
+
+    // Too few iterations to converge leaves the last iterate
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "ppr", "f64", &edges[1].from, 1, 0.5, 1e-12, 2, rank, NULL, NULL, NULL), -1);
+
+    uint64_t bad = 4;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(NULL, "pagerank", "f64", NULL, 0, 0.85, 1e-6, 10, rank, NULL, NULL, NULL), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "pagerank", "f64", NULL, 0, 1.0, 1e-6, 10, rank, NULL, NULL, NULL), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "pagerank", "f64", NULL, 0, 0.85, 1e-6, 0, rank, NULL, NULL, NULL), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "ppr", "f64", NULL, 0, 0.85, 1e-6, 10, rank, NULL, NULL, NULL), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "ppr", "f64", &bad, 1, 0.85, 1e-6, 10, rank, NULL, NULL, NULL), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "pagerank", "i32", NULL, 0, 0.85, 1e-6, 10, rank, NULL, NULL, NULL), -3);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_pagerank(g, "hits", "f64", NULL, 0, 0.85, 1e-6, 10, rank, NULL, NULL, NULL), -3);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "ppr", 4, 0, NULL, NULL), -2);
+    ASSUME_ITS_TRUE(fossil_algorithm_graph_supported("pagerank"));
+    ASSUME_ITS_FALSE(fossil_algorithm_graph_requires_weights("ppr"));
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_reorder_and_relabel) {
+    // Path 0-1-...-9 with scrambled ids: node k of the path is (k * 3) % 10
+    fossil_graph_edge_t edges[9];
+    for (uint64_t k = 0; k < 9; k++) {
+        edges[k].from = (k * 3) % 10;
+        edges[k].to = ((k + 1) * 3) % 10;
+        edges[k].weight = (double)(k + 1);
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(10, false, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 9), 0);
+
+    // RCM lays a path out with bandwidth 1
+    uint64_t perm[10];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_reorder(g, "rcm", perm), 0);
+    for (uint64_t k = 0; k < 9; k++) {
+        uint64_t a = perm[edges[k].from], b = perm[edges[k].to];
+        ASSUME_ITS_TRUE(a + 1 == b || b + 1 == a);
+    }
+
+    fossil_graph_t *h = NULL;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_relabel(g, perm, &h), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_edge_count(h), fossil_algorithm_graph_edge_count(g));
+    double expect[10], dist[10];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 0, FOSSIL_GRAPH_NO_NODE, expect, NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(h, "dijkstra", perm[0], FOSSIL_GRAPH_NO_NODE, dist, NULL), 0);
+    for (uint64_t v = 0; v < 10; v++)
+        ASSUME_ITS_TRUE(dist[perm[v]] == expect[v]);
+    fossil_algorithm_graph_destroy(h);
+
+    // Every order is a permutation
+    const char *ids[] = {"rcm", "degree", "bfs"};
+    for (size_t i = 0; i < 3; i++) {
+        bool hit[10] = {false};
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_reorder(g, ids[i], perm), 0);
+        for (uint64_t v = 0; v < 10; v++) {
+            ASSUME_ITS_TRUE(perm[v] < 10 && !hit[perm[v]]);
+            hit[perm[v]] = true;
+        }
+    }
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_reorder(g, "gorder", perm), -3);
+
+    perm[1] = perm[0];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_relabel(g, perm, &h), -2);
+    ASSUME_ITS_TRUE(h == NULL);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_file_round_trip) {
+    // Directed weighted ring with chords
+    enum { N = 64 };
+    fossil_graph_edge_t edges[2 * N];
+    for (uint64_t v = 0; v < N; v++) {
+        edges[2 * v].from = v;
+        edges[2 * v].to = (v + 1) % N;
+        edges[2 * v].weight = (double)(v % 5 + 1);
+        edges[2 * v + 1].from = v;
+        edges[2 * v + 1].to = (v * 7 + 3) % N;
+        edges[2 * v + 1].weight = (double)(v % 11 + 2);
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(N, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 2 * N), 0);
+
+    const bool reverse[2] = {true, false};
+    for (size_t r = 0; r < 2; r++) {
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_save(g, "test_graph_file.bin", reverse[r]), 0);
+        fossil_graph_t *loaded = NULL;
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_load("test_graph_file.bin", &loaded), 0);
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_node_count(loaded), N);
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_edge_count(loaded), 2 * N);
+
+        double expect[N], dist[N];
+        uint64_t level[N];
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 5, FOSSIL_GRAPH_NO_NODE, expect, NULL), 0);
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(loaded, "dijkstra", 5, FOSSIL_GRAPH_NO_NODE, dist, NULL), 0);
+        for (uint64_t v = 0; v < N; v++)
+            ASSUME_ITS_TRUE(dist[v] == expect[v]);
+
+        // Bottom-up BFS pulls along the mapped or lazily built reverse side
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_bfs(loaded, 0, level, NULL), 0);
+        ASSUME_ITS_EQUAL_I32(level[1], 1);
+        fossil_algorithm_graph_destroy(loaded);
+    }
+
+    FILE *file = fopen("test_graph_file.bin", "wb");
+    ASSUME_ITS_TRUE(file != NULL);
+    fputs("FOSSILGR", file);
+    fclose(file);
+    fossil_graph_t *loaded = NULL;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_load("test_graph_file.bin", &loaded), -2);
+    ASSUME_ITS_TRUE(loaded == NULL);
+    remove("test_graph_file.bin");
+
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_save(NULL, "test_graph_file.bin", true), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_load(NULL, &loaded), -2);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_compressed_traversals) {
+    // Two rings 0..39 and 40..59 with chords, listed in descending order
+    enum { N = 60 };
+    fossil_graph_edge_t edges[2 * N];
+    size_t m = 0;
+    for (uint64_t k = N; k-- > 0;) {
+        uint64_t base = k < 40 ? 0 : 40, size = k < 40 ? 40 : 20;
+        edges[m].from = k;
+        edges[m].to = base + (k - base + 1) % size;
+        edges[m].weight = 0.0;
+        m++;
+        edges[m].from = k;
+        edges[m].to = base + (k - base + 7) % size;
+        edges[m].weight = 0.0;
+        m++;
+    }
+    fossil_graph_t *plain = fossil_algorithm_graph_create(N, false, false);
+    fossil_graph_t *packed = fossil_algorithm_graph_create(N, false, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(plain, edges, m), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(packed, edges, m), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_compress(packed), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_edge_count(packed), fossil_algorithm_graph_edge_count(plain));
+
+    uint64_t expect[N], level[N], parent[N];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_bfs(plain, 3, expect, NULL), 0);
+    fossil_algorithm_graph_set_threads(4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_bfs(packed, 3, level, parent), 0);
+    fossil_algorithm_graph_set_threads(0);
+    for (uint64_t v = 0; v < N; v++) {
+        ASSUME_ITS_TRUE(level[v] == expect[v]);
+        if (v != 3 && level[v] != FOSSIL_GRAPH_NO_NODE)
+            ASSUME_ITS_TRUE(level[parent[v]] + 1 == level[v]);
+    }
+
+    // Sorted lists: DFS from 0 enters the smallest neighbor first
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(packed, "dfs", 0, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 40);
+    ASSUME_ITS_EQUAL_I32(trace.order[1], 1);
+    ASSUME_ITS_EQUAL_I32(trace.order[2], 2);
+
+    uint64_t component[N], sizes[N];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(packed, "cc", component, sizes, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 2);
+    ASSUME_ITS_EQUAL_I32(sizes[0], 40);
+    ASSUME_ITS_EQUAL_I32(component[45], 1);
+
+    // Everything else needs the plain adjacency
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(packed, "scc", component, NULL, NULL), -4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(packed, "bidirectional-bfs", 0, 5, NULL, NULL), -4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_reorder(packed, "rcm", component), -4);
+
+    // Rebuilding restores a plain graph
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(packed, edges, m), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_reorder(packed, "rcm", component), 0);
+
+    fossil_graph_t *weighted = fossil_algorithm_graph_create(2, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_compress(weighted), -4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_compress(NULL), -2);
+    fossil_algorithm_graph_destroy(weighted);
+    fossil_algorithm_graph_destroy(packed);
+    fossil_algorithm_graph_destroy(plain);
+}
+
+FOSSIL_TEST(c_test_graph_batched_updates) {
+    // Directed path 0 -> 1 -> 2 -> 3 with unit weights
+    fossil_graph_edge_t edges[3];
+    for (uint64_t k = 0; k < 3; k++) {
+        edges[k].from = k;
+        edges[k].to = k + 1;
+        edges[k].weight = 1.0;
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(6, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 3), 0);
+
+    // Shortcut 0 -> 3, drop 1 -> 2, and fan node 4 out past its slack
+    fossil_graph_edge_t inserts[12];
+    inserts[0].from = 0;
+    inserts[0].to = 3;
+    inserts[0].weight = 1.5;
+    for (size_t i = 1; i < 12; i++) {
+        inserts[i].from = 4;
+        inserts[i].to = 5;
+        inserts[i].weight = (double)i;
+    }
+    fossil_graph_edge_t deletes[2];
+    deletes[0] = edges[1];
+    deletes[1].from = 2;    // matches nothing
+    deletes[1].to = 0;
+    deletes[1].weight = 1.0;
+    fossil_algorithm_graph_set_threads(4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_update(g, inserts, 12, deletes, 2), 0);
+    fossil_algorithm_graph_set_threads(0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_edge_count(g), 14);
+
+    double dist[6];
+    uint64_t pred[6], level[6];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 0, FOSSIL_GRAPH_NO_NODE, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[3] == 1.5);
+    ASSUME_ITS_TRUE(dist[2] == DBL_MAX);
+    ASSUME_ITS_EQUAL_I32(pred[3], 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_bfs(g, 4, level, NULL), 0);
+    ASSUME_ITS_EQUAL_I32(level[5], 1);
+
+    // No cycles yet: every node is its own SCC
+    uint64_t component[6];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(g, "scc", component, NULL, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 6);
+
+    // A second batch fits in place; deletes match the weight too
+    deletes[0] = inserts[0];
+    deletes[1] = inserts[3];
+    deletes[1].weight = 7.0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_update(g, edges + 1, 1, deletes, 2), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_edge_count(g), 13);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 0, 3, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[3] == 3.0);
+
+    // Negative weights switch Dijkstra off until they are deleted again
+    fossil_graph_edge_t negative = { 3, 2, -1.0 };
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_update(g, &negative, 1, NULL, 0), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 0, 3, dist, pred), -4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_update(g, NULL, 0, &negative, 1), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 0, 3, dist, pred), 0);
+
+    fossil_graph_edge_t bad = { 0, 6, 1.0 };
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_update(g, &bad, 1, NULL, 0), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_update(g, NULL, 1, NULL, 0), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_update(NULL, NULL, 0, NULL, 0), -2);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_parallel_after_update) {
+    // Directed path over 16 nodes, then chords that leave slack gaps
+    fossil_graph_edge_t edges[24];
+    size_t m = 0;
+    for (uint64_t v = 0; v + 1 < 16; v++) {
+        edges[m].from = v;
+        edges[m].to = v + 1;
+        edges[m].weight = 0.0;
+        m++;
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(16, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, m), 0);
+
+    fossil_graph_edge_t inserts[8];
+    for (uint64_t k = 0; k < 8; k++) {
+        inserts[k].from = k;
+        inserts[k].to = k + 2 + (k % 3);
+        inserts[k].weight = 0.0;
+        edges[m++] = inserts[k];
+    }
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_update(g, inserts, 8, NULL, 0), 0);
+    fossil_graph_t *rebuilt = fossil_algorithm_graph_create(16, true, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(rebuilt, edges, m), 0);
+
+    uint64_t order[16], level[16], parallel_level[16];
+    size_t count = 0, parallel_count = 0;
+    fossil_algorithm_graph_set_threads(4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_toposort(g, "toposort", order, level, &count), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_toposort(g, "toposort-parallel", order, parallel_level, &parallel_count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 16);
+    ASSUME_ITS_EQUAL_I32(parallel_count, 16);
+    for (size_t v = 0; v < 16; v++)
+        ASSUME_ITS_EQUAL_I32(parallel_level[v], level[v]);
+
+    uint64_t core[16], parallel_core[16], rebuilt_core[16];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_kcore(g, "kcore", core, NULL, NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_kcore(g, "kcore-parallel", parallel_core, NULL, NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_kcore(rebuilt, "kcore", rebuilt_core, NULL, NULL), 0);
+    for (size_t v = 0; v < 16; v++) {
+        ASSUME_ITS_EQUAL_I32(core[v], rebuilt_core[v]);
+        ASSUME_ITS_EQUAL_I32(parallel_core[v], rebuilt_core[v]);
+    }
+
+    // Still acyclic: every node is its own SCC
+    uint64_t component[16], sizes[16];
+    size_t components = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(g, "scc-parallel", component, sizes, &components), 0);
+    ASSUME_ITS_EQUAL_I32(components, 16);
+
+    uint64_t triangles = 0, rebuilt_triangles = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_triangles(g, &triangles, NULL, NULL), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_triangles(rebuilt, &rebuilt_triangles, NULL, NULL), 0);
+    fossil_algorithm_graph_set_threads(0);
+    ASSUME_ITS_TRUE(triangles > 0);
+    ASSUME_ITS_EQUAL_I32(triangles, rebuilt_triangles);
+
+    fossil_algorithm_graph_destroy(g);
+    fossil_algorithm_graph_destroy(rebuilt);
+}
+
+FOSSIL_TEST(c_test_graph_incremental_components_and_paths) {
+    // Weighted path 0 - 1 - 2 - 3 - 4 plus an isolated node 5
+    fossil_graph_edge_t edges[4];
+    for (uint64_t k = 0; k < 4; k++) {
+        edges[k].from = k;
+        edges[k].to = k + 1;
+        edges[k].weight = 1.0;
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(6, false, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 4), 0);
+
+    uint64_t component[6], sizes[6], pred[6];
+    double dist[6];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components(g, "cc", component, sizes, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 2);
+    ASSUME_ITS_EQUAL_I32(sizes[2], 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path(g, "dijkstra", 0, FOSSIL_GRAPH_NO_NODE, dist, pred), 0);
+
+    // Cut 2 - 3 and attach 5 to 4
+    fossil_graph_edge_t cut = edges[2];
+    fossil_graph_edge_t join = { 5, 4, 2.0 };
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_update(g, &join, 1, &cut, 1), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components_update(g, &join, 1, &cut, 1, component, sizes, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 2);
+    ASSUME_ITS_TRUE(component[0] == component[2]);
+    ASSUME_ITS_TRUE(component[3] == component[5]);
+    ASSUME_ITS_TRUE(component[2] != component[3]);
+    ASSUME_ITS_EQUAL_I32(sizes[component[0]], 3);
+    ASSUME_ITS_EQUAL_I32(sizes[component[5]], 3);
+
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path_update(g, 0, &join, 1, &cut, 1, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[2] == 2.0);
+    ASSUME_ITS_TRUE(dist[4] == DBL_MAX);
+    ASSUME_ITS_TRUE(pred[5] == FOSSIL_GRAPH_NO_NODE);
+
+    // A longer detour 0 - 4 reconnects everything
+    fossil_graph_edge_t detour = { 0, 4, 5.0 };
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_update(g, &detour, 1, NULL, 0), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components_update(g, &detour, 1, NULL, 0, component, sizes, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 1);
+    ASSUME_ITS_EQUAL_I32(sizes[component[3]], 6);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path_update(g, 0, &detour, 1, NULL, 0, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[3] == 6.0);
+    ASSUME_ITS_TRUE(dist[5] == 7.0);
+    ASSUME_ITS_EQUAL_I32(pred[3], 4);
+
+    // Invalid inputs
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_components_update(g, &detour, 1, NULL, 0, component, NULL, &count), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path_update(g, 1, &detour, 1, NULL, 0, dist, pred), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_shortest_path_update(g, 6, NULL, 0, NULL, 0, dist, pred), -2);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_triangles_and_clustering) {
+    // K4 on 0..3, a pendant 3 - 4, and a repeated edge and self-loop
+    fossil_graph_edge_t edges[9];
+    size_t m = 0;
+    for (uint64_t a = 0; a < 4; a++) {
+        for (uint64_t b = a + 1; b < 4; b++) {
+            edges[m].from = a;
+            edges[m].to = b;
+            edges[m].weight = 0.0;
+            m++;
+        }
+    }
+    edges[m].from = 3;
+    edges[m].to = 4;
+    edges[m].weight = 0.0;
+    m++;
+    edges[m] = edges[0];
+    m++;
+    edges[m].from = 4;
+    edges[m].to = 4;
+    edges[m].weight = 0.0;
+    m++;
+
+    fossil_graph_t *g = fossil_algorithm_graph_create(6, false, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, m), 0);
+
+    uint64_t total = 0, per_node[6];
+    double clustering[6];
+    fossil_algorithm_graph_set_threads(4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_triangles(g, &total, per_node, clustering), 0);
+    fossil_algorithm_graph_set_threads(0);
+    ASSUME_ITS_EQUAL_I32(total, 4);
+    ASSUME_ITS_EQUAL_I32(per_node[0], 3);
+    ASSUME_ITS_EQUAL_I32(per_node[3], 3);
+    ASSUME_ITS_EQUAL_I32(per_node[4], 0);
+    ASSUME_ITS_TRUE(clustering[1] == 1.0);
+    ASSUME_ITS_TRUE(clustering[3] == 0.5);
+    ASSUME_ITS_TRUE(clustering[4] == 0.0);
+    ASSUME_ITS_TRUE(clustering[5] == 0.0);
+
+    // Exec visits the four K4 nodes only
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "triangles", 0, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 4);
+    ASSUME_ITS_EQUAL_I32(trace.order[0], 0);
+
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_triangles(NULL, &total, NULL, NULL), -2);
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_kcore_decomposition) {
+    // K4 on 0..3, a tail 3 - 4 - 5 and an isolated node 6
+    fossil_graph_edge_t edges[8];
+    size_t m = 0;
+    for (uint64_t a = 0; a < 4; a++) {
+        for (uint64_t b = a + 1; b < 4; b++) {
+            edges[m].from = a;
+            edges[m].to = b;
+            edges[m].weight = 0.0;
+            m++;
+        }
+    }
+    for (uint64_t a = 3; a < 5; a++) {
+        edges[m].from = a;
+        edges[m].to = a + 1;
+        edges[m].weight = 0.0;
+        m++;
+    }
+
+    fossil_graph_t *g = fossil_algorithm_graph_create(7, false, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, m), 0);
+
+    uint64_t core[7], order[7], degeneracy = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_kcore(g, "kcore", core, order, &degeneracy), 0);
+    ASSUME_ITS_EQUAL_I32(degeneracy, 3);
+    ASSUME_ITS_EQUAL_I32(core[0], 3);
+    ASSUME_ITS_EQUAL_I32(core[3], 3);
+    ASSUME_ITS_EQUAL_I32(core[4], 1);
+    ASSUME_ITS_EQUAL_I32(core[5], 1);
+    ASSUME_ITS_EQUAL_I32(core[6], 0);
+    ASSUME_ITS_EQUAL_I32(order[0], 6);
+    ASSUME_ITS_TRUE(order[3] < 4 && order[6] < 4);
+
+    // The parallel peeling agrees on the core numbers
+    uint64_t parallel_core[7];
+    fossil_algorithm_graph_set_threads(4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_kcore(g, "kcore-parallel", parallel_core, NULL, NULL), 0);
+    fossil_algorithm_graph_set_threads(0);
+    for (size_t v = 0; v < 7; v++)
+        ASSUME_ITS_EQUAL_I32(parallel_core[v], core[v]);
+
+    // The degeneracy order doubles as a relabeling
+    uint64_t perm[7];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_reorder(g, "kcore", perm), 0);
+    for (size_t i = 0; i < 7; i++)
+        ASSUME_ITS_EQUAL_I32(perm[order[i]], i);
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "kcore", 0, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 7);
+    ASSUME_ITS_EQUAL_I32(trace.order[0], 6);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_kcore(g, "kcore-lazy", core, NULL, NULL), -3);
+
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_max_flow_and_min_cut) {
+    // Classic six-node network: maximum flow 23 from 0 to 5
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 16.0}, {0, 2, 13.0}, {1, 2, 10.0}, {2, 1, 4.0}, {1, 3, 12.0},
+        {3, 2, 9.0}, {2, 4, 14.0}, {4, 3, 7.0}, {3, 5, 20.0}, {4, 5, 4.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(6, true, true);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 10), 0);
+
+    const char *ids[] = {"dinic", "push-relabel"};
+    for (size_t i = 0; i < 2; i++) {
+        fossil_graph_edge_t flows[10];
+        size_t flow_count = 0;
+        double value = 0.0, into_sink = 0.0;
+        bool side[6];
+        ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_max_flow(g, ids[i], 0, 5, &value, flows, &flow_count, side), 0);
+        ASSUME_ITS_TRUE(value == 23.0);
+        ASSUME_ITS_TRUE(flow_count <= 10);
+        for (size_t f = 0; f < flow_count; f++)
+            if (flows[f].to == 5)
+                into_sink += flows[f].weight;
+        ASSUME_ITS_TRUE(into_sink == 23.0);
+
+        // Cut edges 1 -> 3, 4 -> 3 and 4 -> 5
+        ASSUME_ITS_TRUE(side[0] && side[1] && side[2] && side[4]);
+        ASSUME_ITS_FALSE(side[3] || side[5]);
+    }
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "push-relabel", 0, 5, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 4);
+    ASSUME_ITS_EQUAL_I32(trace.order[3], 4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_max_flow(g, "dinic", 2, 2, NULL, NULL, NULL, NULL), -2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_max_flow(g, "ford-fulkerson", 0, 5, NULL, NULL, NULL, NULL), -3);
+
+    fossil_algorithm_graph_destroy(g);
+}
+
+FOSSIL_TEST(c_test_graph_matching_and_assignment) {
+    // Left 0..2, right 3..5: nodes 1 and 2 compete for 3
+    fossil_graph_edge_t edges[] = {
+        {0, 3, 0.0}, {0, 4, 0.0}, {1, 3, 0.0}, {2, 3, 0.0}
+    };
+    fossil_graph_t *g = fossil_algorithm_graph_create(6, false, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 4), 0);
+
+    uint64_t mate[6];
+    size_t size = 0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_matching(g, NULL, mate, &size), 0);
+    ASSUME_ITS_EQUAL_I32(size, 2);
+    ASSUME_ITS_EQUAL_I32(mate[0], 4);
+    ASSUME_ITS_EQUAL_I32(mate[4], 0);
+    ASSUME_ITS_TRUE(mate[5] == FOSSIL_GRAPH_NO_NODE);
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "hopcroft-karp", 0, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 4);
+    ASSUME_ITS_EQUAL_I32(trace.order[0], 0);
+    ASSUME_ITS_EQUAL_I32(trace.order[1], 4);
+    fossil_algorithm_graph_destroy(g);
+
+    // Optimal assignment 0 -> 1, 1 -> 0, 2 -> 2 costs 5
+    double cost[] = {
+        4.0, 1.0, 3.0,
+        2.0, 0.0, 5.0,
+        3.0, 2.0, 2.0
+    };
+    uint64_t assignment[3];
+    double total = 0.0;
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_assignment(cost, 3, 3, assignment, &total), 0);
+    ASSUME_ITS_TRUE(total == 5.0);
+    ASSUME_ITS_EQUAL_I32(assignment[0], 1);
+    ASSUME_ITS_EQUAL_I32(assignment[1], 0);
+    ASSUME_ITS_EQUAL_I32(assignment[2], 2);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_assignment(NULL, 3, 3, assignment, &total), -2);
+}
+
+FOSSIL_TEST(c_test_graph_betweenness) {
+    // Undirected path 0 - 1 - 2 - 3 - 4: the middle carries the most pairs
+    fossil_graph_edge_t edges[4];
+    for (uint64_t v = 0; v < 4; v++) {
+        edges[v].from = v;
+        edges[v].to = v + 1;
+        edges[v].weight = 0.0;
+    }
+    fossil_graph_t *g = fossil_algorithm_graph_create(5, false, false);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_build(g, edges, 4), 0);
+
+    double centrality[5];
+    fossil_algorithm_graph_set_threads(4);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_betweenness(g, 0, 0, centrality), 0);
+    fossil_algorithm_graph_set_threads(0);
+    ASSUME_ITS_TRUE(centrality[0] == 0.0);
+    ASSUME_ITS_TRUE(centrality[1] == 3.0);
+    ASSUME_ITS_TRUE(centrality[2] == 4.0);
+    ASSUME_ITS_TRUE(centrality[3] == 3.0);
+
+    test_trace_t trace = {{0}, 0};
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_exec(g, "betweenness", 0, 0, test_trace_visitor, &trace), 0);
+    ASSUME_ITS_EQUAL_I32(trace.count, 5);
+    ASSUME_ITS_EQUAL_I32(trace.order[0], 2);
+    ASSUME_ITS_EQUAL_I32(trace.order[1], 1);
+
+    // Sampling: the same seed draws the same pivots
+    double first[5], second[5];
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_betweenness(g, 2, 7, first), 0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_betweenness(g, 2, 7, second), 0);
+    for (size_t v = 0; v < 5; v++)
+        ASSUME_ITS_TRUE(first[v] == second[v]);
+    ASSUME_ITS_TRUE(first[0] == 0.0 && first[4] == 0.0);
+    ASSUME_ITS_EQUAL_I32(fossil_algorithm_graph_betweenness(g, 0, 0, NULL), -2);
+
+    fossil_algorithm_graph_destroy(g);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -153,6 +1650,44 @@ FOSSIL_TEST_GROUP(c_graph_tests) {
     FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_exec_bfs_and_dfs_empty_graph);
     FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_exec_bfs_and_dfs_null_visitor);
     FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_exec_bfs_and_dfs_with_visitor);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_build_csr_traversal);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_build_undirected_dijkstra);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_build_invalid_edges);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_shortest_path_dist_pred);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_shortest_path_rejects_bad_weights);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_dfs_deep_chain);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_dfs_pre_post_times);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_bfs_levels_parallel);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_bellman_ford_negative_edges);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_negative_cycle_nodes);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_floyd_warshall_blocked);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_components_cc);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_components_large_undirected);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_scc_condensation);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_scc_deep_cycle);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_toposort_levels);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_toposort_reports_cycle);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_dag_critical_path);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_mst_algorithms_agree);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_mst_boruvka_grid);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_astar_grid_path);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_bidirectional_routes);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_ch_matches_dijkstra);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_ch_rejects_invalid_input);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_delta_stepping_matches_dijkstra);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_pagerank_star);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_pagerank_metric_and_errors);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_reorder_and_relabel);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_file_round_trip);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_compressed_traversals);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_batched_updates);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_parallel_after_update);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_incremental_components_and_paths);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_triangles_and_clustering);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_kcore_decomposition);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_max_flow_and_min_cut);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_matching_and_assignment);
+    FOSSIL_TEST_ADD(c_algorithm_graph_fixture, c_test_graph_betweenness);
 
     FOSSIL_TEST_REGISTER(c_algorithm_graph_fixture);
 } // end of tests
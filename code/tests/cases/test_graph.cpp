@@ -26,6 +26,8 @@
 
 #include "fossil/algorithm/framework.h"
 #include <string>
+#include <cfloat>
+#include <cstdio>
 using fossil::algorithm::Graph;
 
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -69,7 +71,8 @@ FOSSIL_TEST(cpp_test_graph_supported_algorithms) {
     ASSUME_ITS_TRUE(Graph::supported("bfs"));
     ASSUME_ITS_TRUE(Graph::supported("dfs"));
     ASSUME_ITS_TRUE(Graph::supported("dijkstra"));
-    ASSUME_ITS_FALSE(Graph::supported("mst-kruskal"));
+    ASSUME_ITS_TRUE(Graph::supported("mst-kruskal"));
+    ASSUME_ITS_FALSE(Graph::supported("hamiltonian-path"));
     ASSUME_ITS_FALSE(Graph::supported(""));
 }
 
@@ -95,7 +98,7 @@ FOSSIL_TEST(cpp_test_graph_exec_invalid_inputs) {
 
 FOSSIL_TEST(cpp_test_graph_exec_unsupported_algorithm) {
     fossil_graph_t dummy = {.node_count = 0, .directed = false, .weighted = false, .adj = nullptr};
-    int rc = Graph::exec(&dummy, "mst-kruskal", 0, 0, nullptr, nullptr);
+    int rc = Graph::exec(&dummy, "hamiltonian-path", 0, 0, nullptr, nullptr);
     ASSUME_ITS_EQUAL_I32(rc, -3);
 }
 
@@ -142,6 +145,462 @@ FOSSIL_TEST(cpp_test_graph_exec_bfs_and_dfs_with_visitor) {
     ASSUME_ITS_EQUAL_I32(count, 1);
 }
 
+FOSSIL_TEST(cpp_test_graph_build_csr_traversal) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 2.0}, {1, 2, 2.0}, {2, 3, 2.0}
+    };
+    fossil_graph_t *g = Graph::create(4, true, true);
+    ASSUME_ITS_TRUE(g != nullptr);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::edge_count(g), 3);
+
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(Graph::exec(g, "bfs", 1, 0, cpp_test_visitor, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 3);
+    ASSUME_ITS_EQUAL_I32(Graph::exec(g, "dijkstra", 0, 3), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::exec(g, "dijkstra", 3, 0), -1);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_shortest_path_dist_pred) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 2.0}, {1, 2, 2.0}, {0, 2, 5.0}
+    };
+    fossil_graph_t *g = Graph::create(3, true, true);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    double dist[3];
+    uint64_t pred[3];
+    ASSUME_ITS_EQUAL_I32(Graph::shortest_path(g, "dijkstra-radix", 0, FOSSIL_GRAPH_NO_NODE, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[2] == 4.0);
+    ASSUME_ITS_TRUE(pred[2] == 1);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_dfs_finish_times) {
+    fossil_graph_edge_t edges[] = {{0, 1, 1.0}, {1, 2, 1.0}};
+    fossil_graph_t *g = Graph::create(3, true, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 2), 0);
+
+    uint64_t disc[3], fin[3];
+    ASSUME_ITS_EQUAL_I32(Graph::dfs(g, 0, nullptr, nullptr, nullptr, disc, fin), 0);
+    ASSUME_ITS_TRUE(disc[0] < disc[2] && fin[2] < fin[0]);
+    ASSUME_ITS_EQUAL_I32(fin[0], 5);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_bfs_levels) {
+    fossil_graph_edge_t edges[] = {{0, 1, 1.0}, {1, 2, 1.0}, {0, 3, 1.0}};
+    fossil_graph_t *g = Graph::create(4, false, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    uint64_t level[4], parent[4];
+    ASSUME_ITS_EQUAL_I32(Graph::bfs(g, 2, level, parent), 0);
+    ASSUME_ITS_EQUAL_I32(level[3], 3);
+    ASSUME_ITS_EQUAL_I32(parent[3], 0);
+    ASSUME_ITS_TRUE(Graph::get_threads() >= 1);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_bellman_ford_negative_cycle) {
+    fossil_graph_edge_t edges[] = {{0, 1, 2.0}, {1, 2, -1.0}, {2, 1, -1.0}};
+    fossil_graph_t *g = Graph::create(3, true, true);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 2), 0);
+    ASSUME_ITS_TRUE(Graph::supported("spfa"));
+    ASSUME_ITS_EQUAL_I32(Graph::exec(g, "spfa", 0, 2), 0);
+
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::exec(g, "bellman-ford", 0, 2), -5);
+    uint64_t cycle[3];
+    size_t length = 0;
+    ASSUME_ITS_EQUAL_I32(Graph::negative_cycle(g, cycle, &length), 0);
+    ASSUME_ITS_EQUAL_I32(length, 2);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_floyd_warshall_matrix) {
+    const double inf = DBL_MAX;
+    double dist[9] = {
+        0.0, 4.0, inf,
+        inf, 0.0, 1.0,
+        1.0, inf, 0.0
+    };
+    uint64_t next[9];
+    ASSUME_ITS_EQUAL_I32(Graph::floyd_warshall_matrix(dist, 3, "f64", next), 0);
+    ASSUME_ITS_TRUE(dist[0 * 3 + 2] == 5.0);
+    ASSUME_ITS_TRUE(dist[2 * 3 + 1] == 5.0);
+    ASSUME_ITS_EQUAL_I32(next[0 * 3 + 2], 1);
+    ASSUME_ITS_EQUAL_I32(next[2 * 3 + 1], 0);
+    ASSUME_ITS_EQUAL_I32(Graph::floyd_warshall_matrix(dist, 3, "i32"), -3);
+}
+
+FOSSIL_TEST(cpp_test_graph_components_cc) {
+    fossil_graph_edge_t edges[] = {{0, 1, 0.0}, {2, 3, 0.0}, {3, 4, 0.0}};
+    fossil_graph_t *g = Graph::create(5, false, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    uint64_t component[5];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(Graph::components(g, "cc", component, nullptr, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 2);
+    ASSUME_ITS_EQUAL_I32(component[1], 0);
+    ASSUME_ITS_EQUAL_I32(component[4], 1);
+
+    size_t visits = 0;
+    ASSUME_ITS_EQUAL_I32(Graph::exec(g, "cc", 3, 0, cpp_test_visitor, &visits), 0);
+    ASSUME_ITS_EQUAL_I32(visits, 3);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_scc_condensation) {
+    fossil_graph_edge_t edges[] = {{0, 1, 0.0}, {1, 0, 0.0}, {1, 2, 0.0}};
+    fossil_graph_t *g = Graph::create(3, true, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    uint64_t component[3];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(Graph::components(g, "scc-parallel", component, nullptr, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 2);
+
+    fossil_graph_t *dag = nullptr;
+    ASSUME_ITS_EQUAL_I32(Graph::condensation(g, component, count, &dag), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::edge_count(dag), 1);
+    Graph::destroy(dag);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_toposort_dag_path) {
+    fossil_graph_edge_t edges[] = {{2, 1, 0.0}, {1, 0, 0.0}, {2, 0, 0.0}};
+    fossil_graph_t *g = Graph::create(3, true, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    uint64_t order[3];
+    ASSUME_ITS_EQUAL_I32(Graph::toposort(g, "toposort-parallel", order), 0);
+    ASSUME_ITS_EQUAL_I32(order[0], 2);
+    ASSUME_ITS_EQUAL_I32(order[2], 0);
+
+    // Unweighted edges count as 1: the longest chain into 0 has two hops
+    double dist[3];
+    uint64_t pred[3];
+    ASSUME_ITS_EQUAL_I32(Graph::dag_path(g, "longest", dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[0] == 2.0);
+
+    uint64_t cycle[3];
+    size_t length = 1;
+    ASSUME_ITS_EQUAL_I32(Graph::find_cycle(g, cycle, &length), 0);
+    ASSUME_ITS_EQUAL_I32(length, 0);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_mst_kruskal) {
+    fossil_graph_edge_t edges[] = {{0, 1, 2.5}, {1, 2, 1.0}, {0, 2, 0.5}};
+    fossil_graph_t *g = Graph::create(3, false, true);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    fossil_graph_edge_t tree[2];
+    size_t count = 0;
+    double total = 0.0;
+    ASSUME_ITS_EQUAL_I32(Graph::mst(g, "mst-kruskal", tree, &count, &total), 0);
+    ASSUME_ITS_EQUAL_I32(count, 2);
+    ASSUME_ITS_TRUE(total == 1.5);
+    // Kruskal emits edges in ascending weight order
+    ASSUME_ITS_TRUE(tree[0].weight == 0.5);
+    Graph::destroy(g);
+}
+
+static double cpp_test_zero_heuristic(uint64_t node, uint64_t target, void *user) {
+    (void)node;
+    (void)target;
+    (void)user;
+    return 0.0;
+}
+
+FOSSIL_TEST(cpp_test_graph_astar_route) {
+    fossil_graph_edge_t edges[] = {{0, 1, 1.0}, {1, 2, 1.0}, {0, 2, 5.0}};
+    fossil_graph_t *g = Graph::create(3, true, true);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    uint64_t path[3];
+    size_t length = 0;
+    double cost = 0.0;
+    ASSUME_ITS_EQUAL_I32(Graph::route(g, "astar", 0, 2, path, &length, &cost, cpp_test_zero_heuristic), 0);
+    ASSUME_ITS_EQUAL_I32(length, 3);
+    ASSUME_ITS_EQUAL_I32(path[1], 1);
+    ASSUME_ITS_TRUE(cost == 2.0);
+    ASSUME_ITS_EQUAL_I32(Graph::route(g, "astar", 2, 0, path, &length), -1);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_bidirectional_route) {
+    fossil_graph_edge_t edges[] = {{0, 1, 1.0}, {1, 2, 1.0}, {0, 2, 5.0}};
+    fossil_graph_t *g = Graph::create(3, false, true);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    uint64_t path[3];
+    size_t length = 0;
+    double cost = 0.0;
+    ASSUME_ITS_EQUAL_I32(Graph::route(g, "bidirectional-dijkstra", 2, 0, path, &length, &cost), 0);
+    ASSUME_ITS_EQUAL_I32(length, 3);
+    ASSUME_ITS_EQUAL_I32(path[1], 1);
+    ASSUME_ITS_TRUE(cost == 2.0);
+    ASSUME_ITS_EQUAL_I32(Graph::route(g, "bidirectional-bfs", 2, 0, path, &length, &cost), 0);
+    ASSUME_ITS_EQUAL_I32(length, 2);
+    ASSUME_ITS_TRUE(cost == 1.0);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_ch_route) {
+    fossil_graph_edge_t edges[] = {{0, 1, 2.0}, {1, 2, 2.0}, {0, 2, 5.0}, {2, 3, 1.0}};
+    fossil_graph_t *g = Graph::create(4, false, true);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 4), 0);
+
+    fossil_graph_ch_t *ch = nullptr;
+    ASSUME_ITS_EQUAL_I32(Graph::ch_build(g, &ch), 0);
+    uint64_t path[4];
+    size_t length = 0;
+    double cost = 0.0;
+    ASSUME_ITS_EQUAL_I32(Graph::ch_route(ch, 3, 0, path, &length, &cost), 0);
+    ASSUME_ITS_TRUE(cost == 5.0);
+    ASSUME_ITS_EQUAL_I32(length, 4);
+    ASSUME_ITS_EQUAL_I32(path[1], 2);
+    ASSUME_ITS_EQUAL_I32(path[2], 1);
+    ASSUME_ITS_EQUAL_I32(Graph::ch_route(ch, 0, 4), -2);
+    Graph::ch_destroy(ch);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_delta_stepping) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 2.0}, {1, 2, 2.0}, {0, 2, 5.0}
+    };
+    fossil_graph_t *g = Graph::create(3, true, true);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    Graph::set_delta(1.0);
+    ASSUME_ITS_TRUE(Graph::get_delta() == 1.0);
+    double dist[3];
+    uint64_t pred[3];
+    ASSUME_ITS_EQUAL_I32(Graph::shortest_path(g, "delta-stepping", 0, FOSSIL_GRAPH_NO_NODE, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[2] == 4.0);
+    ASSUME_ITS_TRUE(pred[2] == 1);
+    Graph::set_delta(0.0);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_pagerank) {
+    fossil_graph_edge_t edges[] = {
+        {1, 0, 1.0}, {2, 0, 1.0}, {0, 1, 1.0}
+    };
+    fossil_graph_t *g = Graph::create(3, true, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    double rank[3];
+    ASSUME_ITS_EQUAL_I32(Graph::pagerank(g, "pagerank", "f64", rank), 0);
+    ASSUME_ITS_TRUE(rank[0] > rank[1] && rank[1] > rank[2]);
+    ASSUME_ITS_TRUE(rank[0] + rank[1] + rank[2] > 1.0 - 1e-9);
+    ASSUME_ITS_TRUE(rank[0] + rank[1] + rank[2] < 1.0 + 1e-9);
+
+    uint64_t seed = 2;
+    ASSUME_ITS_EQUAL_I32(Graph::pagerank(g, "ppr", "f64", rank, &seed, 1), 0);
+    ASSUME_ITS_TRUE(rank[2] > 0.15 - 1e-6 && rank[2] < 0.15 + 1e-6);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_reorder) {
+    fossil_graph_edge_t edges[] = {
+        {0, 2, 1.0}, {2, 1, 1.0}, {1, 3, 1.0}
+    };
+    fossil_graph_t *g = Graph::create(4, true, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    uint64_t perm[4];
+    ASSUME_ITS_EQUAL_I32(Graph::reorder(g, "bfs", perm), 0);
+    fossil_graph_t *h = nullptr;
+    ASSUME_ITS_EQUAL_I32(Graph::relabel(g, perm, &h), 0);
+
+    uint64_t order[4];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(Graph::toposort(h, "toposort", order, nullptr, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 4);
+    ASSUME_ITS_EQUAL_I32(order[0], perm[0]);
+    ASSUME_ITS_EQUAL_I32(order[3], perm[3]);
+    Graph::destroy(h);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_file_load) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 1.5}, {1, 2, 2.5}, {2, 3, 3.0}
+    };
+    fossil_graph_t *g = Graph::create(4, false, true);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::save(g, "test_graph_file_cpp.bin"), 0);
+
+    fossil_graph_t *loaded = nullptr;
+    ASSUME_ITS_EQUAL_I32(Graph::load("test_graph_file_cpp.bin", &loaded), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::edge_count(loaded), 6);
+    double dist[4];
+    ASSUME_ITS_EQUAL_I32(Graph::shortest_path(loaded, "dijkstra", 3, FOSSIL_GRAPH_NO_NODE, dist, nullptr), 0);
+    ASSUME_ITS_TRUE(dist[0] == 7.0);
+    Graph::destroy(loaded);
+    std::remove("test_graph_file_cpp.bin");
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_compress) {
+    fossil_graph_edge_t edges[] = {
+        {0, 3, 0.0}, {0, 1, 0.0}, {1, 2, 0.0}
+    };
+    fossil_graph_t *g = Graph::create(5, true, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::compress(g), 0);
+
+    uint64_t level[5];
+    ASSUME_ITS_EQUAL_I32(Graph::bfs(g, 0, level), 0);
+    ASSUME_ITS_EQUAL_I32(level[2], 2);
+    ASSUME_ITS_TRUE(level[4] == FOSSIL_GRAPH_NO_NODE);
+
+    uint64_t component[5];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(Graph::components(g, "cc", component, nullptr, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 2);
+    ASSUME_ITS_EQUAL_I32(Graph::exec(g, "toposort"), -4);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_update) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 0.0}, {2, 3, 0.0}
+    };
+    fossil_graph_t *g = Graph::create(4, false, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 2), 0);
+
+    fossil_graph_edge_t bridge[] = { {3, 1, 0.0} };
+    ASSUME_ITS_EQUAL_I32(Graph::update(g, bridge, 1, edges, 1), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::edge_count(g), 4);
+
+    uint64_t level[4];
+    ASSUME_ITS_EQUAL_I32(Graph::bfs(g, 2, level), 0);
+    ASSUME_ITS_EQUAL_I32(level[1], 2);
+    ASSUME_ITS_TRUE(level[0] == FOSSIL_GRAPH_NO_NODE);
+
+    uint64_t component[4];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(Graph::components(g, "cc", component, nullptr, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 2);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_incremental_shortest_path) {
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 1.0}, {1, 2, 1.0}, {0, 2, 4.0}
+    };
+    fossil_graph_t *g = Graph::create(3, true, true);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 3), 0);
+
+    double dist[3];
+    uint64_t pred[3];
+    ASSUME_ITS_EQUAL_I32(Graph::shortest_path(g, "dijkstra", 0, FOSSIL_GRAPH_NO_NODE, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[2] == 2.0);
+
+    // Dropping 1 -> 2 falls back to the direct edge
+    ASSUME_ITS_EQUAL_I32(Graph::update(g, nullptr, 0, edges + 1, 1), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::shortest_path_update(g, 0, nullptr, 0, edges + 1, 1, dist, pred), 0);
+    ASSUME_ITS_TRUE(dist[2] == 4.0);
+    ASSUME_ITS_EQUAL_I32(pred[2], 0);
+
+    uint64_t component[3], sizes[3];
+    size_t count = 0;
+    ASSUME_ITS_EQUAL_I32(Graph::components(g, "cc", component, sizes, &count), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::update(g, nullptr, 0, edges, 1), 0);
+    ASSUME_ITS_EQUAL_I32(Graph::components_update(g, nullptr, 0, edges, 1, component, sizes, &count), 0);
+    ASSUME_ITS_EQUAL_I32(count, 2);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_triangles) {
+    // A directed 3-cycle plus one back edge is one undirected triangle
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 0.0}, {1, 2, 0.0}, {2, 0, 0.0}, {1, 0, 0.0}
+    };
+    fossil_graph_t *g = Graph::create(3, true, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 4), 0);
+
+    uint64_t total = 0;
+    double clustering[3];
+    ASSUME_ITS_EQUAL_I32(Graph::triangles(g, &total, nullptr, clustering), 0);
+    ASSUME_ITS_EQUAL_I32(total, 1);
+    ASSUME_ITS_TRUE(clustering[2] == 1.0);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_kcore) {
+    // Directed 3-cycle with a reverse arc: undirected degrees 3, 3, 2
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 0.0}, {1, 2, 0.0}, {2, 0, 0.0}, {1, 0, 0.0}
+    };
+    fossil_graph_t *g = Graph::create(3, true, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 4), 0);
+
+    uint64_t core[3], order[3], degeneracy = 0;
+    ASSUME_ITS_EQUAL_I32(Graph::kcore(g, "kcore-parallel", core, order, &degeneracy), 0);
+    ASSUME_ITS_EQUAL_I32(degeneracy, 2);
+    ASSUME_ITS_EQUAL_I32(core[0], 2);
+    ASSUME_ITS_EQUAL_I32(core[2], 2);
+    ASSUME_ITS_EQUAL_I32(order[0], 2);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_max_flow) {
+    // Unweighted undirected square: two edge-disjoint paths 0 -> 3
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 0.0}, {1, 3, 0.0}, {0, 2, 0.0}, {2, 3, 0.0}
+    };
+    fossil_graph_t *g = Graph::create(4, false, false);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 4), 0);
+
+    double value = 0.0;
+    bool side[4];
+    ASSUME_ITS_EQUAL_I32(Graph::max_flow(g, "dinic", 0, 3, &value, nullptr, nullptr, side), 0);
+    ASSUME_ITS_TRUE(value == 2.0);
+    ASSUME_ITS_TRUE(side[0]);
+    ASSUME_ITS_FALSE(side[1] || side[2] || side[3]);
+    Graph::destroy(g);
+}
+
+FOSSIL_TEST(cpp_test_graph_assignment_rectangular) {
+    // More rows than columns: the cheapest two rows take the columns
+    double cost[] = {
+        3.0, 9.0,
+        1.0, 2.0,
+        8.0, 0.0
+    };
+    uint64_t assignment[3];
+    double total = -1.0;
+    ASSUME_ITS_EQUAL_I32(Graph::assignment(cost, 3, 2, assignment, &total), 0);
+    ASSUME_ITS_TRUE(total == 1.0);
+    ASSUME_ITS_TRUE(assignment[0] == FOSSIL_GRAPH_NO_NODE);
+    ASSUME_ITS_EQUAL_I32(assignment[1], 0);
+    ASSUME_ITS_EQUAL_I32(assignment[2], 1);
+}
+
+FOSSIL_TEST(cpp_test_graph_betweenness_weighted) {
+    // Two equal 0 -> 3 routes split the pair; the long edge is never used
+    fossil_graph_edge_t edges[] = {
+        {0, 1, 1.0}, {0, 2, 1.0}, {1, 3, 1.0}, {2, 3, 1.0}, {0, 3, 5.0}
+    };
+    fossil_graph_t *g = Graph::create(4, true, true);
+    ASSUME_ITS_EQUAL_I32(Graph::build(g, edges, 5), 0);
+
+    double centrality[4];
+    ASSUME_ITS_EQUAL_I32(Graph::betweenness(g, centrality), 0);
+    ASSUME_ITS_TRUE(centrality[0] == 0.0);
+    ASSUME_ITS_TRUE(centrality[1] == 0.5);
+    ASSUME_ITS_TRUE(centrality[2] == 0.5);
+    ASSUME_ITS_TRUE(centrality[3] == 0.0);
+    Graph::destroy(g);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -155,6 +614,31 @@ FOSSIL_TEST_GROUP(cpp_graph_tests) {
     FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_exec_bfs_and_dfs_empty_graph);
     FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_exec_bfs_and_dfs_null_visitor);
     FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_exec_bfs_and_dfs_with_visitor);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_build_csr_traversal);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_shortest_path_dist_pred);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_dfs_finish_times);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_bfs_levels);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_bellman_ford_negative_cycle);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_floyd_warshall_matrix);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_components_cc);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_scc_condensation);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_toposort_dag_path);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_mst_kruskal);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_astar_route);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_bidirectional_route);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_ch_route);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_delta_stepping);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_pagerank);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_reorder);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_file_load);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_compress);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_update);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_incremental_shortest_path);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_triangles);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_kcore);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_max_flow);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_assignment_rectangular);
+    FOSSIL_TEST_ADD(cpp_algorithm_graph_fixture, cpp_test_graph_betweenness_weighted);
 
     FOSSIL_TEST_REGISTER(cpp_algorithm_graph_fixture);
 } // end of tests